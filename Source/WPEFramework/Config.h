@@ -472,8 +472,14 @@ namespace PluginHost {
                 , IdleTime(0)
                 , SoftKillCheckWaitTime(10)
                 , HardKillCheckWaitTime(4)
+                , Reactors(0)
+                , Listeners(1)
                 , IPV6(false)
                 , LegacyInitialize(false)
+                , StartupThreads(1)
+                , ParallelBatch(false)
+                , Compression(false)
+                , TokenCache(64)
                 , DefaultMessagingCategories(false)
                 , Process()
                 , Input()
@@ -510,8 +516,14 @@ namespace PluginHost {
                 Add(_T("idletime"), &IdleTime);
                 Add(_T("softkillcheckwaittime"), &SoftKillCheckWaitTime);
                 Add(_T("hardkillcheckwaittime"), &HardKillCheckWaitTime);
+                Add(_T("reactors"), &Reactors);
+                Add(_T("listeners"), &Listeners);
                 Add(_T("ipv6"), &IPV6);
                 Add(_T("legacyinitialize"), &LegacyInitialize);
+                Add(_T("startupthreads"), &StartupThreads);
+                Add(_T("parallelbatch"), &ParallelBatch);
+                Add(_T("compression"), &Compression);
+                Add(_T("tokencache"), &TokenCache);
                 Add(_T("messaging"), &DefaultMessagingCategories);
                 Add(_T("redirect"), &Redirect);
                 Add(_T("process"), &Process);
@@ -555,8 +567,14 @@ namespace PluginHost {
             Core::JSON::DecUInt16 IdleTime;
             Core::JSON::DecUInt8 SoftKillCheckWaitTime;
             Core::JSON::DecUInt8 HardKillCheckWaitTime;
+            Core::JSON::DecUInt8 Reactors;
+            Core::JSON::DecUInt8 Listeners;
             Core::JSON::Boolean IPV6;
             Core::JSON::Boolean LegacyInitialize;
+            Core::JSON::DecUInt8 StartupThreads;
+            Core::JSON::Boolean ParallelBatch;
+            Core::JSON::Boolean Compression;
+            Core::JSON::DecUInt16 TokenCache;
             Core::JSON::String DefaultMessagingCategories; 
             ProcessSet Process;
             InputConfig Input;
@@ -722,9 +740,15 @@ namespace PluginHost {
             , _portNumber(0)
             , _IPV6()
             , _legacyInitialize(false)
+            , _startupThreads(1)
+            , _parallelBatch(false)
+            , _compression(false)
+            , _tokenCache(0)
             , _idleTime(180)
             , _softKillCheckWaitTime(3)
             , _hardKillCheckWaitTime(10)
+            , _reactors(0)
+            , _listeners(1)
             , _stackSize(0)
             , _inputInfo()
             , _processInfo()
@@ -773,8 +797,14 @@ namespace PluginHost {
                 _idleTime = config.IdleTime.Value();
                 _softKillCheckWaitTime = config.SoftKillCheckWaitTime.Value();
                 _hardKillCheckWaitTime = config.HardKillCheckWaitTime.Value();
+                _reactors = config.Reactors.Value();
+                _listeners = config.Listeners.Value();
                 _IPV6 = config.IPV6.Value();
                 _legacyInitialize = config.LegacyInitialize.Value();
+                _startupThreads = config.StartupThreads.Value();
+                _parallelBatch = config.ParallelBatch.Value();
+                _compression = config.Compression.Value();
+                _tokenCache = config.TokenCache.Value();
                 _binding = config.Binding.Value();
                 _interface = config.Interface.Value();
                 _portNumber = config.Port.Value();
@@ -975,6 +1005,12 @@ POP_WARNING()
         inline uint8_t HardKillCheckWaitTime() const {
             return _hardKillCheckWaitTime;
         }
+        inline uint8_t Reactors() const {
+            return (_reactors);
+        }
+        inline uint8_t Listeners() const {
+            return (_listeners);
+        }
         inline const string& URL() const {
             return (_URL);
         }
@@ -999,6 +1035,23 @@ POP_WARNING()
         inline bool LegacyInitialize() const {
             return (_legacyInitialize);
         }
+        // Number of threads activating plugins at startup. By default (1) they are activated one after
+        // the other, 0 derives the number of threads from the number of cores.
+        inline uint8_t StartupThreads() const {
+            return (_startupThreads);
+        }
+        // Dispatch the calls of a JSON-RPC batch in parallel on the worker pool.
+        inline bool ParallelBatch() const {
+            return (_parallelBatch);
+        }
+        // Accept permessage-deflate when a channel is upgraded to a WebSocket.
+        inline bool Compression() const {
+            return (_compression);
+        }
+        // Number of validated tokens whose officer is remembered, 0 validates every token again.
+        inline uint16_t TokenCache() const {
+            return (_tokenCache);
+        }
 
         const Plugin::Config* Plugin(const string& name) const {
             Core::JSON::ArrayType<Plugin::Config>::ConstIterator index(_plugins.Elements());
@@ -1153,9 +1206,15 @@ POP_WARNING()
         uint16_t _portNumber;
         bool _IPV6;
         bool _legacyInitialize;
+        uint8_t _startupThreads;
+        bool _parallelBatch;
+        bool _compression;
+        uint16_t _tokenCache;
         uint16_t _idleTime;
         uint8_t _softKillCheckWaitTime;
         uint8_t _hardKillCheckWaitTime;
+        uint8_t _reactors;
+        uint8_t _listeners;
         uint32_t _stackSize;
         InputInfo _inputInfo;
         ProcessInfo _processInfo;
@@ -820,6 +820,22 @@ namespace Plugin {
         return (result);
     }
 
+    Core::hresult Controller::Invoke(const uint32_t channelId, const uint32_t id, const string& token, const string& method, const string& parameters, string& response /* @out */, Core::ProxyType<const Core::JSON::IElement>& object) /* override */
+    {
+        Core::hresult result;
+        string callsign(Core::JSONRPC::Message::Callsign(method));
+
+        // Only our own handlers can hand over their result as is, the others get it as text.
+        if (callsign.empty() || (callsign == PluginHost::JSONRPC::Callsign())) {
+            result = PluginHost::JSONRPC::Invoke(channelId, id, token, method, parameters, response, object);
+        }
+        else {
+            result = Invoke(channelId, id, token, method, parameters, response);
+        }
+
+        return (result);
+    }
+
     Core::hresult Controller::Register(Exchange::Controller::ILifeTime::INotification* notification)
     {
         ASSERT(notification != nullptr);
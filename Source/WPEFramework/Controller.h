@@ -371,6 +371,7 @@ namespace Plugin {
         //  ILocalDispatcher methods
         // -------------------------------------------------------------------------------------------------------
         uint32_t Invoke(const uint32_t channelId, const uint32_t id, const string& token, const string& method, const string& parameters, string& response /* @out */) override;
+        uint32_t Invoke(const uint32_t channelId, const uint32_t id, const string& token, const string& method, const string& parameters, string& response /* @out */, Core::ProxyType<const Core::JSON::IElement>& result) override;
 
         inline Core::ProxyType<PluginHost::IShell> FromIdentifier(const string& callsign) const
         {
@@ -381,7 +382,15 @@ namespace Plugin {
             return (service);
         }
         void WorkerPoolMetadata(PluginHost::Metadata::Server& data) const {
+            std::vector<Core::ProxyPoolAdministrator::Metadata> pools;
+
             _pluginServer->WorkerPool().Snapshot(data);
+
+            Core::ProxyPoolAdministrator::Instance().Snapshot(pools);
+
+            for (const Core::ProxyPoolAdministrator::Metadata& pool : pools) {
+                data.Pools.Add() = pool;
+            }
         }
         void Callstack(const ThreadId id, Core::JSON::ArrayType<PluginHost::CallstackData>& response) const;
         void SubSystems();
@@ -42,6 +42,10 @@ set(PRIORITY 0 CACHE STRING "Change the nice level [-20 - 20]")
 set(POLICY "OTHER" CACHE STRING "NA")
 set(OOMADJUST 0 CACHE STRING "Adapt the OOM score [-15 - 15]")
 set(STACKSIZE 0 CACHE STRING "Default stack size per thread")
+set(STARTUP_THREADS 1 CACHE STRING "Threads activating the plugins at startup, 1 activates them one by one, 0 derives it from the number of cores")
+set(PARALLEL_BATCH false CACHE STRING "Dispatch the calls of a JSON-RPC batch in parallel")
+set(WEBSOCKET_COMPRESSION false CACHE STRING "Accept permessage-deflate on the WebSocket connections")
+set(TOKEN_CACHE 64 CACHE STRING "Number of validated security tokens to remember, 0 disables it")
 set(KEY_OUTPUT_DISABLED false CACHE STRING "New outputs on the VirtualInput will be disabled by default")
 set(EXIT_REASONS "Failure;MemoryExceeded;WatchdogExpired" CACHE STRING "Process exit reason list for which the postmortem is required")
 set(ETHERNETCARD_NAME "eth0" CACHE STRING "Ethernet Card name which has to be associated for the Raw Device Id creation")
@@ -76,6 +80,10 @@ if(LEGACY_INITIALZE)
     map_set(${CONFIG} legacyinitialize true)
 endif()
 map_set(${CONFIG} idletime ${IDLE_TIME})
+map_set(${CONFIG} startupthreads ${STARTUP_THREADS})
+map_set(${CONFIG} parallelbatch ${PARALLEL_BATCH})
+map_set(${CONFIG} compression ${WEBSOCKET_COMPRESSION})
+map_set(${CONFIG} tokencache ${TOKEN_CACHE})
 map_set(${CONFIG} softkillcheckwaittime ${SOFT_KILL_CHECK_WAIT_TIME})
 map_set(${CONFIG} hardkillcheckwaittime ${HARD_KILL_CHECK_WAIT_TIME})
 map_set(${CONFIG} persistentpath ${PERSISTENT_PATH}/${NAMESPACE})
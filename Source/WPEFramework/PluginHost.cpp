@@ -627,6 +627,10 @@ POP_WARNING()
                 myself.Policy(_config->Process().Policy());
             }
 
+            // Nothing is monitored yet, so this is the moment to switch to the epoll() based reactors.
+            // The messaging is not up yet, so whether that worked is reported later on.
+            const bool reacting = ((_config->Reactors() == 0) || (Core::ResourceMonitor::Instance().Reactors(_config->Reactors()) == Core::ERROR_NONE));
+
             // Time to start loading the config of the plugins.
             string pluginPath(_config->ConfigsPath());
 
@@ -659,6 +663,10 @@ POP_WARNING()
                 SYSLOG(Logging::Startup, (_T("Messages [EXT]:  %s"), _config->MessagingCategories().c_str()));
             }
 
+            if (reacting == false) {
+                SYSLOG(Logging::Startup, (_T("Could not start %d resource monitor reactors, falling back to a single monitor."), _config->Reactors()));
+            }
+
             // Before we do any translation of IP, make sure we have the right network info...
             if (_config->IPv6() == false) {
                 SYSLOG(Logging::Startup, (_T("Forcing the network to IPv4 only.")));
@@ -165,6 +165,26 @@ namespace PluginHost {
         const string _controllerName;
     };
 
+    // The registered claims of a JSON Web Token payload, that the token cache needs.
+    class TokenClaims : public Core::JSON::Container {
+    public:
+        TokenClaims(TokenClaims&&) = delete;
+        TokenClaims(const TokenClaims&) = delete;
+        TokenClaims& operator=(TokenClaims&&) = delete;
+        TokenClaims& operator=(const TokenClaims&) = delete;
+
+        TokenClaims()
+            : Core::JSON::Container()
+            , Expiration(0)
+        {
+            Add(_T("exp"), &Expiration);
+        }
+        ~TokenClaims() override = default;
+
+    public:
+        Core::JSON::DecUInt64 Expiration;
+    };
+
     string ChannelIdentifier (const Core::SocketPort& input) {
         string result;
         const Core::NodeId& localNode(input.LocalNode());
@@ -238,6 +258,9 @@ namespace PluginHost {
 
     void Server::ServiceMap::Destroy()
     {
+        // The officers belong to the security plugin, let go of them before it is deactivated.
+        _officers.Clear();
+
         _adminLock.Lock();
 
         // First, move them all to deactivated except Controller
@@ -1028,12 +1051,13 @@ namespace PluginHost {
 
         // sort plugins based on StartupOrder from configuration
         std::vector<Core::ProxyType<Service>> configured_services;
+        std::vector<Core::ProxyType<Service>> activate_services;
 
         for (auto service : _services) {
             configured_services.emplace_back(service.second);
         }
 
-        std::sort(configured_services.begin(), configured_services.end(),
+        std::stable_sort(configured_services.begin(), configured_services.end(),
             [](const Core::ProxyType<Service>& lhs, const Core::ProxyType<Service>& rhs)
             {
                 return lhs->StartupOrder() < rhs->StartupOrder();
@@ -1043,9 +1067,7 @@ namespace PluginHost {
         {
             if (service->State() != PluginHost::Service::state::UNAVAILABLE) {
                 if (service->StartMode() == PluginHost::IShell::startmode::ACTIVATED) {
-                    SYSLOG(Logging::Startup, (_T("Activating plugin [%s]:[%s]"),
-                        service->ClassName().c_str(), service->Callsign().c_str()));
-                    service->Activate(PluginHost::IShell::STARTUP);
+                    activate_services.emplace_back(service);
                 }
                 else {
                     SYSLOG(Logging::Startup, (_T("Activation of plugin [%s]:[%s] delayed, start mode is %s"),
@@ -1054,6 +1076,350 @@ namespace PluginHost {
                 }
             }
         }
+
+        uint8_t threads = Configuration().StartupThreads();
+
+        if (threads == 1) {
+            // The default, one after the other in their StartupOrder.
+            for (auto service : activate_services) {
+                SYSLOG(Logging::Startup, (_T("Activating plugin [%s]:[%s]"),
+                    service->ClassName().c_str(), service->Callsign().c_str()));
+                service->Activate(PluginHost::IShell::STARTUP);
+            }
+        }
+        else {
+            if (threads == 0) {
+                // Activation is mostly waiting on libraries and processes, so always allow some overlap.
+                threads = static_cast<uint8_t>(std::min(std::max(std::thread::hardware_concurrency(), 2u), 8u));
+            }
+
+            Launcher launcher(activate_services);
+
+            launcher.Run(threads, Configuration().StackSize());
+        }
+    }
+
+    //
+    // class Server::ServiceMap::Launcher
+    // -----------------------------------------------------------------------------------------------------------------------------------
+    Server::ServiceMap::Launcher::Launcher(const std::vector<Core::ProxyType<Service>>& plugins)
+        : _adminLock()
+        , _ready(0, std::numeric_limits<int32_t>::max())
+        , _nodes()
+        , _queue()
+        , _remaining(static_cast<uint16_t>(plugins.size()))
+        , _running(0)
+        , _threads(0)
+        , _start(0)
+    {
+        uint16_t levelStart = 0;
+        uint16_t previousStart = 0;
+
+        _nodes.reserve(plugins.size());
+
+        for (const Core::ProxyType<Service>& plugin : plugins) {
+            _nodes.push_back({ plugin, {}, 0 });
+        }
+
+        for (uint16_t index = 0; index < _nodes.size(); index++) {
+            const uint32_t order = _nodes[index].Plugin->StartupOrder();
+
+            if (order != _nodes[levelStart].Plugin->StartupOrder()) {
+                previousStart = levelStart;
+                levelStart = index;
+            }
+
+            // Everything with a lower StartupOrder goes first, depending on the previous level is enough.
+            for (uint16_t dependency = previousStart; dependency < levelStart; dependency++) {
+                _nodes[dependency].Dependents.push_back(index);
+                _nodes[index].Dependencies++;
+            }
+        }
+
+        // Within a level, the plugins controlling a subsystem go before the plugins waiting for it.
+        for (uint16_t index = 0; index < _nodes.size(); index++) {
+            const uint32_t precondition = _nodes[index].Plugin->SubSystemPrecondition();
+
+            if (precondition != 0) {
+                for (uint16_t provider = 0; provider < _nodes.size(); provider++) {
+                    if ((provider != index) && (_nodes[provider].Plugin->StartupOrder() == _nodes[index].Plugin->StartupOrder())) {
+                        uint32_t controlled = 0;
+
+                        for (const PluginHost::ISubSystem::subsystem entry : _nodes[provider].Plugin->SubSystemControl()) {
+                            if (entry < PluginHost::ISubSystem::END_LIST) {
+                                controlled |= (1 << entry);
+                            }
+                        }
+
+                        if ((controlled & precondition) != 0) {
+                            _nodes[provider].Dependents.push_back(index);
+                            _nodes[index].Dependencies++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void Server::ServiceMap::Launcher::Run(const uint8_t threads, const uint32_t stackSize)
+    {
+        if (_nodes.empty() == false) {
+            std::list<Activator> activators;
+
+            _threads = static_cast<uint8_t>(std::min(static_cast<size_t>(threads), _nodes.size()));
+            _start = Core::Time::Now().Ticks();
+
+            _adminLock.Lock();
+
+            for (uint16_t index = 0; index < _nodes.size(); index++) {
+                if (_nodes[index].Dependencies == 0) {
+                    _queue.push_back(index);
+                    _ready.Unlock();
+                }
+            }
+
+            if (_queue.empty() == true) {
+                Release();
+            }
+
+            _adminLock.Unlock();
+
+            // The calling thread is one of the launchers as well.
+            for (uint8_t index = 1; index < _threads; index++) {
+                activators.emplace_back(*this, stackSize);
+                activators.back().Run();
+            }
+
+            Process();
+
+            for (Activator& activator : activators) {
+                activator.Wait(Core::Thread::BLOCKED | Core::Thread::STOPPED, Core::infinite);
+            }
+
+            SYSLOG(Logging::Startup, (_T("Startup of %u plugins on %u threads took %u ms"), static_cast<uint32_t>(_nodes.size()), _threads,
+                static_cast<uint32_t>((Core::Time::Now().Ticks() - _start) / Core::Time::TicksPerMillisecond)));
+        }
+    }
+
+    void Server::ServiceMap::Launcher::Process()
+    {
+        uint16_t index;
+
+        while (Next(index) == true) {
+            Service& plugin(*(_nodes[index].Plugin));
+
+            SYSLOG(Logging::Startup, (_T("Activating plugin [%s]:[%s]"), plugin.ClassName().c_str(), plugin.Callsign().c_str()));
+
+            const uint64_t start = Core::Time::Now().Ticks();
+            const Core::hresult result = plugin.Activate(PluginHost::IShell::STARTUP);
+            const uint64_t end = Core::Time::Now().Ticks();
+
+            SYSLOG(Logging::Startup, (_T("Startup timeline of plugin [%s]:[%s]: started at %u ms, took %u ms, result %s"),
+                plugin.ClassName().c_str(), plugin.Callsign().c_str(),
+                static_cast<uint32_t>((start - _start) / Core::Time::TicksPerMillisecond),
+                static_cast<uint32_t>((end - start) / Core::Time::TicksPerMillisecond),
+                Core::ErrorToString(result)));
+
+            Completed(index);
+        }
+    }
+
+    bool Server::ServiceMap::Launcher::Next(uint16_t& index)
+    {
+        bool available = false;
+
+        // Signalled for every queued plugin and, once all are done, for every thread to leave.
+        _ready.Lock(Core::infinite);
+
+        _adminLock.Lock();
+
+        if (_queue.empty() == false) {
+            index = _queue.front();
+            _queue.pop_front();
+            _running++;
+            available = true;
+        }
+
+        _adminLock.Unlock();
+
+        return (available);
+    }
+
+    void Server::ServiceMap::Launcher::Completed(const uint16_t index)
+    {
+        _adminLock.Lock();
+
+        _running--;
+        _remaining--;
+
+        for (const uint16_t dependent : _nodes[index].Dependents) {
+            // A dependent released to break a circular precondition has no dependencies left.
+            if (_nodes[dependent].Dependencies > 0) {
+                _nodes[dependent].Dependencies--;
+
+                if (_nodes[dependent].Dependencies == 0) {
+                    _queue.push_back(dependent);
+                    _ready.Unlock();
+                }
+            }
+        }
+
+        if (_remaining == 0) {
+            _ready.Unlock(_threads);
+        } else if ((_queue.empty() == true) && (_running == 0)) {
+            Release();
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void Server::ServiceMap::Launcher::Release()
+    {
+        // Nothing can run, so the preconditions are circular. Activate the first waiting plugin,
+        // if its preconditions are not met, it is activated the moment they are.
+        uint16_t index = 0;
+
+        while ((index < _nodes.size()) && (_nodes[index].Dependencies == 0)) {
+            index++;
+        }
+
+        ASSERT(index < _nodes.size());
+
+        SYSLOG(Logging::Startup, (_T("Circular preconditions detected, activating plugin [%s]:[%s] first"),
+            _nodes[index].Plugin->ClassName().c_str(), _nodes[index].Plugin->Callsign().c_str()));
+
+        _nodes[index].Dependencies = 0;
+        _queue.push_back(index);
+        _ready.Unlock();
+    }
+
+    //
+    // class Server::ServiceMap::Officers
+    // -----------------------------------------------------------------------------------------------------------------------------------
+    ISecurity* Server::ServiceMap::Officers::Find(const string& token)
+    {
+        ISecurity* result = nullptr;
+
+        if (_size > 0) {
+            const string digest(Digest(token));
+
+            _adminLock.Lock();
+
+            Index::iterator index(_index.find(digest));
+
+            if (index != _index.end()) {
+                Entries::iterator entry(index->second);
+
+                if ((entry->Expiry != 0) && (entry->Expiry <= Core::Time::Now().Ticks())) {
+                    entry->Officer->Release();
+                    _entries.erase(entry);
+                    _index.erase(index);
+                } else {
+                    // Most recently used, goes to the front.
+                    _entries.splice(_entries.begin(), _entries, entry);
+                    result = entry->Officer;
+                    result->AddRef();
+                }
+            }
+
+            _adminLock.Unlock();
+        }
+
+        return (result);
+    }
+
+    void Server::ServiceMap::Officers::Insert(const string& token, ISecurity* officer)
+    {
+        ASSERT(officer != nullptr);
+
+        if (_size > 0) {
+            const uint64_t expiry(Expiry(token));
+
+            // Tokens that are already expired are validated again, the next time they show up.
+            if ((expiry == 0) || (expiry > Core::Time::Now().Ticks())) {
+                const string digest(Digest(token));
+
+                _adminLock.Lock();
+
+                if (_index.find(digest) == _index.end()) {
+                    if (_entries.size() >= _size) {
+                        Entry& last(_entries.back());
+
+                        last.Officer->Release();
+                        _index.erase(last.Digest);
+                        _entries.pop_back();
+                    }
+
+                    officer->AddRef();
+                    _entries.push_front({ digest, expiry, officer });
+                    _index.emplace(digest, _entries.begin());
+                }
+
+                _adminLock.Unlock();
+            }
+        }
+    }
+
+    void Server::ServiceMap::Officers::Revoke(const Core::IUnknown* officer)
+    {
+        _adminLock.Lock();
+
+        Entries::iterator index(_entries.begin());
+
+        while (index != _entries.end()) {
+            if (static_cast<const Core::IUnknown*>(index->Officer) == officer) {
+                index->Officer->Release();
+                _index.erase(index->Digest);
+                index = _entries.erase(index);
+            } else {
+                index++;
+            }
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void Server::ServiceMap::Officers::Clear()
+    {
+        _adminLock.Lock();
+
+        for (Entry& entry : _entries) {
+            entry.Officer->Release();
+        }
+
+        _entries.clear();
+        _index.clear();
+
+        _adminLock.Unlock();
+    }
+
+    /* static */ string Server::ServiceMap::Officers::Digest(const string& token)
+    {
+        Crypto::SHA256 hash(reinterpret_cast<const uint8_t*>(token.c_str()), static_cast<uint16_t>(token.length() * sizeof(TCHAR)));
+
+        return (string(reinterpret_cast<const TCHAR*>(hash.Result()), Crypto::SHA256::Length / sizeof(TCHAR)));
+    }
+
+    /* static */ uint64_t Server::ServiceMap::Officers::Expiry(const string& token)
+    {
+        // A JSON Web Token is <header>.<payload>.<signature>, the claims are in the payload. Tokens
+        // without an expiration stay until they are pushed out or revoked.
+        uint64_t result = 0;
+        const size_t first = token.find('.');
+        const size_t last = token.rfind('.');
+
+        if ((first != string::npos) && (last > first)) {
+            const uint16_t length = static_cast<uint16_t>(last - first - 1);
+            uint8_t* payload = reinterpret_cast<uint8_t*>(ALLOCA(length));
+            const uint16_t size = Core::URL::Base64Decode(&(token[first + 1]), length, payload, length, nullptr);
+            TokenClaims claims;
+
+            if ((size > 0) && (size <= length) && (claims.FromString(string(reinterpret_cast<const TCHAR*>(payload), size)) == true)) {
+                result = claims.Expiration.Value() * Core::Time::MicroSecondsPerSecond;
+            }
+        }
+
+        return (result);
     }
 
     //
@@ -1066,6 +1432,10 @@ namespace PluginHost {
         , _service()
         , _requestClose(false)
     {
+        if (_parent.Configuration().Compression() == true) {
+            PluginHost::Channel::Compression(Web::WebSocket::Deflate::Settings());
+        }
+
         TRACE(Activity, (_T("Construct a link with ID: [%d] to [%s]"), Id(), remoteId.QualifiedName().c_str()));
     }
 
@@ -1093,7 +1463,7 @@ namespace PluginHost {
     PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
     Server::Server(Config& configuration, const bool background)
         : _dispatcher(configuration.StackSize())
-        , _connections(*this, configuration.Binder())
+        , _connections(*this, configuration.Binder(), configuration.Listeners())
         , _config(configuration)
         , _services(*this)
         , _controller()
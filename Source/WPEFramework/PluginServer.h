@@ -97,8 +97,10 @@ namespace PluginHost {
             WorkerPoolImplementation& operator=(WorkerPoolImplementation&&) = delete;
             WorkerPoolImplementation& operator=(const WorkerPoolImplementation&) = delete;
 
+            // Jobs submitted by jobs (e.g. notifications) stay on the worker that submitted them, where
+            // the other workers steal them once idle, instead of all going through the shared queue.
             WorkerPoolImplementation(const uint32_t stackSize)
-                : Core::WorkerPool(THREADPOOL_COUNT, stackSize, 16, &_dispatch, this)
+                : Core::WorkerPool(THREADPOOL_COUNT, stackSize, 16, &_dispatch, this, true)
                 , _dispatch()
             {
                 Run();
@@ -564,6 +566,10 @@ namespace PluginHost {
                 {
                     return ((currentSet & _mask) ^ _events);
                 }
+                inline uint32_t Mask() const
+                {
+                    return (_mask);
+                }
             private:
                 void AddBit(const uint32_t input) {
 
@@ -784,6 +790,9 @@ namespace PluginHost {
             inline const std::vector<PluginHost::ISubSystem::subsystem>& SubSystemControl() const {
                 return (_metadata.Control());
             }
+            inline uint32_t SubSystemPrecondition() const {
+                return (_precondition.Mask());
+            }
             inline const string& VersionHash() const
             {
                 return (_metadata.Hash());
@@ -903,7 +912,7 @@ namespace PluginHost {
                     result = _unavailableHandler;
                 } else if (IsWebServerRequest(request.Path) == true) {
                     result = IFactories::Instance().Response();
-                    FileToServe(request.Path, *result, false);
+                    FileToServe(request.Path, *result, false, (request.Range.IsSet() == true ? request.Range.Value() : Core::emptyString));
                 } else if (request.Verb == Web::Request::HTTP_OPTIONS) {
 
                     result = IFactories::Instance().Response();
@@ -986,7 +995,8 @@ namespace PluginHost {
 
                     Core::InterlockedIncrement(_activity);
                     string output;
-                    uint32_t result = _jsonrpc->Invoke(channelId, message.Id.Value(), token, message.Designator.Value(), message.Parameters.Value(), output);
+                    Core::ProxyType<const Core::JSON::IElement> object;
+                    uint32_t result = _jsonrpc->Invoke(channelId, message.Id.Value(), token, message.Designator.Value(), message.Parameters.Value(), output, object);
 
                     if ( (result != static_cast<uint32_t>(~0)) && ( (message.Id.IsSet()) || (result != Core::ERROR_NONE) ) )  {
 
@@ -997,7 +1007,11 @@ namespace PluginHost {
                         }
 
                         if (result == Core::ERROR_NONE) {
-                            if (output.empty() == true) {
+                            if (object.IsValid() == true) {
+                                // Serialized straight into the frame, no text in between.
+                                response->Result.Object(object);
+                            }
+                            else if (output.empty() == true) {
                                 response->Result.Null(true);;
                             }
                             else {
@@ -2205,6 +2219,8 @@ namespace PluginHost {
 
                         _parent.Unregister(notification);
                         notification->Release();
+                    } else if (interfaceId == PluginHost::ISecurity::ID) {
+                        _parent._officers.Revoke(remote);
                     }
 
                     _adminLock.Lock();
@@ -2535,6 +2551,134 @@ namespace PluginHost {
                 string _observerPath;
             };
 
+            // Activates the plugins that start at boot on a bounded number of threads. A plugin
+            // waits for all plugins with a lower StartupOrder and for the plugins, with the same
+            // StartupOrder, that control a subsystem it has as a precondition. Everything else
+            // is activated concurrently.
+            class Launcher {
+            private:
+                struct Node {
+                    Core::ProxyType<Service> Plugin;
+                    std::vector<uint16_t> Dependents;
+                    uint16_t Dependencies;
+                };
+
+                class Activator : public Core::Thread {
+                public:
+                    Activator() = delete;
+                    Activator(Activator&&) = delete;
+                    Activator(const Activator&) = delete;
+                    Activator& operator=(Activator&&) = delete;
+                    Activator& operator=(const Activator&) = delete;
+
+                    Activator(Launcher& parent, const uint32_t stackSize)
+                        : Core::Thread(stackSize, _T("PluginStartup"))
+                        , _parent(parent)
+                    {
+                    }
+                    ~Activator() override
+                    {
+                        Stop();
+                        Wait(Core::Thread::STOPPED, Core::infinite);
+                    }
+
+                private:
+                    uint32_t Worker() override
+                    {
+                        _parent.Process();
+                        Block();
+                        return (Core::infinite);
+                    }
+
+                private:
+                    Launcher& _parent;
+                };
+
+            public:
+                Launcher() = delete;
+                Launcher(Launcher&&) = delete;
+                Launcher(const Launcher&) = delete;
+                Launcher& operator=(Launcher&&) = delete;
+                Launcher& operator=(const Launcher&) = delete;
+
+                // The plugins must be sorted on their StartupOrder.
+                Launcher(const std::vector<Core::ProxyType<Service>>& plugins);
+                ~Launcher() = default;
+
+            public:
+                // Returns once all plugins have been activated (or failed to).
+                void Run(const uint8_t threads, const uint32_t stackSize);
+
+            private:
+                void Process();
+                bool Next(uint16_t& index);
+                void Completed(const uint16_t index);
+                void Release();
+
+            private:
+                Core::CriticalSection _adminLock;
+                Core::CountingSemaphore _ready;
+                std::vector<Node> _nodes;
+                std::list<uint16_t> _queue;
+                uint16_t _remaining;
+                uint16_t _running;
+                uint8_t _threads;
+                uint64_t _start;
+            };
+
+            // The officers the security plugin handed out for the most recently used tokens, so a
+            // token that comes back on every request is only validated once. Entries are keyed on
+            // a digest of the token and are dropped when the token expires (its "exp" claim), when
+            // the least recently used one has to make room, or when their officer is revoked.
+            class Officers {
+            private:
+                struct Entry {
+                    string Digest;
+                    uint64_t Expiry;
+                    ISecurity* Officer;
+                };
+
+                using Entries = std::list<Entry>;
+                using Index = std::unordered_map<string, Entries::iterator>;
+
+            public:
+                Officers() = delete;
+                Officers(Officers&&) = delete;
+                Officers(const Officers&) = delete;
+                Officers& operator=(Officers&&) = delete;
+                Officers& operator=(const Officers&) = delete;
+
+                Officers(const uint16_t size)
+                    : _adminLock()
+                    , _entries()
+                    , _index()
+                    , _size(size)
+                {
+                }
+                ~Officers()
+                {
+                    Clear();
+                }
+
+            public:
+                // Returns the officer of the token with a reference taken, or nullptr if the token
+                // is not (or no longer) known.
+                ISecurity* Find(const string& token);
+                void Insert(const string& token, ISecurity* officer);
+                void Revoke(const Core::IUnknown* officer);
+                void Clear();
+
+            private:
+                static string Digest(const string& token);
+                static uint64_t Expiry(const string& token);
+
+            private:
+                Core::CriticalSection _adminLock;
+                Entries _entries;
+                Index _index;
+                const uint16_t _size;
+            };
+
         public:
             ServiceMap() = delete;
             ServiceMap(ServiceMap&&) = delete;
@@ -2567,6 +2711,7 @@ namespace PluginHost {
                     _engine)
                 , _subSystems(this)
                 , _authenticationHandler(nullptr)
+                , _officers(server._config.TokenCache())
                 , _configObserver(*this, server._config.PluginConfigPath())
                 , _shellObservers()
                 , _channelObservers()
@@ -2590,6 +2735,9 @@ namespace PluginHost {
                 _adminLock.Lock();
 
                 if ((_authenticationHandler == nullptr) ^ (enabled == false)) {
+                    // Whatever was validated before, is validated again by the new situation.
+                    _officers.Clear();
+
                     if (_authenticationHandler == nullptr) {
                         // Let get the AuthentcationHandler.
                         _authenticationHandler = reinterpret_cast<IAuthenticate*>(QueryInterfaceByCallsign(IAuthenticate::ID, _subSystems.SecurityCallsign()));
@@ -2603,17 +2751,24 @@ namespace PluginHost {
             }
             inline ISecurity* Officer(const string& token)
             {
-                ISecurity* result;
+                ISecurity* result = _officers.Find(token);
 
-                _adminLock.Lock();
+                if (result == nullptr) {
+                    _adminLock.Lock();
 
-                if (_authenticationHandler != nullptr) {
-                    result = _authenticationHandler->Officer(token);
-                } else {
-                    result = Configuration().Security();
+                    if (_authenticationHandler != nullptr) {
+                        result = _authenticationHandler->Officer(token);
+
+                        if (result != nullptr) {
+                            _officers.Insert(token, result);
+                        }
+                    } else {
+                        result = Configuration().Security();
+                    }
+
+                    _adminLock.Unlock();
                 }
 
-                _adminLock.Unlock();
                 return (result);
             }
             inline uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response)
@@ -3188,6 +3343,10 @@ namespace PluginHost {
                         _notificationLock.Unlock();
                     }
                 }
+                else if (interfaceId == PluginHost::ISecurity::ID) {
+                    // The security plugin is gone, so are the officers it handed out.
+                    _officers.Revoke(source);
+                }
             }
             void ConfigReload(const string& configs) {
                 // Oke lets check the configs we are observing :-)
@@ -3289,6 +3448,7 @@ namespace PluginHost {
             CommunicatorServer _processAdministrator;
             Core::SinkType<SubSystems> _subSystems;
             IAuthenticate* _authenticationHandler;
+            Officers _officers;
             ConfigObserver _configObserver;
             ShellNotifiers _shellObservers;
             ChannelObservers _channelObservers;
@@ -3301,6 +3461,87 @@ namespace PluginHost {
         class Channel : public PluginHost::Channel {
         public:
             class Job : public Core::IDispatch {
+            private:
+                // The calls of a batch that is dispatched in parallel. The job that owns the batch takes part
+                // in it as well, so it never waits for a call that did not start yet, a busy pool can not
+                // block it.
+                class Batch {
+                public:
+                    Batch() = delete;
+                    Batch(Batch&&) = delete;
+                    Batch(const Batch&) = delete;
+                    Batch& operator=(Batch&&) = delete;
+                    Batch& operator=(const Batch&) = delete;
+
+                    Batch(Job& parent, const string& token, std::vector<const Core::JSONRPC::Message*>& calls)
+                        : _parent(parent)
+                        , _token(token)
+                        , _calls(calls)
+                        , _responses(calls.size())
+                        , _next(0)
+                        , _pending(static_cast<uint32_t>(calls.size()))
+                        , _done(false, true)
+                    {
+                    }
+                    ~Batch() = default;
+
+                public:
+                    void Run()
+                    {
+                        uint32_t index;
+
+                        while ((index = _next++) < _calls.size()) {
+                            if (_calls[index] != nullptr) {
+                                _responses[index] = _parent.Process(_token, *(_calls[index]));
+                            }
+                            if (--_pending == 0) {
+                                _done.SetEvent();
+                            }
+                        }
+                    }
+                    void Wait()
+                    {
+                        _done.Lock(Core::infinite);
+                    }
+                    Core::ProxyType<Core::JSONRPC::Message>& Response(const uint32_t index)
+                    {
+                        return (_responses[index]);
+                    }
+
+                private:
+                    Job& _parent;
+                    const string _token;
+                    const std::vector<const Core::JSONRPC::Message*> _calls;
+                    std::vector<Core::ProxyType<Core::JSONRPC::Message>> _responses;
+                    std::atomic<uint32_t> _next;
+                    std::atomic<uint32_t> _pending;
+                    Core::Event _done;
+                };
+                class Helper : public Core::IDispatch {
+                public:
+                    Helper() = delete;
+                    Helper(Helper&&) = delete;
+                    Helper(const Helper&) = delete;
+                    Helper& operator=(Helper&&) = delete;
+                    Helper& operator=(const Helper&) = delete;
+
+                    Helper(const Core::ProxyType<Batch>& batch)
+                        : _batch(batch)
+                    {
+                    }
+                    ~Helper() override = default;
+
+                public:
+                    void Dispatch() override
+                    {
+                        // If the owner already did all the work, there is nothing left to do.
+                        _batch->Run();
+                    }
+
+                private:
+                    Core::ProxyType<Batch> _batch;
+                };
+
             public:
                 Job(Job&&) = delete;
                 Job(const Job&) = delete;
@@ -3369,11 +3610,85 @@ namespace PluginHost {
                     return result;
                 }
                 Core::ProxyType<Core::JSONRPC::Message> Process(const string& token, const Core::ProxyType<Core::JSONRPC::Message>& message)
+                {
+                    return (Process(token, *message));
+                }
+                Core::ProxyType<Core::JSONRPC::Message> Process(const string& token, const Core::JSONRPC::Message& message)
                 {
                     Core::ProxyType<Core::JSONRPC::Message> result;
-                    REPORT_DURATION_WARNING( { result = _service->Invoke(_ID, token, *message); }, WarningReporting::TooLongInvokeMessage, *message);
+                    REPORT_DURATION_WARNING( { result = _service->Invoke(_ID, token, message); }, WarningReporting::TooLongInvokeMessage, message);
                     return result;
                 }
+                // Dispatches all calls of a batch, their responses replace the calls. Notifications and calls
+                // that are answered asynchronously leave nothing behind, if nothing is left, false is returned.
+                bool Process(const string& token, Web::JSONRPC::Body& message, const bool parallel)
+                {
+                    Web::JSONRPC::Body::Calls& calls(message.Batch());
+                    Web::JSONRPC::Body::Calls::Iterator index(calls.Elements());
+                    std::vector<const Core::JSONRPC::Message*> requests;
+
+                    while (index.Next() == true) {
+                        Core::JSONRPC::Message& call(index.Current());
+
+                        if (HasService() == true) {
+                            call.ImplicitCallsign(GetService().Callsign());
+                        }
+
+                        // Calls that already carry an error (e.g. they were not allowed) are not dispatched.
+                        requests.push_back(call.Error.IsSet() == true ? nullptr : &call);
+                    }
+
+                    if (requests.empty() == true) {
+                        // An empty batch is answered with a single error.
+                        message.Clear();
+                        message.Id.Null(true);
+                        message.Error.SetError(Core::ERROR_INVALID_ENVELOPPE);
+                    }
+                    else {
+                        Core::ProxyType<Batch> batch(Core::ProxyType<Batch>::Create(*this, token, requests));
+
+                        if (parallel == true) {
+                            const uint32_t helpers = std::min(static_cast<uint32_t>(requests.size() - 1), static_cast<uint32_t>(THREADPOOL_COUNT - 1));
+
+                            for (uint32_t helper = 0; helper < helpers; helper++) {
+                                _server->Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<Helper>::Create(batch)));
+                            }
+                        }
+
+                        batch->Run();
+                        batch->Wait();
+
+                        Web::JSONRPC::Body::Calls answers;
+                        uint32_t position = 0;
+
+                        index.Reset();
+
+                        while (index.Next() == true) {
+                            const Core::JSONRPC::Message& call(index.Current());
+                            const Core::ProxyType<Core::JSONRPC::Message>& response(batch->Response(position++));
+
+                            if (response.IsValid() == true) {
+                                answers.Add(*response);
+                            }
+                            else if (call.Error.IsSet() == true) {
+                                Core::JSONRPC::Message& answer(answers.Add());
+
+                                if (call.Id.IsSet() == true) {
+                                    answer.Id = call.Id.Value();
+                                }
+                                else {
+                                    answer.Id.Null(true);
+                                }
+                                answer.Error.Code = call.Error.Code.Value();
+                                answer.Error.Text = call.Error.Text.Value();
+                            }
+                        }
+
+                        calls = std::move(answers);
+                    }
+
+                    return ((message.IsBatch() == false) || (calls.Length() > 0));
+                }
                 Core::ProxyType<Web::Response> Process(const Core::ProxyType<Web::Request>& message)
                 {
                     Core::ProxyType<Web::Response> result;
@@ -3433,6 +3748,7 @@ namespace PluginHost {
                     : Job()
                     , _request()
                     , _jsonrpc(false)
+                    , _parallel(false)
                 {
                 }
                 ~WebRequestJob() override
@@ -3459,6 +3775,7 @@ namespace PluginHost {
                     _request = request;
                     _jsonrpc = JSONRPC && (_request->HasBody() == true);
                     _token = token;
+                    _parallel = server->Configuration().ParallelBatch();
                 }
                 void Dispatch() override
                 {
@@ -3470,8 +3787,26 @@ namespace PluginHost {
                     if (_jsonrpc == true) {
                         if(_request->Verb == Request::HTTP_POST) {
                             Core::ProxyType<Web::JSONRPC::Body> message(_request->Body<Web::JSONRPC::Body>());
-                            if ( (message->Report().IsSet() == true) || (message->IsComplete() == false) ) {
+                            if ( (message->IsBatch() == true) && (message->Report().IsSet() == false) ) {
+                                response = IFactories::Instance().Response();
+
+                                if (Job::Process(_token, *message, _parallel) == true) {
+                                    response->Body(Core::ProxyType<Web::IBody>(message));
+                                    response->ErrorCode = Web::STATUS_OK;
+                                    response->Message = _T("JSONRPC batch executed succesfully");
+                                }
+                                else {
+                                    response->ErrorCode = Web::STATUS_NO_CONTENT;
+                                    response->Message = _T("A JSONRPC batch of Notifications was send to the server. Processed it..");
+                                }
+
+                                if (_request->Connection.Value() == Web::Request::CONNECTION_CLOSE) {
+                                    Job::RequestClose();
+                                }
+                            }
+                            else if ( (message->Report().IsSet() == true) || (message->IsComplete() == false) ) {
                                 // Looks like we have a corrupted message.. Respond if posisble, with an error
+                                message->Single();
                                 response = IFactories::Instance().Response();
 
                                 response->ErrorCode = Web::STATUS_BAD_REQUEST;
@@ -3592,6 +3927,7 @@ namespace PluginHost {
                 Core::ProxyType<Web::Request> _request;
                 string _token;
                 bool _jsonrpc;
+                bool _parallel;
 
                 static Core::ProxyType<Web::Response> _missingResponse;
             };
@@ -3606,6 +3942,7 @@ namespace PluginHost {
                     : Job()
                     , _element()
                     , _jsonrpc(false)
+                    , _parallel(false)
                 {
                 }
                 ~JSONElementJob() override
@@ -3627,6 +3964,7 @@ namespace PluginHost {
                     _element = element;
                     _jsonrpc = JSONRPC;
                     _token = token;
+                    _parallel = server->Configuration().ParallelBatch();
                 }
                 void Dispatch() override
                 {
@@ -3645,6 +3983,8 @@ namespace PluginHost {
                         ASSERT(message.IsValid() == true);
 
                         if (message->Report().IsSet() == true) {
+                            message->Single();
+
                             // If we also do not have an id, we can not return a suitable JSON message!
                             if (message->Recorded().IsSet() == false) {
                                 message->Id.Null(true);
@@ -3656,6 +3996,12 @@ namespace PluginHost {
                             message->Error.SetError(Core::ERROR_PARSE_FAILURE);
                             message->Error.Text = message->Report().Value().Message();
                         }
+                        else if (message->IsBatch() == true) {
+                            // All responses go back in one message, if there are any.
+                            if (Job::Process(_token, *message, _parallel) == false) {
+                                _element.Release();
+                            }
+                        }
                         else {
                             if (HasService() == true) {
                                 message->ImplicitCallsign(GetService().Callsign());
@@ -3695,6 +4041,7 @@ namespace PluginHost {
                 Core::ProxyType<Core::JSON::IElement> _element;
                 string _token;
                 bool _jsonrpc;
+                bool _parallel;
             };
             class TextJob : public Job {
             public:
@@ -3856,6 +4203,24 @@ namespace PluginHost {
                 return (_security != nullptr ? _security->Allowed(pathParameter) : false);
             }
 
+            // Every call in a batch has to be allowed on its own, the ones that are not get an error
+            // and are answered as such, without being dispatched.
+            static void Clearance(ISecurity& security, Web::JSONRPC::Body& batch, const string& callsign)
+            {
+                Web::JSONRPC::Body::Calls::Iterator index(batch.Batch().Elements());
+
+                while (index.Next() == true) {
+                    Core::JSONRPC::Message& call(index.Current());
+
+                    call.ImplicitCallsign(callsign);
+
+                    if (security.Allowed(call) == false) {
+                        call.Error.SetError(Core::ERROR_PRIVILIGED_REQUEST);
+                        call.Error.Text = _T("method invokation not allowed.");
+                    }
+                }
+            }
+
             // Handle the HTTP Web requests.
             // [INBOUND]  Completed received requests are triggering the Received,
             // [OUTBOUND] Completed send responses are triggering the Send.
@@ -3929,8 +4294,13 @@ namespace PluginHost {
 
                         request->Service(status, Core::ProxyType<PluginHost::Service>(service), serviceCall);
                     } else if ((request->State() == Request::COMPLETE) && (request->HasBody() == true)) {
+                        Core::ProxyType<Web::JSONRPC::Body> batch(request->Body<Web::JSONRPC::Body>());
                         Core::ProxyType<Core::JSONRPC::Message> message(request->Body<Core::JSONRPC::Message>());
-                        if (message.IsValid() == true) {
+                        if ((batch.IsValid() == true) && (batch->IsBatch() == true)) {
+                            ASSERT(request->Service().IsValid() == true);
+                            Clearance(*security, *batch, request->Service()->Callsign());
+                        }
+                        else if (message.IsValid() == true) {
                             ASSERT(request->Service().IsValid() == true);
                             message->ImplicitCallsign(request->Service()->Callsign());
                             if (security->Allowed(*message) == false) {
@@ -4049,8 +4419,18 @@ namespace PluginHost {
                 TRACE(SocketFlow, (element));
 
                 if (securityClearance == false) {
+                    Core::ProxyType<Web::JSONRPC::Body> batch(element);
                     Core::ProxyType<Core::JSONRPC::Message> message(element);
-                    if (message.IsValid()) {
+
+                    if ((batch.IsValid() == true) && (batch->IsBatch() == true)) {
+                        // The calls that are not allowed are answered within the batch.
+                        PluginHost::Channel::Lock();
+                        Clearance(*_security, *batch, _service->Callsign());
+                        PluginHost::Channel::Unlock();
+
+                        securityClearance = true;
+                    }
+                    else if (message.IsValid()) {
 
                         message->ImplicitCallsign(_service->Callsign());
 
@@ -4143,6 +4523,8 @@ namespace PluginHost {
 
                     _parent.Operational(Id(), false);
 
+                    _parent._connections.Reclaim(Id());
+
                 } else if (IsUpgrading() == true) {
 
                     ASSERT(_service.IsValid() == false);
@@ -4207,6 +4589,11 @@ namespace PluginHost {
                     } else if (protocol == _T("jsonrpc")) {
                         State(JSONRPC, false);
                         return protocol;
+                    } else if (protocol == _T("jsonrpc.msgpack")) {
+                        // Same JSON-RPC, only in MessagePack, binary frames.
+                        Packed();
+                        State(JSONRPC, false);
+                        return protocol;
                     } else if (protocol == _T("raw")) {
                         State(RAW, false);
                         return protocol;
@@ -4251,8 +4638,8 @@ namespace PluginHost {
             ChannelMap& operator=(const ChannelMap&) = delete;
 
             PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
-            ChannelMap(Server& parent, const Core::NodeId& listeningNode)
-                : Core::SocketServerType<Channel>(listeningNode)
+            ChannelMap(Server& parent, const Core::NodeId& listeningNode, const uint8_t listeners)
+                : Core::SocketServerType<Channel>(listeningNode, listeners)
                 , _parent(parent)
                 , _connectionCheckTimer(0)
                 , _job(*this)
@@ -4308,6 +4695,12 @@ namespace PluginHost {
                     _job.Submit();
                 }
             }
+            void Reclaim(const uint32_t id)
+            {
+                BaseClass::Reclaim(id);
+
+                Cleanup();
+            }
             void GetMetadata(Core::JSON::ArrayType<Metadata::Channel>& metaData) const;
 
         private:
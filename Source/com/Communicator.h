@@ -1604,6 +1604,8 @@ POP_WARNING()
         static uint8_t _hardKillCheckWaitTime;
     };
 
+    // Like all COMRPC channels, this one has a single call in flight unless Multiplexed(true) is
+    // called on it, both ends need to be built with multiplexed (tagged) call support.
     class EXTERNAL CommunicatorClient : public Core::IPCChannelClientType<Core::Void, false, true>, public Core::IDispatchType<Core::IIPC> {
     private:
         typedef Core::IPCChannelClientType<Core::Void, false, true> BaseClass;
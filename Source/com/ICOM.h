@@ -65,5 +65,7 @@ namespace WPEFramework {
 
         typedef IIteratorType<string, ID_STRINGITERATOR> IStringIterator;
         typedef IIteratorType<uint32_t, ID_VALUEITERATOR> IValueIterator;
+        typedef IBatchIteratorType<string, ID_STRINGITERATOR_BATCH> IStringBatchIterator;
+        typedef IBatchIteratorType<uint32_t, ID_VALUEITERATOR_BATCH> IValueBatchIterator;
     }
 }
@@ -41,5 +41,20 @@ namespace RPC {
         virtual uint32_t Count() const = 0;
         virtual ELEMENT Current() const = 0;
     };
+
+    // Offered next to an IIteratorType by iterators that can hand out more than one element per
+    // call, so a remote iterator can be copied in a handful of round trips instead of one per element.
+    template<typename ELEMENT, const uint32_t INTERFACE_ID>
+    struct IBatchIteratorType : virtual public Core::IUnknown {
+
+        typedef ELEMENT Element;
+
+        enum { ID = INTERFACE_ID };
+
+        ~IBatchIteratorType() override = default;
+
+        // Returns the number of elements read, less than count once the end has been reached.
+        virtual uint16_t Next(const uint16_t count, ELEMENT elements[] /* @out @length:count */) = 0;
+    };
 }
 }
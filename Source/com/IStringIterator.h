@@ -28,6 +28,6 @@
 namespace WPEFramework {
 namespace RPC {
 
-    typedef IteratorType<IStringIterator> StringIterator;
+    typedef BatchIteratorType<IStringIterator, IStringBatchIterator> StringIterator;
 }
 }
@@ -28,7 +28,7 @@
 namespace WPEFramework {
 namespace RPC {
 
-    typedef IteratorType<IValueIterator> ValueIterator;
+    typedef BatchIteratorType<IValueIterator, IValueBatchIterator> ValueIterator;
 
 }
 }
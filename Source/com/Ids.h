@@ -89,6 +89,8 @@ namespace RPC {
         ID_SUBSYSTEM_DECRYPTION             = (ID_OFFSET_INTERNAL + 0x003E),
         ID_REMOTE_INSTANTIATION             = (ID_OFFSET_INTERNAL + 0x003F),
         ID_SYSTEM_METADATA                  = (ID_OFFSET_INTERNAL + 0x0040),
+        ID_STRINGITERATOR_BATCH             = (ID_OFFSET_INTERNAL + 0x0041),
+        ID_VALUEITERATOR_BATCH              = (ID_OFFSET_INTERNAL + 0x0042),
 
         ID_EXTERNAL_INTERFACE_OFFSET        = (ID_OFFSET_INTERNAL + 0x0080),
         ID_EXTERNAL_QA_INTERFACE_OFFSET     = (ID_OFFSET_INTERNAL + 0xA000)
@@ -177,5 +177,76 @@ namespace RPC {
         mutable typename Container::iterator _iterator;
         mutable uint32_t _index;
     };
+
+    // An IteratorType that offers the BATCH interface as well. Copying a (remote) iterator through
+    // it asks for that interface and reads the elements BatchSize at a time when it is offered.
+    template<typename INTERFACE, typename BATCH>
+    class BatchIteratorType : public IteratorType<INTERFACE>, public BATCH {
+    private:
+        static constexpr uint16_t BatchSize = 32;
+
+    public:
+        using Container = typename IteratorType<INTERFACE>::Container;
+
+        BatchIteratorType() = delete;
+        BatchIteratorType(const BatchIteratorType&) = delete;
+        BatchIteratorType& operator=(const BatchIteratorType&) = delete;
+
+        using IteratorType<INTERFACE>::IteratorType;
+
+        BatchIteratorType(INTERFACE* index)
+            : IteratorType<INTERFACE>(Container())
+        {
+            if (index != nullptr) {
+                BATCH* batch = index->template QueryInterface<BATCH>();
+
+                if (batch == nullptr) {
+                    typename INTERFACE::Element result;
+                    while (index->Next(result) == true) {
+                        IteratorType<INTERFACE>::Add(result);
+                    }
+                } else {
+                    typename INTERFACE::Element elements[BatchSize];
+                    uint16_t loaded;
+
+                    // A short batch means the end has been reached.
+                    do {
+                        loaded = batch->Next(BatchSize, elements);
+                        for (uint16_t teller = 0; teller < loaded; teller++) {
+                            IteratorType<INTERFACE>::Add(elements[teller]);
+                        }
+                    } while (loaded == BatchSize);
+
+                    batch->Release();
+                }
+                IteratorType<INTERFACE>::Reset(0);
+            }
+        }
+
+        ~BatchIteratorType()
+        {
+        }
+
+    public:
+        virtual uint32_t AddRef() const = 0;
+        virtual uint32_t Release() const = 0;
+
+        virtual uint16_t Next(const uint16_t count, typename INTERFACE::Element elements[]) override
+        {
+            uint16_t loaded = 0;
+
+            while ((loaded < count) && (IteratorType<INTERFACE>::Next(elements[loaded]) == true)) {
+                loaded++;
+            }
+
+            return (loaded);
+        }
+        using IteratorType<INTERFACE>::Next;
+
+        BEGIN_INTERFACE_MAP(BatchIteratorType)
+            INTERFACE_ENTRY(INTERFACE)
+            INTERFACE_ENTRY(BATCH)
+        END_INTERFACE_MAP
+    };
 }
 }
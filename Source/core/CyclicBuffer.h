@@ -153,6 +153,16 @@ namespace Core {
 
             return (overwritten);
         }
+        // Producers can coalesce their notifications, only the one that raises the flag has
+        // to notify. The consumer lowers it once it found the buffer empty.
+        inline bool Signal()
+        {
+            return ((std::atomic_fetch_or(&(_administration->_state), static_cast<uint16_t>(SIGNALLED)) & SIGNALLED) == 0);
+        }
+        inline void Signalled()
+        {
+            std::atomic_fetch_and(&(_administration->_state), static_cast<uint16_t>(~SIGNALLED));
+        }
         inline uint32_t ErrorCode() const
         {
             return (_buffer.ErrorCode());
@@ -284,7 +294,8 @@ namespace Core {
             UNLOCKED = 0x00,
             LOCKED = 0x01,
             OVERWRITE = 0x02,
-            OVERWRITTEN = 0x04
+            OVERWRITTEN = 0x04,
+            SIGNALLED = 0x08
         };
 
         Core::DataElementFile _buffer;
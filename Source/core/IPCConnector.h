@@ -473,6 +473,106 @@ POP_WARNING()
         private:
             friend IPCChannel;
 
+            // Frames carrying this bit in their label are prefixed with a correlation tag, so
+            // multiple calls can be in flight on a channel and be answered in any order.
+            static constexpr uint32_t TAGGED = 0x10000000;
+
+            class TaggedMessage : public IMessage {
+            public:
+                TaggedMessage() = delete;
+                TaggedMessage(const TaggedMessage&) = delete;
+                TaggedMessage& operator=(const TaggedMessage&) = delete;
+
+                TaggedMessage(const ProxyType<IMessage>& message, const uint32_t tag)
+                    : _factory(nullptr)
+                    , _label(message->Label())
+                    , _tag(tag)
+                    , _message(message)
+                {
+                }
+                TaggedMessage(IPCFactory& factory, const uint32_t label)
+                    : _factory(&factory)
+                    , _label(label)
+                    , _tag(0)
+                    , _message()
+                {
+                }
+                ~TaggedMessage() override = default;
+
+            public:
+                uint32_t Tag() const
+                {
+                    return (_tag);
+                }
+                const ProxyType<IMessage>& Message() const
+                {
+                    return (_message);
+                }
+                uint32_t Label() const override
+                {
+                    return (_label | TAGGED);
+                }
+                uint32_t Length() const override
+                {
+                    return (sizeof(_tag) + (_message.IsValid() == true ? _message->Length() : 0));
+                }
+                uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, const uint32_t offset) const override
+                {
+                    uint16_t result = 0;
+
+                    while (((offset + result) < sizeof(_tag)) && (result < maxLength)) {
+                        stream[result] = static_cast<uint8_t>(_tag >> (8 * (offset + result)));
+                        result++;
+                    }
+                    if (result < maxLength) {
+                        result += _message->Serialize(&stream[result], maxLength - result, offset + result - sizeof(_tag));
+                    }
+
+                    return (result);
+                }
+                uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, const uint32_t offset) override
+                {
+                    uint16_t result = 0;
+
+                    while (((offset + result) < sizeof(_tag)) && (result < maxLength)) {
+                        _tag |= (static_cast<uint32_t>(stream[result]) << (8 * (offset + result)));
+                        result++;
+
+                        if (((offset + result) == sizeof(_tag)) && (_factory != nullptr)) {
+                            // Now we know who is waiting for this response..
+                            _message = _factory->Pending(_label >> 1, _tag);
+                        }
+                    }
+                    if (result < maxLength) {
+                        if (_message.IsValid() == true) {
+                            result += _message->Deserialize(&stream[result], maxLength - result, offset + result - sizeof(_tag));
+                        } else {
+                            // Nobody is waiting for this (anymore), drop the content.
+                            result = maxLength;
+                        }
+                    }
+
+                    return (result);
+                }
+
+            private:
+                IPCFactory* _factory;
+                uint32_t _label;
+                uint32_t _tag;
+                ProxyType<IMessage> _message;
+            };
+
+            struct Outbound {
+                ProxyType<IIPC> Message;
+                IDispatchType<IIPC>* Callback;
+                bool* Failed;
+            };
+
+            struct Tagged {
+                ProxyType<IIPC> Message;
+                uint32_t Tag;
+            };
+
             IPCFactory()
                 : _lock()
                 , _inbound()
@@ -480,6 +580,9 @@ POP_WARNING()
                 , _callback(nullptr)
                 , _factory()
                 , _handlers()
+                , _tag(0)
+                , _pending()
+                , _tags()
             {
             }
             void Factory(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory)
@@ -500,6 +603,9 @@ POP_WARNING()
                 , _callback(nullptr)
                 , _factory(factory)
                 , _handlers()
+                , _tag(0)
+                , _pending()
+                , _tags()
             {
                 // Only creat the IPCFactory with a valid base factory
                 ASSERT(factory.IsValid());
@@ -563,7 +669,25 @@ POP_WARNING()
 
                 _lock.Lock();
 
-                if (identifier & 0x01) {
+                if ((identifier & TAGGED) != 0) {
+                    const uint32_t label(identifier & (~TAGGED));
+
+                    if ((label & 0x01) != 0) {
+                        // The actual response is only known once the tag has been read.
+                        result = ProxyType<IMessage>(ProxyType<TaggedMessage>::Create(*this, label));
+                    } else {
+                        ASSERT(_inbound.IsValid() == false);
+
+                        ProxyType<IIPC> rpcCall(_factory->Element(label >> 1));
+
+                        if (rpcCall.IsValid() == true) {
+                            _inbound = rpcCall;
+                            result = ProxyType<IMessage>(ProxyType<TaggedMessage>::Create(rpcCall->IParameters(), 0));
+                        } else {
+                            TRACE_L1("No RPC method definition for ID [%d].\n", label >> 1);
+                        }
+                    }
+                } else if (identifier & 0x01) {
                     if ((_outbound.IsValid() == true) && (_outbound->Label() == searchIdentifier)) {
                         result = _outbound->IResponse();
                     } else {
@@ -602,6 +726,9 @@ POP_WARNING()
                     _inbound.Release();
                 }
 
+                _pending.clear();
+                _tags.clear();
+
                 _lock.Unlock();
             }
 
@@ -611,7 +738,30 @@ POP_WARNING()
 
                 _lock.Lock();
 
-                if ((_outbound.IsValid() == true) && (_outbound->IResponse() == rhs)) {
+                if ((rhs->Label() & (TAGGED | 0x01)) == (TAGGED | 0x01)) {
+                    const TaggedMessage& response(static_cast<const TaggedMessage&>(*rhs));
+                    std::map<uint32_t, Outbound>::iterator index(_pending.find(response.Tag()));
+
+                    if (index != _pending.end()) {
+                        ProxyType<IIPC> handledObject(index->second.Message);
+                        IDispatchType<IIPC>* callback(index->second.Callback);
+
+                        if (response.Message().IsValid() == false) {
+                            // The tag is known, but it answers another method. The actual answer will
+                            // not come anymore, the call is done, it failed.
+                            TRACE_L1("Response for tag [%d] does not belong to method [%d].\n", response.Tag(), handledObject->Label());
+
+                            if (index->second.Failed != nullptr) {
+                                *(index->second.Failed) = true;
+                            }
+                        }
+
+                        _pending.erase(index);
+                        callback->Dispatch(*handledObject);
+                    } else {
+                        TRACE_L1("Unexpected response message for tag [%d].\n", response.Tag());
+                    }
+                } else if ((_outbound.IsValid() == true) && (_outbound->IResponse() == rhs)) {
 
                     ASSERT(_callback != nullptr);
 
@@ -631,6 +781,13 @@ POP_WARNING()
                     if (index != _handlers.end()) {
                         procedure = (*index).second;
                         inbound = _inbound;
+
+                        if ((rhs->Label() & TAGGED) != 0) {
+                            // Remember the tag, the response has to carry it back. The call is held on
+                            // to till then, so it can not return to its pool and come back for another
+                            // call while it is still tagged.
+                            _tags[&(*_inbound)] = Tagged { _inbound, static_cast<const TaggedMessage&>(*rhs).Tag() };
+                        }
                     } else {
                         TRACE_L1("No handler defined to handle the incoming frames. [%d]", _inbound->Label());
                     }
@@ -683,6 +840,110 @@ POP_WARNING()
                 return (result);
             }
 
+            // The channel is gone, nobody will answer the outstanding calls anymore.
+            bool AbortAll()
+            {
+                bool result = AbortOutbound();
+
+                _lock.Lock();
+
+                while (_pending.empty() == false) {
+                    std::map<uint32_t, Outbound>::iterator index(_pending.begin());
+                    ProxyType<IIPC> handledObject(index->second.Message);
+                    IDispatchType<IIPC>* callback(index->second.Callback);
+
+                    _pending.erase(index);
+                    callback->Dispatch(*handledObject);
+
+                    result = true;
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+
+            // Multiplexed calls, each outstanding call is identified by its own tag. If the call fails
+            // on the way back, failed (if given) is set before the callback is dispatched.
+            ProxyType<IMessage> SetPending(const Core::ProxyType<IIPC>& outbound, IDispatchType<IIPC>* callback, uint32_t& tag, bool* failed = nullptr)
+            {
+                ASSERT((outbound.IsValid() == true) && (callback != nullptr));
+
+                _lock.Lock();
+
+                do {
+                    _tag++;
+                } while ((_tag == 0) || (_pending.find(_tag) != _pending.end()));
+
+                tag = _tag;
+                _pending.insert(std::pair<uint32_t, Outbound>(tag, Outbound { outbound, callback, failed }));
+
+                _lock.Unlock();
+
+                return (ProxyType<IMessage>(ProxyType<TaggedMessage>::Create(outbound->IParameters(), tag)));
+            }
+
+            bool AbortPending(const uint32_t tag)
+            {
+                bool result = false;
+
+                _lock.Lock();
+
+                std::map<uint32_t, Outbound>::iterator index(_pending.find(tag));
+
+                if (index != _pending.end()) {
+                    ProxyType<IIPC> handledObject(index->second.Message);
+                    IDispatchType<IIPC>* callback(index->second.Callback);
+
+                    _pending.erase(index);
+                    callback->Dispatch(*handledObject);
+
+                    result = true;
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+
+            ProxyType<IMessage> Response(Core::ProxyType<IIPC>& inbound)
+            {
+                ProxyType<IMessage> result;
+
+                _lock.Lock();
+
+                std::map<const IIPC*, Tagged>::iterator index(_tags.find(&(*inbound)));
+
+                if (index == _tags.end()) {
+                    result = inbound->IResponse();
+                } else {
+                    result = ProxyType<IMessage>(ProxyType<TaggedMessage>::Create(inbound->IResponse(), index->second.Tag));
+                    _tags.erase(index);
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+
+        private:
+            ProxyType<IMessage> Pending(const uint32_t identifier, const uint32_t tag)
+            {
+                ProxyType<IMessage> result;
+
+                _lock.Lock();
+
+                std::map<uint32_t, Outbound>::iterator index(_pending.find(tag));
+
+                if ((index != _pending.end()) && (index->second.Message->Label() == identifier)) {
+                    result = index->second.Message->IResponse();
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+
         private:
             mutable CriticalSection _lock;
             Core::ProxyType<IIPC> _inbound;
@@ -690,12 +951,16 @@ POP_WARNING()
             IDispatchType<IIPC>* _callback;
             Core::ProxyType<FactoryType<IIPC, uint32_t>> _factory;
             std::map<uint32_t, ProxyType<IIPCServer>> _handlers;
+            uint32_t _tag;
+            std::map<uint32_t, Outbound> _pending;
+            std::map<const IIPC*, Tagged> _tags;
         };
 
     protected:
         IPCChannel()
             : _administration()
             , _customData(nullptr)
+            , _multiplexed(false)
         {
         }
 
@@ -712,6 +977,7 @@ POP_WARNING()
         IPCChannel(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory)
             : _administration(factory)
             , _customData(nullptr)
+            , _multiplexed(false)
         {
         }
         virtual ~IPCChannel() = default;
@@ -732,7 +998,7 @@ POP_WARNING()
 
         void Abort()
         {
-            _administration.AbortOutbound();
+            _administration.AbortAll();
         }
         template <typename ACTUALELEMENT>
         uint32_t Invoke(const ProxyType<ACTUALELEMENT>& command, IDispatchType<IIPC>* completed)
@@ -762,6 +1028,21 @@ POP_WARNING()
             _customData = data;
         }
 
+        // By default a channel has a single call in flight. In multiplexed mode every call
+        // is tagged, so concurrent callers do not have to wait for each other. The remote
+        // side answers tagged calls with tagged responses, so it only needs to be set on
+        // the side that does the invoking.
+        // Nothing turns it on by itself, the COMRPC channels of the Communicator included,
+        // it is opt-in per channel.
+        bool IsMultiplexed() const
+        {
+            return (_multiplexed);
+        }
+        void Multiplexed(const bool enabled)
+        {
+            _multiplexed = enabled;
+        }
+
         virtual uint32_t ReportResponse(Core::ProxyType<IIPC>& inbound) = 0;
 
     private:
@@ -773,6 +1054,7 @@ POP_WARNING()
 
     private:
         const void* _customData;
+        std::atomic<bool> _multiplexed;
     };
 
     template <typename ACTUALSOURCE, typename EXTENSION>
@@ -802,7 +1084,7 @@ POP_WARNING()
                 ASSERT(inbound.IsValid() == true);
 
                 // This is an inbound call, Report what we have processed !!!
-                return (BaseClass::Submit(inbound->IResponse()));
+                return (BaseClass::Submit(_factory.Response(inbound)));
             }
 
             // Notification of a INBOUND element received.
@@ -848,22 +1130,30 @@ POP_WARNING()
             IPCTrigger(IPCFactory& administration)
                 : _administration(administration)
                 , _signal(false, true)
+                , _tag(0)
+                , _failed(false)
             {
             }
             ~IPCTrigger() override = default;
 
         public:
+            ProxyType<IMessage> Pending(const ProxyType<IIPC>& command)
+            {
+                return (_administration.SetPending(command, this, _tag, &_failed));
+            }
             uint32_t Wait(const uint32_t waitTime)
             {
                 uint32_t result = Core::ERROR_NONE;
 
                 // Now we wait for ever, to get a signal that we are done :-)
                 if (_signal.Lock(waitTime) != Core::ERROR_NONE) {
-                    _administration.AbortOutbound();
+                    Abort();
 
                     result = Core::ERROR_TIMEDOUT;
-                } else if (_administration.AbortOutbound() == true) {
+                } else if (Abort() == true) {
                     result = Core::ERROR_ASYNC_FAILED;
+                } else if (_failed == true) {
+                    result = Core::ERROR_RPC_CALL_FAILED;
                 }
 
                 return (result);
@@ -873,9 +1163,17 @@ POP_WARNING()
                 _signal.SetEvent();
             }
 
+        private:
+            bool Abort()
+            {
+                return (_tag == 0 ? _administration.AbortOutbound() : _administration.AbortPending(_tag));
+            }
+
         private:
             IPCFactory& _administration;
             Event _signal;
+            uint32_t _tag;
+            bool _failed;
         };
 
     public:
@@ -955,22 +1253,32 @@ POP_WARNING()
         {
             uint32_t success = Core::ERROR_UNAVAILABLE;
 
-            _serialize.Lock();
+            if (IsMultiplexed() == true) {
+                if (_link.IsOpen() == true) {
+                    uint32_t tag;
 
-            if (_administration.InProgress() == true) {
-                success = Core::ERROR_INPROGRESS;
-            } else if (_link.IsOpen() == true) {
-                // We need to accept a CONST object to avoid an additional object creation
-                // proxy casted objects.
-                _administration.SetOutbound(command, completed);
+                    _link.Submit(_administration.SetPending(command, completed, tag));
 
-                // Send out the
-                _link.Submit(command->IParameters());
+                    success = Core::ERROR_NONE;
+                }
+            } else {
+                _serialize.Lock();
 
-                success = Core::ERROR_NONE;
-            }
+                if (_administration.InProgress() == true) {
+                    success = Core::ERROR_INPROGRESS;
+                } else if (_link.IsOpen() == true) {
+                    // We need to accept a CONST object to avoid an additional object creation
+                    // proxy casted objects.
+                    _administration.SetOutbound(command, completed);
 
-            _serialize.Unlock();
+                    // Send out the
+                    _link.Submit(command->IParameters());
+
+                    success = Core::ERROR_NONE;
+                }
+
+                _serialize.Unlock();
+            }
 
             return (success);
         }
@@ -978,22 +1286,33 @@ POP_WARNING()
         {
             uint32_t success = Core::ERROR_CONNECTION_CLOSED;
 
-            _serialize.Lock();
+            if (IsMultiplexed() == true) {
+                // No need to serialize, the tag routes the response back to this caller.
+                if (_link.IsOpen() == true) {
+                    IPCTrigger sink(_administration);
 
-            if (_link.IsOpen() == true) {
-                IPCTrigger sink(_administration);
+                    _link.Submit(sink.Pending(command));
 
-                // We need to accept a CONST object to avoid an additional object creation
-                // proxy casted objects.
-                _administration.SetOutbound(command, &sink);
+                    success = sink.Wait(waitTime);
+                }
+            } else {
+                _serialize.Lock();
 
-                // Send out the
-                _link.Submit(command->IParameters());
+                if (_link.IsOpen() == true) {
+                    IPCTrigger sink(_administration);
 
-                success = sink.Wait(waitTime);
-            }
+                    // We need to accept a CONST object to avoid an additional object creation
+                    // proxy casted objects.
+                    _administration.SetOutbound(command, &sink);
 
-            _serialize.Unlock();
+                    // Send out the
+                    _link.Submit(command->IParameters());
+
+                    success = sink.Wait(waitTime);
+                }
+
+                _serialize.Unlock();
+            }
 
             return (success);
         }
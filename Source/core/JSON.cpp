@@ -18,9 +18,23 @@
  */
 
 #include "JSON.h"
+#include <cerrno>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace WPEFramework {
 namespace Core {
     namespace JSON {
@@ -41,6 +55,154 @@ namespace Core {
         /* static */ char IElement::TrueTag[5] = { 't', 'r', 'u', 'e', '\0' };
         /* static */ char IElement::FalseTag[6] = { 'f', 'a', 'l', 's', 'e', '\0' };
 
+#if defined(__SSE2__) || defined(__ARM_NEON)
+        static inline uint8_t FirstSet(const uint64_t mask)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward64(&index, mask);
+            return (static_cast<uint8_t>(index));
+#else
+            return (static_cast<uint8_t>(__builtin_ctzll(mask)));
+#endif
+        }
+#endif
+
+        // Both scanners look at a vector of characters at a time and stop at the first one that needs
+        // attention, whatever is left is checked one character at a time.
+        /* static */ uint16_t String::Verbatim(const char stream[], const uint16_t length)
+        {
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(stream);
+            uint16_t index = 0;
+
+#if defined(__AVX2__)
+            const __m256i wideQuote = _mm256_set1_epi8('\"');
+            const __m256i wideEscape = _mm256_set1_epi8('\\');
+            const __m256i wideControl = _mm256_set1_epi8(0x1F);
+
+            for (; (index + 32) <= length; index += 32) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&data[index]));
+                const __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, wideQuote), _mm256_cmpeq_epi8(block, wideEscape)),
+                    _mm256_cmpeq_epi8(_mm256_max_epu8(block, wideControl), wideControl));
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+
+                if (mask != 0) {
+                    return (index + FirstSet(mask));
+                }
+            }
+#endif
+#if defined(__SSE2__)
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i escape = _mm_set1_epi8('\\');
+            const __m128i control = _mm_set1_epi8(0x1F);
+
+            for (; (index + 16) <= length; index += 16) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index]));
+                const __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, escape)),
+                    _mm_cmpeq_epi8(_mm_max_epu8(block, control), control));
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+
+                if (mask != 0) {
+                    return (index + FirstSet(mask));
+                }
+            }
+#elif defined(__ARM_NEON)
+            const uint8x16_t quote = vdupq_n_u8('\"');
+            const uint8x16_t escape = vdupq_n_u8('\\');
+            const uint8x16_t control = vdupq_n_u8(0x20);
+
+            for (; (index + 16) <= length; index += 16) {
+                const uint8x16_t block = vld1q_u8(&data[index]);
+                const uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(block, quote), vceqq_u8(block, escape)), vcltq_u8(block, control));
+                // Narrow the byte mask to a nibble per character, NEON has no movemask.
+                const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+
+                if (mask != 0) {
+                    return (index + (FirstSet(mask) >> 2));
+                }
+            }
+#endif
+            while ((index < length) && (data[index] != '\"') && (data[index] != '\\') && (data[index] > 0x1F)) {
+                index++;
+            }
+
+            return (index);
+        }
+
+        /* static */ uint16_t String::Printable(const char stream[], const uint16_t length)
+        {
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(stream);
+            uint16_t index = 0;
+
+            // Printable is 0x20 up to 0x7E, the rest is escaped. So are the quote, the backslash and the slash.
+#if defined(__AVX2__)
+            const __m256i wideQuote = _mm256_set1_epi8('\"');
+            const __m256i wideEscape = _mm256_set1_epi8('\\');
+            const __m256i wideSlash = _mm256_set1_epi8('/');
+            const __m256i wideLow = _mm256_set1_epi8(0x1F);
+            const __m256i wideHigh = _mm256_set1_epi8(0x7F);
+
+            for (; (index + 32) <= length; index += 32) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&data[index]));
+                // Signed compares, everything from 0x80 on is negative and so below the lower bound.
+                const __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(block, wideLow), _mm256_cmpgt_epi8(wideHigh, block));
+                const __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, wideQuote), _mm256_cmpeq_epi8(block, wideEscape)),
+                    _mm256_cmpeq_epi8(block, wideSlash));
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_andnot_si256(special, printable))) ^ 0xFFFFFFFF;
+
+                if (mask != 0) {
+                    return (index + FirstSet(mask));
+                }
+            }
+#endif
+#if defined(__SSE2__)
+            const __m128i quote = _mm_set1_epi8('\"');
+            const __m128i escape = _mm_set1_epi8('\\');
+            const __m128i slash = _mm_set1_epi8('/');
+            const __m128i low = _mm_set1_epi8(0x1F);
+            const __m128i high = _mm_set1_epi8(0x7F);
+
+            for (; (index + 16) <= length; index += 16) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index]));
+                const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(block, low), _mm_cmplt_epi8(block, high));
+                const __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, escape)),
+                    _mm_cmpeq_epi8(block, slash));
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_andnot_si128(special, printable))) ^ 0xFFFF;
+
+                if (mask != 0) {
+                    return (index + FirstSet(mask));
+                }
+            }
+#elif defined(__ARM_NEON)
+            const uint8x16_t quote = vdupq_n_u8('\"');
+            const uint8x16_t escape = vdupq_n_u8('\\');
+            const uint8x16_t slash = vdupq_n_u8('/');
+            const uint8x16_t low = vdupq_n_u8(0x20);
+            const uint8x16_t high = vdupq_n_u8(0x7E);
+
+            for (; (index + 16) <= length; index += 16) {
+                const uint8x16_t block = vld1q_u8(&data[index]);
+                const uint8x16_t special = vorrq_u8(
+                    vorrq_u8(vorrq_u8(vceqq_u8(block, quote), vceqq_u8(block, escape)), vceqq_u8(block, slash)),
+                    vorrq_u8(vcltq_u8(block, low), vcgtq_u8(block, high)));
+                const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+
+                if (mask != 0) {
+                    return (index + (FirstSet(mask) >> 2));
+                }
+            }
+#endif
+            while ((index < length) && (data[index] >= 0x20) && (data[index] <= 0x7E) && (data[index] != '\"') && (data[index] != '\\') && (data[index] != '/')) {
+                index++;
+            }
+
+            return (index);
+        }
+
         string Variant::GetDebugString(const TCHAR name[], int indent, int arrayIndex) const
         {
             std::stringstream ss;
@@ -78,6 +240,838 @@ namespace Core {
                 ss << iterator.Current().GetDebugString(iterator.Label(), indent);
             return ss.str();
         }
+
+        namespace {
+
+            // Anything nested deeper than this is not transcoded, to stay away from the end of the stack.
+            constexpr uint8_t MaxDepth = 64;
+
+            class TextReader {
+            public:
+                TextReader() = delete;
+                TextReader(const TextReader&) = delete;
+                TextReader& operator=(const TextReader&) = delete;
+
+                TextReader(const string& text, std::vector<uint8_t>& stream)
+                    : _text(text)
+                    , _index(0)
+                    , _stream(stream)
+                {
+                }
+                ~TextReader() = default;
+
+            public:
+                bool Parse()
+                {
+                    bool result = Value(0);
+
+                    Skip();
+
+                    return ((result == true) && (_index == _text.length()));
+                }
+
+            private:
+                bool IsAt(const char marker) const
+                {
+                    return ((_index < _text.length()) && (_text[_index] == marker));
+                }
+                void Skip()
+                {
+                    while ((_index < _text.length()) && (::isspace(static_cast<unsigned char>(_text[_index])) != 0)) {
+                        _index++;
+                    }
+                }
+                bool Literal(const TCHAR literal[], const uint8_t header)
+                {
+                    const size_t length = ::strlen(literal);
+                    bool result = (_text.compare(_index, length, literal) == 0);
+
+                    if (result == true) {
+                        _index += length;
+                        _stream.push_back(header);
+                    }
+
+                    return (result);
+                }
+                bool Value(const uint8_t depth)
+                {
+                    bool result = false;
+
+                    Skip();
+
+                    if ((_index < _text.length()) && (depth < MaxDepth)) {
+                        switch (_text[_index]) {
+                        case '{':
+                            result = Object(depth);
+                            break;
+                        case '[':
+                            result = Array(depth);
+                            break;
+                        case '"':
+                            result = Text();
+                            break;
+                        case 't':
+                            result = Literal(IElement::TrueTag, 0xC3);
+                            break;
+                        case 'f':
+                            result = Literal(IElement::FalseTag, 0xC2);
+                            break;
+                        case 'n':
+                            result = Literal(IElement::NullTag, IMessagePack::NullValue);
+                            break;
+                        default:
+                            result = Number();
+                            break;
+                        }
+                    }
+
+                    return (result);
+                }
+                bool Object(const uint8_t depth)
+                {
+                    const size_t header = _stream.size();
+                    uint32_t count = 0;
+                    bool result = true;
+
+                    _index++;
+                    _stream.push_back(0);
+
+                    Skip();
+
+                    if (IsAt('}') == true) {
+                        _index++;
+                    } else {
+                        bool more = true;
+
+                        while ((result == true) && (more == true)) {
+                            Skip();
+
+                            result = ((IsAt('"') == true) && (Text() == true));
+
+                            if (result == true) {
+                                Skip();
+                                result = IsAt(':');
+                            }
+                            if (result == true) {
+                                _index++;
+                                result = Value(depth + 1);
+                                count++;
+                            }
+                            if (result == true) {
+                                Skip();
+                                result = (IsAt(',') || IsAt('}'));
+                                more = IsAt(',');
+                                _index++;
+                            }
+                        }
+                    }
+
+                    if (result == true) {
+                        Header(header, count, 0x80, 0xDE);
+                    }
+
+                    return (result);
+                }
+                bool Array(const uint8_t depth)
+                {
+                    const size_t header = _stream.size();
+                    uint32_t count = 0;
+                    bool result = true;
+
+                    _index++;
+                    _stream.push_back(0);
+
+                    Skip();
+
+                    if (IsAt(']') == true) {
+                        _index++;
+                    } else {
+                        bool more = true;
+
+                        while ((result == true) && (more == true)) {
+                            result = Value(depth + 1);
+                            count++;
+
+                            if (result == true) {
+                                Skip();
+                                result = (IsAt(',') || IsAt(']'));
+                                more = IsAt(',');
+                                _index++;
+                            }
+                        }
+                    }
+
+                    if (result == true) {
+                        Header(header, count, 0x90, 0xDC);
+                    }
+
+                    return (result);
+                }
+                // The size of a map or array is only known at the end, one byte is reserved up front.
+                void Header(const size_t position, const uint32_t count, const uint8_t fixed, const uint8_t wide)
+                {
+                    if (count <= 15) {
+                        _stream[position] = static_cast<uint8_t>(fixed | count);
+                    } else {
+                        const uint8_t size = (count <= 0xFFFF ? 2 : 4);
+                        uint8_t bytes[4];
+
+                        for (uint8_t index = 0; index < size; index++) {
+                            bytes[index] = static_cast<uint8_t>(count >> (8 * (size - index - 1)));
+                        }
+
+                        _stream[position] = (size == 2 ? wide : wide + 1);
+                        _stream.insert(_stream.begin() + position + 1, bytes, bytes + size);
+                    }
+                }
+                bool Hex(uint32_t& code)
+                {
+                    bool result = ((_text.length() - _index) >= 4);
+
+                    code = 0;
+
+                    for (uint8_t count = 0; (result == true) && (count < 4); count++) {
+                        const char digit = _text[_index++];
+
+                        code <<= 4;
+
+                        if ((digit >= '0') && (digit <= '9')) {
+                            code |= (digit - '0');
+                        } else if ((digit >= 'a') && (digit <= 'f')) {
+                            code |= (digit - 'a' + 10);
+                        } else if ((digit >= 'A') && (digit <= 'F')) {
+                            code |= (digit - 'A' + 10);
+                        } else {
+                            result = false;
+                        }
+                    }
+
+                    return (result);
+                }
+                bool Unicode(string& value)
+                {
+                    uint32_t code;
+                    bool result = Hex(code);
+
+                    if ((result == true) && (code >= 0xD800) && (code <= 0xDBFF)) {
+                        // A surrogate pair, the low half must follow right away.
+                        uint32_t low = 0;
+
+                        result = (_text.compare(_index, 2, _T("\\u")) == 0);
+
+                        if (result == true) {
+                            _index += 2;
+                            result = ((Hex(low) == true) && (low >= 0xDC00) && (low <= 0xDFFF));
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                    }
+
+                    if (result == true) {
+                        if (code <= 0x7F) {
+                            value += static_cast<char>(code);
+                        } else if (code <= 0x7FF) {
+                            value += static_cast<char>(0xC0 | (code >> 6));
+                            value += static_cast<char>(0x80 | (code & 0x3F));
+                        } else if (code <= 0xFFFF) {
+                            value += static_cast<char>(0xE0 | (code >> 12));
+                            value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                            value += static_cast<char>(0x80 | (code & 0x3F));
+                        } else {
+                            value += static_cast<char>(0xF0 | (code >> 18));
+                            value += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                            value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                            value += static_cast<char>(0x80 | (code & 0x3F));
+                        }
+                    }
+
+                    return (result);
+                }
+                bool Text()
+                {
+                    string value;
+                    bool result = true;
+                    bool done = false;
+
+                    _index++;
+
+                    while ((result == true) && (done == false)) {
+                        if (_index >= _text.length()) {
+                            result = false;
+                        } else {
+                            const char current = _text[_index++];
+
+                            if (current == '"') {
+                                done = true;
+                            } else if (current != '\\') {
+                                value += current;
+                            } else if (_index >= _text.length()) {
+                                result = false;
+                            } else {
+                                const char escaped = _text[_index++];
+
+                                switch (escaped) {
+                                case '"':
+                                case '\\':
+                                case '/':
+                                    value += escaped;
+                                    break;
+                                case 'b':
+                                    value += '\b';
+                                    break;
+                                case 'f':
+                                    value += '\f';
+                                    break;
+                                case 'n':
+                                    value += '\n';
+                                    break;
+                                case 'r':
+                                    value += '\r';
+                                    break;
+                                case 't':
+                                    value += '\t';
+                                    break;
+                                case 'u':
+                                    result = Unicode(value);
+                                    break;
+                                default:
+                                    result = false;
+                                    break;
+                                }
+                            }
+                        }
+                    }
+
+                    if (result == true) {
+                        const uint32_t length = static_cast<uint32_t>(value.length());
+
+                        if (length <= 31) {
+                            _stream.push_back(static_cast<uint8_t>(0xA0 | length));
+                        } else if (length <= 0xFF) {
+                            Pack(0xD9, length, 1);
+                        } else if (length <= 0xFFFF) {
+                            Pack(0xDA, length, 2);
+                        } else {
+                            Pack(0xDB, length, 4);
+                        }
+
+                        _stream.insert(_stream.end(), value.begin(), value.end());
+                    }
+
+                    return (result);
+                }
+                bool Number()
+                {
+                    const size_t start = _index;
+                    bool real = false;
+
+                    while ((_index < _text.length()) && (::strchr("+-0123456789.eE", _text[_index]) != nullptr) && (_text[_index] != '\0')) {
+                        real = (real || (::strchr(".eE", _text[_index]) != nullptr));
+                        _index++;
+                    }
+
+                    const string number(_text, start, _index - start);
+                    char* end = nullptr;
+                    bool result = false;
+
+                    if ((number.empty() == false) && (real == false)) {
+                        errno = 0;
+
+                        if (number[0] == '-') {
+                            const long long value = ::strtoll(number.c_str(), &end, 10);
+                            result = ((*end == '\0') && (errno == 0));
+
+                            if (result == true) {
+                                Signed(value);
+                            }
+                        } else {
+                            const unsigned long long value = ::strtoull(number.c_str(), &end, 10);
+                            result = ((*end == '\0') && (errno == 0));
+
+                            if (result == true) {
+                                Unsigned(value);
+                            }
+                        }
+                    }
+                    if ((number.empty() == false) && (result == false)) {
+                        // Reals, and integers that do not fit in 64 bits.
+                        const double value = ::strtod(number.c_str(), &end);
+                        uint64_t bits;
+
+                        if (*end == '\0') {
+                            ::memcpy(&bits, &value, sizeof(bits));
+                            Pack(0xCB, bits, 8);
+                            result = true;
+                        }
+                    }
+
+                    return (result);
+                }
+                void Unsigned(const uint64_t value)
+                {
+                    if (value <= 0x7F) {
+                        _stream.push_back(static_cast<uint8_t>(value));
+                    } else if (value <= 0xFF) {
+                        Pack(0xCC, value, 1);
+                    } else if (value <= 0xFFFF) {
+                        Pack(0xCD, value, 2);
+                    } else if (value <= 0xFFFFFFFF) {
+                        Pack(0xCE, value, 4);
+                    } else {
+                        Pack(0xCF, value, 8);
+                    }
+                }
+                void Signed(const int64_t value)
+                {
+                    if (value >= 0) {
+                        Unsigned(static_cast<uint64_t>(value));
+                    } else if (value >= -32) {
+                        _stream.push_back(static_cast<uint8_t>(value));
+                    } else if (value >= INT8_MIN) {
+                        Pack(0xD0, static_cast<uint64_t>(value), 1);
+                    } else if (value >= INT16_MIN) {
+                        Pack(0xD1, static_cast<uint64_t>(value), 2);
+                    } else if (value >= INT32_MIN) {
+                        Pack(0xD2, static_cast<uint64_t>(value), 4);
+                    } else {
+                        Pack(0xD3, static_cast<uint64_t>(value), 8);
+                    }
+                }
+                void Pack(const uint8_t header, const uint64_t value, const uint8_t size)
+                {
+                    _stream.push_back(header);
+
+                    for (uint8_t index = size; index > 0; index--) {
+                        _stream.push_back(static_cast<uint8_t>(value >> (8 * (index - 1))));
+                    }
+                }
+
+            private:
+                const string& _text;
+                size_t _index;
+                std::vector<uint8_t>& _stream;
+            };
+
+            class PackReader {
+            public:
+                PackReader() = delete;
+                PackReader(const PackReader&) = delete;
+                PackReader& operator=(const PackReader&) = delete;
+
+                PackReader(const uint8_t stream[], const uint32_t length, string& text)
+                    : _stream(stream)
+                    , _length(length)
+                    , _index(0)
+                    , _text(text)
+                {
+                }
+                ~PackReader() = default;
+
+            public:
+                bool Parse()
+                {
+                    return ((Value(0) == true) && (_index == _length));
+                }
+
+            private:
+                bool Read(const uint8_t size, uint64_t& value)
+                {
+                    bool result = ((_length - _index) >= size);
+
+                    value = 0;
+
+                    if (result == true) {
+                        for (uint8_t index = 0; index < size; index++) {
+                            value = (value << 8) | _stream[_index++];
+                        }
+                    }
+
+                    return (result);
+                }
+                bool Value(const uint8_t depth)
+                {
+                    bool result = ((_index < _length) && (depth < MaxDepth));
+
+                    if (result == true) {
+                        const uint8_t header = _stream[_index++];
+                        uint64_t value = 0;
+
+                        if (header <= 0x7F) {
+                            _text += Core::NumberType<uint8_t>(header).Text();
+                        } else if (header >= 0xE0) {
+                            _text += Core::NumberType<int8_t>(static_cast<int8_t>(header)).Text();
+                        } else if ((header & 0xF0) == 0x80) {
+                            result = Map(header & 0x0F, depth);
+                        } else if ((header & 0xF0) == 0x90) {
+                            result = Array(header & 0x0F, depth);
+                        } else if ((header & 0xE0) == 0xA0) {
+                            result = Text(header & 0x1F);
+                        } else {
+                            switch (header) {
+                            case 0xC0:
+                                _text += IElement::NullTag;
+                                break;
+                            case 0xC2:
+                                _text += IElement::FalseTag;
+                                break;
+                            case 0xC3:
+                                _text += IElement::TrueTag;
+                                break;
+                            case 0xC4:
+                            case 0xC5:
+                            case 0xC6:
+                                result = (Read(1 << (header - 0xC4), value) && Binary(value));
+                                break;
+                            case 0xCA: {
+                                float real;
+                                result = Read(4, value);
+                                const uint32_t bits = static_cast<uint32_t>(value);
+                                ::memcpy(&real, &bits, sizeof(real));
+                                Real(real);
+                                break;
+                            }
+                            case 0xCB: {
+                                double real;
+                                result = Read(8, value);
+                                ::memcpy(&real, &value, sizeof(real));
+                                Real(real);
+                                break;
+                            }
+                            case 0xCC:
+                            case 0xCD:
+                            case 0xCE:
+                            case 0xCF:
+                                result = Read(1 << (header - 0xCC), value);
+                                _text += Core::NumberType<uint64_t>(value).Text();
+                                break;
+                            case 0xD0:
+                                result = Read(1, value);
+                                _text += Core::NumberType<int64_t>(static_cast<int8_t>(value)).Text();
+                                break;
+                            case 0xD1:
+                                result = Read(2, value);
+                                _text += Core::NumberType<int64_t>(static_cast<int16_t>(value)).Text();
+                                break;
+                            case 0xD2:
+                                result = Read(4, value);
+                                _text += Core::NumberType<int64_t>(static_cast<int32_t>(value)).Text();
+                                break;
+                            case 0xD3:
+                                result = Read(8, value);
+                                _text += Core::NumberType<int64_t>(static_cast<int64_t>(value)).Text();
+                                break;
+                            case 0xD9:
+                            case 0xDA:
+                            case 0xDB:
+                                result = (Read(1 << (header - 0xD9), value) && Text(value));
+                                break;
+                            case 0xDC:
+                            case 0xDD:
+                                result = (Read(header == 0xDC ? 2 : 4, value) && Array(value, depth));
+                                break;
+                            case 0xDE:
+                            case 0xDF:
+                                result = (Read(header == 0xDE ? 2 : 4, value) && Map(value, depth));
+                                break;
+                            default:
+                                // Extension types have no JSON counterpart.
+                                result = false;
+                                break;
+                            }
+                        }
+                    }
+
+                    return (result);
+                }
+                bool Array(const uint64_t count, const uint8_t depth)
+                {
+                    bool result = true;
+
+                    _text += '[';
+
+                    for (uint64_t index = 0; (result == true) && (index < count); index++) {
+                        if (index != 0) {
+                            _text += ',';
+                        }
+                        result = Value(depth + 1);
+                    }
+
+                    _text += ']';
+
+                    return (result);
+                }
+                bool Map(const uint64_t count, const uint8_t depth)
+                {
+                    bool result = true;
+
+                    _text += '{';
+
+                    for (uint64_t index = 0; (result == true) && (index < count); index++) {
+                        if (index != 0) {
+                            _text += ',';
+                        }
+
+                        result = (_index < _length);
+
+                        if (result == true) {
+                            const uint8_t header = _stream[_index];
+
+                            if (((header & 0xE0) == 0xA0) || ((header >= 0xD9) && (header <= 0xDB))) {
+                                result = Value(depth + 1);
+                            } else if ((header <= 0x7F) || (header >= 0xE0) || ((header >= 0xCC) && (header <= 0xCF)) || ((header >= 0xD0) && (header <= 0xD3))) {
+                                // JSON only has text labels, integer keys are quoted.
+                                _text += '"';
+                                result = Value(depth + 1);
+                                _text += '"';
+                            } else {
+                                result = false;
+                            }
+                        }
+                        if (result == true) {
+                            _text += ':';
+                            result = Value(depth + 1);
+                        }
+                    }
+
+                    _text += '}';
+
+                    return (result);
+                }
+                bool Text(const uint64_t length)
+                {
+                    bool result = ((_length - _index) >= length);
+
+                    if (result == true) {
+                        const char* text = reinterpret_cast<const char*>(&(_stream[_index]));
+
+                        _text += '"';
+
+                        for (uint32_t index = 0; index < length; index++) {
+                            const char current = text[index];
+
+                            switch (current) {
+                            case '"':
+                                _text += _T("\\\"");
+                                break;
+                            case '\\':
+                                _text += _T("\\\\");
+                                break;
+                            case '\b':
+                                _text += _T("\\b");
+                                break;
+                            case '\f':
+                                _text += _T("\\f");
+                                break;
+                            case '\n':
+                                _text += _T("\\n");
+                                break;
+                            case '\r':
+                                _text += _T("\\r");
+                                break;
+                            case '\t':
+                                _text += _T("\\t");
+                                break;
+                            default:
+                                if (static_cast<uint8_t>(current) < 0x20) {
+                                    TCHAR escaped[8];
+                                    ::snprintf(escaped, sizeof(escaped), _T("\\u%04X"), static_cast<uint8_t>(current));
+                                    _text += escaped;
+                                } else {
+                                    _text += current;
+                                }
+                                break;
+                            }
+                        }
+
+                        _text += '"';
+                        _index += static_cast<uint32_t>(length);
+                    }
+
+                    return (result);
+                }
+                bool Binary(const uint64_t length)
+                {
+                    // Like the JSON::Buffer, binary data is base64 encoded text.
+                    bool result = ((_length - _index) >= length);
+
+                    if (result == true) {
+                        string encoded;
+
+                        Core::ToString(&(_stream[_index]), static_cast<uint32_t>(length), true, encoded);
+
+                        _text += '"';
+                        _text += encoded;
+                        _text += '"';
+                        _index += static_cast<uint32_t>(length);
+                    }
+
+                    return (result);
+                }
+                void Real(const double value)
+                {
+                    if (std::isfinite(value) == false) {
+                        _text += IElement::NullTag;
+                    } else {
+                        TCHAR buffer[32];
+
+                        // The shortest text that reads back as the same value.
+                        ::snprintf(buffer, sizeof(buffer), _T("%.15g"), value);
+                        if (::strtod(buffer, nullptr) != value) {
+                            ::snprintf(buffer, sizeof(buffer), _T("%.17g"), value);
+                        }
+
+                        _text += buffer;
+                    }
+                }
+
+            private:
+                const uint8_t* _stream;
+                const uint32_t _length;
+                uint32_t _index;
+                string& _text;
+            };
+        }
+
+        /* static */ bool IMessagePack::FromText(const string& text, std::vector<uint8_t>& stream)
+        {
+            const size_t start = stream.size();
+            bool result = TextReader(text, stream).Parse();
+
+            if (result == false) {
+                stream.resize(start);
+            }
+
+            return (result);
+        }
+
+        /* static */ bool IMessagePack::ToText(const uint8_t stream[], const uint32_t length, string& text)
+        {
+            text.clear();
+
+            bool result = PackReader(stream, length, text).Parse();
+
+            if (result == false) {
+                text.clear();
+            }
+
+            return (result);
+        }
+
+        /* static */ uint32_t IMessagePack::Length(const uint8_t stream[], const uint32_t length)
+        {
+            // Walks the headers only, the values that are still expected are counted, not recursed.
+            uint64_t pending = 1;
+            uint32_t index = 0;
+            bool complete = true;
+            bool valid = true;
+
+            while ((pending > 0) && (complete == true) && (valid == true)) {
+                if (index >= length) {
+                    complete = false;
+                } else {
+                    const uint8_t header = stream[index++];
+                    uint8_t sized = 0;
+                    uint8_t entries = 0;
+                    uint64_t skip = 0;
+
+                    pending--;
+
+                    if ((header & 0xF0) == 0x80) {
+                        pending += 2 * (header & 0x0F);
+                    } else if ((header & 0xF0) == 0x90) {
+                        pending += (header & 0x0F);
+                    } else if ((header & 0xE0) == 0xA0) {
+                        skip = (header & 0x1F);
+                    } else if ((header > 0x7F) && (header < 0xE0)) {
+                        switch (header) {
+                        case 0xC0:
+                        case 0xC2:
+                        case 0xC3:
+                            break;
+                        case 0xC4:
+                        case 0xC5:
+                        case 0xC6:
+                            sized = (1 << (header - 0xC4));
+                            break;
+                        case 0xC7:
+                        case 0xC8:
+                        case 0xC9:
+                            sized = (1 << (header - 0xC7));
+                            skip = 1;
+                            break;
+                        case 0xCA:
+                            skip = 4;
+                            break;
+                        case 0xCB:
+                            skip = 8;
+                            break;
+                        case 0xCC:
+                        case 0xCD:
+                        case 0xCE:
+                        case 0xCF:
+                            skip = (1 << (header - 0xCC));
+                            break;
+                        case 0xD0:
+                        case 0xD1:
+                        case 0xD2:
+                        case 0xD3:
+                            skip = (1 << (header - 0xD0));
+                            break;
+                        case 0xD4:
+                        case 0xD5:
+                        case 0xD6:
+                        case 0xD7:
+                        case 0xD8:
+                            skip = 1 + (1 << (header - 0xD4));
+                            break;
+                        case 0xD9:
+                        case 0xDA:
+                        case 0xDB:
+                            sized = (1 << (header - 0xD9));
+                            break;
+                        case 0xDC:
+                        case 0xDD:
+                            sized = (header == 0xDC ? 2 : 4);
+                            entries = 1;
+                            break;
+                        case 0xDE:
+                        case 0xDF:
+                            sized = (header == 0xDE ? 2 : 4);
+                            entries = 2;
+                            break;
+                        default:
+                            valid = false;
+                            break;
+                        }
+                    }
+
+                    if (sized != 0) {
+                        if ((length - index) < sized) {
+                            complete = false;
+                        } else {
+                            uint64_t size = 0;
+
+                            for (uint8_t count = 0; count < sized; count++) {
+                                size = (size << 8) | stream[index++];
+                            }
+
+                            if (entries != 0) {
+                                pending += (entries * size);
+                            } else {
+                                skip += size;
+                            }
+                        }
+                    }
+
+                    if ((length - index) < skip) {
+                        complete = false;
+                    } else {
+                        index += static_cast<uint32_t>(skip);
+                    }
+                }
+            }
+
+            return (valid == false ? static_cast<uint32_t>(~0) : (complete == false ? 0 : index));
+        }
     }
 }
 
@@ -20,6 +20,7 @@
 #ifndef __JSON_H
 #define __JSON_H
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -427,6 +428,14 @@ namespace Core {
                 return (Core::JSON::IMessagePack::FromFile(fileObject, *this));
             }
 
+            // Transcoding between JSON text and MessagePack, for elements that only exist as text (e.g.
+            // the parameters of a JSON-RPC message) but have to go over a MessagePack wire.
+            // Length returns the size of the first complete value in the stream, 0 if it is not
+            // complete yet and ~0 if it is not valid MessagePack.
+            static bool FromText(const string& text, std::vector<uint8_t>& stream);
+            static bool ToText(const uint8_t stream[], const uint32_t length, string& text);
+            static uint32_t Length(const uint8_t stream[], const uint32_t length);
+
             // JSON Serialization interface
             // --------------------------------------------------------------------------------
             virtual void Clear() = 0;
@@ -1758,12 +1767,15 @@ namespace Core {
 
                     while ((result < maxLength) && (length > 0)) {
                         const uint16_t current = static_cast<uint16_t>((_value[offset - 1]) & 0xFF);
-
-                        // See if this is a printable character
-                        if ((isQuoted == false) || ((::isprint(current)) && (current != '\"') && (current != '\\') && (current != '/')) ) {
-                            stream[result++] = static_cast<TCHAR>(current);
-                            length--;
-                            offset++;
+                        const uint16_t room = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxLength - result), length));
+                        const uint16_t plain = (isQuoted == false ? room : Printable(&(_value[offset - 1]), room));
+
+                        // Copy the run of printable characters in one go
+                        if (plain > 0) {
+                            ::memcpy(&(stream[result]), &(_value[offset - 1]), plain);
+                            result += plain;
+                            length -= plain;
+                            offset += plain;
                         }
                         else if ((_flagsAndCounters & SpecialSequenceBit) == 0) {
                             // We need to escape these..
@@ -1923,8 +1935,12 @@ namespace Core {
 
                         if (finished == false) {
                             if ((_flagsAndCounters & QuotedAreaBit) != 0) {
-                                // Write the amount we possibly can..
-                                _value += current;
+                                // Write the amount we possibly can, up to the next quote or backslash it goes as is..
+                                const uint16_t plain = std::max(Verbatim(&(stream[result]), maxLength - result), static_cast<uint16_t>(1));
+
+                                _value.append(&(stream[result]), plain);
+                                result += (plain - 1);
+                                current = stream[result];
                             }
                             else if (::isspace(current) == false) {
                                 // If we are creating an opaque string, drop all whitespaces if possible.
@@ -1949,17 +1965,22 @@ namespace Core {
                     // Since it is a "real" string translate back all escaped stuff.. are we in an unescaping mode?
                     else if ((_flagsAndCounters & SpecialSequenceBit) == 0x00) {
                         // Nope we are not, so see if we need to start it and otherwise, just copy...
-                        if (current == '\\') {
+                        const uint16_t plain = Verbatim(&(stream[result]), maxLength - result);
+
+                        if (plain > 0) {
+                            // Copy the run up to the next quote, backslash or control character in one go.
+                            _value.append(&(stream[result]), plain);
+                            result += (plain - 1);
+                        } else if (current == '\\') {
                             // And we need to start it.
                             _flagsAndCounters |= SpecialSequenceBit;
                         } else if (current == '\"') {
                             // We are done! leave this element.
                             finished = true;
-                        } else if (static_cast<std::make_unsigned<TCHAR>::type>(current) <= 0x1F) {
-                            error = Error{ "Unescaped control character detected" };
                         } else {
-                            // Just copy and onto the next;
-                            _value += current;
+                            // Nothing else stops the copying.
+                            ASSERT(static_cast<std::make_unsigned<TCHAR>::type>(current) <= 0x1F);
+                            error = Error{ "Unescaped control character detected" };
                         }
                         result++;
                     }
@@ -2159,6 +2180,11 @@ namespace Core {
                 return (succcesfull);
             }
 
+            // Number of leading characters that go into the value as they are, up to the first quote,
+            // backslash or control character. Scanned a vector at a time if the CPU allows.
+            static uint16_t Verbatim(const char stream[], const uint16_t length);
+            // Number of leading characters that can be written without escaping them.
+            static uint16_t Printable(const char stream[], const uint16_t length);
 
         private:
             std::string _default;
@@ -2778,11 +2804,182 @@ namespace Core {
             static constexpr uint16_t SKIP_AFTER = 4;
             static constexpr uint16_t PARSE = 5;
 
+            // The elements are constructed in chunks of raw storage, so adding one never moves the
+            // ones already there: references to elements and iterators stay valid. Next to the
+            // chunks an index with the address of every element gives constant time access.
+            // Clearing keeps the chunks, so a reused array does not allocate them again.
+            template <typename ARRAYELEMENT>
+            class StorageType {
+            private:
+                static constexpr uint32_t MinimumChunk = 4;
+                static constexpr uint32_t MaximumChunk = 1024;
+
+                struct Chunk {
+                    ARRAYELEMENT* Data;
+                    uint32_t Capacity;
+                    uint32_t Used;
+                };
+
+            public:
+                StorageType()
+                    : _elements()
+                    , _chunks()
+                    , _current(0)
+                {
+                }
+                StorageType(StorageType<ARRAYELEMENT>&& move) noexcept
+                    : _elements(std::move(move._elements))
+                    , _chunks(std::move(move._chunks))
+                    , _current(move._current)
+                {
+                    move._elements.clear();
+                    move._chunks.clear();
+                    move._current = 0;
+                }
+                StorageType(const StorageType<ARRAYELEMENT>& copy)
+                    : _elements()
+                    , _chunks()
+                    , _current(0)
+                {
+                    Reserve(copy.Count());
+
+                    for (const ARRAYELEMENT* element : copy._elements) {
+                        Add(*element);
+                    }
+                }
+                ~StorageType()
+                {
+                    Clear();
+
+                    for (Chunk& chunk : _chunks) {
+                        ::operator delete(chunk.Data);
+                    }
+                }
+
+                StorageType<ARRAYELEMENT>& operator=(StorageType<ARRAYELEMENT>&& move) noexcept
+                {
+                    if (this != &move) {
+                        Clear();
+
+                        for (Chunk& chunk : _chunks) {
+                            ::operator delete(chunk.Data);
+                        }
+
+                        _elements = std::move(move._elements);
+                        _chunks = std::move(move._chunks);
+                        _current = move._current;
+
+                        move._elements.clear();
+                        move._chunks.clear();
+                        move._current = 0;
+                    }
+
+                    return (*this);
+                }
+                StorageType<ARRAYELEMENT>& operator=(const StorageType<ARRAYELEMENT>& RHS)
+                {
+                    if (this != &RHS) {
+                        Clear();
+                        Reserve(RHS.Count());
+
+                        for (const ARRAYELEMENT* element : RHS._elements) {
+                            Add(*element);
+                        }
+                    }
+
+                    return (*this);
+                }
+
+            public:
+                inline uint32_t Count() const
+                {
+                    return (static_cast<uint32_t>(_elements.size()));
+                }
+                inline ARRAYELEMENT& operator[](const uint32_t index)
+                {
+                    ASSERT(index < _elements.size());
+
+                    return (*(_elements[index]));
+                }
+                inline const ARRAYELEMENT& operator[](const uint32_t index) const
+                {
+                    ASSERT(index < _elements.size());
+
+                    return (*(_elements[index]));
+                }
+                inline ARRAYELEMENT& Last()
+                {
+                    ASSERT(_elements.empty() == false);
+
+                    return (*(_elements.back()));
+                }
+                void Reserve(const uint32_t count)
+                {
+                    uint32_t available = 0;
+
+                    for (uint32_t index = _current; index < _chunks.size(); index++) {
+                        available += (_chunks[index].Capacity - _chunks[index].Used);
+                    }
+
+                    if (count > (_elements.size() + available)) {
+                        Allocate(static_cast<uint32_t>(count - _elements.size() - available));
+                    }
+
+                    _elements.reserve(count);
+                }
+                template <typename... Args>
+                ARRAYELEMENT& Add(Args&&... args)
+                {
+                    while ((_current < _chunks.size()) && (_chunks[_current].Used == _chunks[_current].Capacity)) {
+                        _current++;
+                    }
+
+                    if (_current == _chunks.size()) {
+                        // Grow with what is there already, so the number of chunks stays small.
+                        const uint32_t count = static_cast<uint32_t>(_elements.size());
+
+                        Allocate(count < MinimumChunk ? MinimumChunk : (count > MaximumChunk ? MaximumChunk : count));
+                    }
+
+                    Chunk& chunk(_chunks[_current]);
+                    ARRAYELEMENT* element = new (&(chunk.Data[chunk.Used])) ARRAYELEMENT(std::forward<Args>(args)...);
+
+                    chunk.Used++;
+                    _elements.push_back(element);
+
+                    return (*element);
+                }
+                void Clear()
+                {
+                    for (ARRAYELEMENT* element : _elements) {
+                        element->~ARRAYELEMENT();
+                    }
+
+                    for (Chunk& chunk : _chunks) {
+                        chunk.Used = 0;
+                    }
+
+                    _elements.clear();
+                    _current = 0;
+                }
+
+            private:
+                void Allocate(const uint32_t capacity)
+                {
+                    _chunks.push_back({ static_cast<ARRAYELEMENT*>(::operator new(capacity * sizeof(ARRAYELEMENT))), capacity, 0 });
+                }
+
+            private:
+                std::vector<ARRAYELEMENT*> _elements;
+                std::vector<Chunk> _chunks;
+                uint32_t _current;
+            };
+
         public:
             template <typename ARRAYELEMENT>
             class ConstIteratorType {
             private:
-                typedef std::list<ARRAYELEMENT> ArrayContainer;
+                typedef StorageType<ARRAYELEMENT> ArrayContainer;
                 enum State {
                     AT_BEGINNING,
                     AT_ELEMENT,
@@ -2792,28 +2989,28 @@ namespace Core {
             public:
                 ConstIteratorType()
                     : _container(nullptr)
-                    , _iterator()
+                    , _index(0)
                     , _state(AT_BEGINNING)
                 {
                 }
 
                 ConstIteratorType(const ArrayContainer& container)
                     : _container(&container)
-                    , _iterator(_container->begin())
+                    , _index(0)
                     , _state(AT_BEGINNING)
                 {
                 }
 
                 ConstIteratorType(ConstIteratorType<ARRAYELEMENT>&& move)
                     : _container(std::move(move._container))
-                    , _iterator(std::move(move._iterator))
+                    , _index(std::move(move._index))
                     , _state(std::move(move._state))
                 {
                 }
 
                 ConstIteratorType(const ConstIteratorType<ARRAYELEMENT>& copy)
                     : _container(copy._container)
-                    , _iterator(copy._iterator)
+                    , _index(copy._index)
                     , _state(copy._state)
                 {
                 }
@@ -2823,7 +3020,7 @@ namespace Core {
                 ConstIteratorType<ARRAYELEMENT>& operator=(ConstIteratorType<ARRAYELEMENT>&& move)
                 {
                     _container = std::move(move._container);
-                    _iterator = std::move(move._iterator);
+                    _index = std::move(move._index);
                     _state = std::move(move._state);
 
                     return (*this);
@@ -2832,7 +3029,7 @@ namespace Core {
                 ConstIteratorType<ARRAYELEMENT>& operator=(const ConstIteratorType<ARRAYELEMENT>& RHS)
                 {
                     _container = RHS._container;
-                    _iterator = RHS._iterator;
+                    _index = RHS._index;
                     _state = RHS._state;
 
                     return (*this);
@@ -2847,25 +3044,24 @@ namespace Core {
                 inline bool Reset(const uint32_t index = ~0)
                 {
                     _state = AT_BEGINNING;
+                    _index = 0;
 
                     if (_container != nullptr) {
-                        _iterator = _container->begin();
-
                         if (index != static_cast<uint32_t>(~0)) {
                             uint32_t position = (index + 1);
                             while (position > 0) {
-                                while ((_iterator != _container->end()) && (_iterator->IsSet() == false)) {
-                                    _iterator++;
+                                while ((_index < _container->Count()) && ((*_container)[_index].IsSet() == false)) {
+                                    _index++;
                                 }
 
-                                if (_iterator == _container->end()) {
+                                if (_index == _container->Count()) {
                                     position = 0;
                                 }
                                 else if (--position != 0) {
-                                    _iterator++;
+                                    _index++;
                                 }
                             }
-                            _state = (_iterator != _container->end() ? AT_ELEMENT : AT_END);
+                            _state = (_index < _container->Count() ? AT_ELEMENT : AT_END);
                         }
                     }
 
@@ -2877,14 +3073,14 @@ namespace Core {
                     if (_container != nullptr) {
                         if (_state != AT_END) {
                             if (_state != AT_BEGINNING) {
-                                _iterator++;
+                                _index++;
                             }
 
-                            while ((_iterator != _container->end()) && (_iterator->IsSet() == false)) {
-                                _iterator++;
+                            while ((_index < _container->Count()) && ((*_container)[_index].IsSet() == false)) {
+                                _index++;
                             }
 
-                            _state = (_iterator != _container->end() ? AT_ELEMENT : AT_END);
+                            _state = (_index < _container->Count() ? AT_ELEMENT : AT_END);
                         }
                     } else {
                         _state = AT_END;
@@ -2896,24 +3092,24 @@ namespace Core {
                 {
                     ASSERT(_state == AT_ELEMENT);
 
-                    return (*_iterator);
+                    return ((*_container)[_index]);
                 }
 
                 inline uint32_t Count() const
                 {
-                    return (_container == nullptr ? 0 : static_cast<uint32_t>(_container->size()));
+                    return (_container == nullptr ? 0 : _container->Count());
                 }
 
             private:
                 const ArrayContainer* _container;
-                typename ArrayContainer::const_iterator _iterator;
+                uint32_t _index;
                 State _state;
             };
 
             template <typename ARRAYELEMENT>
             class IteratorType {
             private:
-                typedef std::list<ARRAYELEMENT> ArrayContainer;
+                typedef StorageType<ARRAYELEMENT> ArrayContainer;
                 enum State {
                     AT_BEGINNING,
                     AT_ELEMENT,
@@ -2923,28 +3119,28 @@ namespace Core {
             public:
                 IteratorType()
                     : _container(nullptr)
-                    , _iterator()
+                    , _index(0)
                     , _state(AT_BEGINNING)
                 {
                 }
 
                 IteratorType(ArrayContainer& container)
                     : _container(&container)
-                    , _iterator(container.begin())
+                    , _index(0)
                     , _state(AT_BEGINNING)
                 {
                 }
 
                 IteratorType(IteratorType<ARRAYELEMENT>&& move) noexcept
                     : _container(std::move(move._container))
-                    , _iterator(std::move(move._iterator))
+                    , _index(std::move(move._index))
                     , _state(std::move(move._state))
                 {
                 }
 
                 IteratorType(const IteratorType<ARRAYELEMENT>& copy)
                     : _container(copy._container)
-                    , _iterator(copy._iterator)
+                    , _index(copy._index)
                     , _state(copy._state)
                 {
                 }
@@ -2954,7 +3150,7 @@ namespace Core {
                 IteratorType<ARRAYELEMENT>& operator=(IteratorType<ARRAYELEMENT>&& move) noexcept
                 {
                     _container = std::move(move._container);
-                    _iterator = std::move(move._iterator);
+                    _index = std::move(move._index);
                     _state = std::move(move._state);
 
                     return (*this);
@@ -2963,7 +3159,7 @@ namespace Core {
                 IteratorType<ARRAYELEMENT>& operator=(const IteratorType<ARRAYELEMENT>& RHS)
                 {
                     _container = RHS._container;
-                    _iterator = RHS._iterator;
+                    _index = RHS._index;
                     _state = RHS._state;
 
                     return (*this);
@@ -2978,24 +3174,24 @@ namespace Core {
                 bool Reset(const uint32_t index = ~0)
                 {
                     _state = AT_BEGINNING;
+                    _index = 0;
 
                     if (_container != nullptr) {
-                        _iterator = _container->begin();
                         if (index != static_cast<uint32_t>(~0)) {
                             uint32_t position = (index + 1);
                             while (position > 0) {
-                                while ((_iterator != _container->end()) && (_iterator->IsSet() == false)) {
-                                    _iterator++;
+                                while ((_index < _container->Count()) && ((*_container)[_index].IsSet() == false)) {
+                                    _index++;
                                 }
 
-                                if (_iterator == _container->end()) {
+                                if (_index == _container->Count()) {
                                     position = 0;
                                 }
                                 else if (--position != 0) {
-                                    _iterator++;
+                                    _index++;
                                 }
                             }
-                            _state = (_iterator != _container->end() ? AT_ELEMENT : AT_END);
+                            _state = (_index < _container->Count() ? AT_ELEMENT : AT_END);
                         }
                     }
 
@@ -3007,14 +3203,14 @@ namespace Core {
                     if (_container != nullptr) {
                         if (_state != AT_END) {
                             if (_state != AT_BEGINNING) {
-                                _iterator++;
+                                _index++;
                             }
 
-                            while ((_iterator != _container->end()) && (_iterator->IsSet() == false)) {
-                                _iterator++;
+                            while ((_index < _container->Count()) && ((*_container)[_index].IsSet() == false)) {
+                                _index++;
                             }
 
-                            _state = (_iterator != _container->end() ? AT_ELEMENT : AT_END);
+                            _state = (_index < _container->Count() ? AT_ELEMENT : AT_END);
                         }
                     } else {
                         _state = AT_END;
@@ -3026,24 +3222,24 @@ namespace Core {
                 {
                     ASSERT(_state == AT_ELEMENT);
 
-                    return (&(*_iterator));
+                    return (&((*_container)[_index]));
                 }
 
                 ARRAYELEMENT& Current()
                 {
                     ASSERT(_state == AT_ELEMENT);
 
-                    return (*_iterator);
+                    return ((*_container)[_index]);
                 }
 
                 inline uint32_t Count() const
                 {
-                    return (_container == nullptr ? 0 : static_cast<uint32_t>(_container->size()));
+                    return (_container == nullptr ? 0 : _container->Count());
                 }
 
             private:
                 ArrayContainer* _container;
-                typename ArrayContainer::iterator _iterator;
+                uint32_t _index;
                 State _state;
             };
 
@@ -3063,7 +3259,7 @@ namespace Core {
                 : _state(std::move(move._state))
                 , _count(std::move(move._count))
                 , _data(std::move(move._data))
-                , _iterator(std::move(move._iterator))
+                , _iterator(_data)
             {
             }
 
@@ -3138,60 +3334,42 @@ namespace Core {
             void Clear() override
             {
                 _state = 0;
-                _data.clear();
+                _data.Clear();
             }
 
             inline uint16_t Length() const
             {
-                return static_cast<uint16_t>(_data.size());
+                return static_cast<uint16_t>(_data.Count());
             }
 
-            inline ELEMENT& Add()
+            // Makes room for the given number of elements, so adding them does not allocate on the way.
+            inline void Reserve(const uint16_t count)
             {
-                _data.push_back(ELEMENT());
+                _data.Reserve(count);
+            }
 
-                return (_data.back());
+            inline ELEMENT& Add()
+            {
+                return (_data.Add());
             }
 
             inline ELEMENT& Add(const ELEMENT& element)
             {
-                _data.push_back(element);
-
-                return (_data.back());
+                return (_data.Add(element));
             }
 
             ELEMENT& operator[](const uint32_t index)
             {
-                uint32_t skip = index;
                 ASSERT(index < Length());
 
-                typename std::list<ELEMENT>::iterator locator = _data.begin();
-
-                while (skip != 0) {
-                    locator++;
-                    skip--;
-                }
-
-                ASSERT(locator != _data.end());
-
-                return (*locator);
+                return (_data[index]);
             }
 
             const ELEMENT& operator[](const uint32_t index) const
             {
-                uint32_t skip = index;
                 ASSERT(index < Length());
 
-                typename std::list<ELEMENT>::const_iterator locator = _data.begin();
-
-                while (skip != 0) {
-                    locator++;
-                    skip--;
-                }
-
-                ASSERT(locator != _data.end());
-
-                return (*locator);
+                return (_data[index]);
             }
 
             const ELEMENT& Get(const uint32_t index) const
@@ -3249,7 +3427,9 @@ namespace Core {
                 using T = typename std::underlying_type<ENUM>::type;
                 T value{};
 
-                for (const EnumType<ENUM>& item : _data) {
+                for (uint32_t index = 0; index < _data.Count(); index++) {
+                    const EnumType<ENUM>& item(_data[index]);
+
                     if (item.IsSet() == true) {
                         const T& element = static_cast<const T>(item.Value());
                         ASSERT((element == 0) || ((element & (element - 1)) == 0));
@@ -3268,7 +3448,7 @@ namespace Core {
 
                 if (offset == FIND_MARKER) {
                     _iterator.Reset();
-                    if (((_state & modus::EXTRACT) == 0) || (_data.size() != 1)) {
+                    if (((_state & modus::EXTRACT) == 0) || (_data.Count() != 1)) {
                         stream[loaded++] = '[';
                     }
                     offset = (_iterator.Next() == false ? ~0 : PARSE);
@@ -3287,7 +3467,7 @@ namespace Core {
                 }
                 if (offset == static_cast<uint32_t>(~0)) {
                     if (loaded < maxLength) {
-                        if (((_state & modus::EXTRACT) == 0) || (_data.size() != 1)) {
+                        if (((_state & modus::EXTRACT) == 0) || (_data.Count() != 1)) {
                             stream[loaded++] = ']';
                         }
                         offset = FIND_MARKER;
@@ -3363,7 +3543,7 @@ namespace Core {
                                     ++loaded;
                                 } else {
                                     offset = PARSE;
-                                    _data.push_back(ELEMENT());
+                                    _data.Add();
                                 }
                                 break;
                             }
@@ -3372,7 +3552,7 @@ namespace Core {
 
                     if (offset >= PARSE) {
                         offset = (offset - PARSE);
-                        loaded += static_cast<IElement&>(_data.back()).Deserialize(&(stream[loaded]), maxLength - loaded, offset, error);
+                        loaded += static_cast<IElement&>(_data.Last()).Deserialize(&(stream[loaded]), maxLength - loaded, offset, error);
                         offset = (offset == FIND_MARKER ? SKIP_AFTER : offset + PARSE);
                     }
 
@@ -3390,9 +3570,9 @@ namespace Core {
 
                 if (offset == 0) {
                     _iterator.Reset();
-                    if (_data.size() <= 15) {
-                        stream[loaded++] = (0x90 | static_cast<uint8_t>(_data.size()));
-                        if (_data.size() > 0) {
+                    if (_data.Count() <= 15) {
+                        stream[loaded++] = (0x90 | static_cast<uint8_t>(_data.Count()));
+                        if (_data.Count() > 0) {
                             offset = PARSE;
                         }
                     } else {
@@ -3403,10 +3583,10 @@ namespace Core {
                 }
                 while ((loaded < maxLength) && (offset > 0) && (offset < PARSE)) {
                     if (offset == 1) {
-                        stream[loaded++] = (_data.size() >> 8) & 0xFF;
+                        stream[loaded++] = (_data.Count() >> 8) & 0xFF;
                         offset = 2;
                     } else if (offset == 2) {
-                        stream[loaded++] = _data.size() & 0xFF;
+                        stream[loaded++] = _data.Count() & 0xFF;
                         offset = PARSE;
                     }
                 }
@@ -3453,14 +3633,14 @@ namespace Core {
                     if (offset == PARSE) {
                         if (_count > 0) {
                             _count--;
-                            _data.emplace_back(ELEMENT());
+                            _data.Add();
                         } else {
                             offset = 0;
                         }
                     }
                     if (offset >= PARSE) {
                         offset -= PARSE;
-                        loaded += static_cast<IMessagePack&>(_data.back()).Deserialize(stream, maxLength, offset);
+                        loaded += static_cast<IMessagePack&>(_data.Last()).Deserialize(stream, maxLength, offset);
                         offset += PARSE;
                     }
                 }
@@ -3471,7 +3651,7 @@ namespace Core {
         private:
             uint8_t _state;
             uint16_t _count;
-            std::list<ELEMENT> _data;
+            StorageType<ELEMENT> _data;
             mutable IteratorType<ELEMENT> _iterator;
         };
 
@@ -3494,6 +3674,10 @@ namespace Core {
 
             typedef std::pair<const TCHAR*, IElement*> JSONLabelValue;
             typedef std::list<JSONLabelValue> JSONElementList;
+            typedef std::pair<uint32_t, JSONElementList::iterator> JSONLabelIndex;
+
+            // Containers with more members than this get a hash index for the label lookup.
+            static constexpr uint8_t INDEX_THRESHOLD = 8;
 
             class Iterator {
             private:
@@ -3572,6 +3756,7 @@ namespace Core {
                 : _state(0)
                 , _count(0)
                 , _data()
+                , _index()
                 , _iterator()
                 , _fieldName(true)
             {
@@ -3627,6 +3812,13 @@ namespace Core {
             void Add(const TCHAR label[], IElement* element)
             {
                 _data.push_back(JSONLabelValue(label, element));
+
+                if (_index.empty() == false) {
+                    JSONLabelIndex entry(Hash(label), std::prev(_data.end()));
+
+                    // Keep the index sorted, with equal labels in the order they were added.
+                    _index.insert(std::upper_bound(_index.begin(), _index.end(), entry, LessHash), entry);
+                }
             }
 
             void Remove(const TCHAR label[])
@@ -3638,6 +3830,16 @@ namespace Core {
                 }
 
                 if (index != _data.end()) {
+                    if (_index.empty() == false) {
+                        std::vector<JSONLabelIndex>::iterator entry(_index.begin());
+
+                        while (entry->second != index) {
+                            entry++;
+                        }
+
+                        _index.erase(entry);
+                    }
+
                     _data.erase(index);
                 }
             }
@@ -3980,16 +4182,35 @@ namespace Core {
             void Reset()
             {
                 _data.clear();
+                _index.clear();
             }
 
             IElement* Find(const char label[])
             {
                 IElement* result = nullptr;
 
-                JSONElementList::iterator index = _data.begin();
+                JSONElementList::iterator index = _data.end();
 
-                while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
-                    index++;
+                if (_data.size() > INDEX_THRESHOLD) {
+                    if (_index.empty() == true) {
+                        BuildIndex();
+                    }
+
+                    JSONLabelIndex entry(Hash(label), _data.end());
+                    std::vector<JSONLabelIndex>::const_iterator loop(std::lower_bound(_index.begin(), _index.end(), entry, LessHash));
+
+                    while ((loop != _index.end()) && (loop->first == entry.first) && (index == _data.end())) {
+                        if (strcmp(label, loop->second->first) == 0) {
+                            index = loop->second;
+                        }
+                        loop++;
+                    }
+                } else {
+                    index = _data.begin();
+
+                    while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
+                        index++;
+                    }
                 }
 
                 if (index != _data.end()) {
@@ -4037,6 +4258,39 @@ namespace Core {
                 return (false);
             }
 
+        private:
+            static uint32_t Hash(const TCHAR label[])
+            {
+                // FNV-1a
+                uint32_t result = 0x811C9DC5;
+
+                while (*label != '\0') {
+                    result = (result ^ static_cast<uint8_t>(*label)) * 0x01000193;
+                    label++;
+                }
+
+                return (result);
+            }
+            static bool LessHash(const JSONLabelIndex& lhs, const JSONLabelIndex& rhs)
+            {
+                return (lhs.first < rhs.first);
+            }
+            void BuildIndex()
+            {
+                _index.reserve(_data.size());
+
+                for (JSONElementList::iterator index = _data.begin(); index != _data.end(); index++) {
+                    JSONLabelIndex entry(Hash(index->first), index);
+                    std::vector<JSONLabelIndex>::iterator position(_index.end());
+
+                    // Insertion sort, the lists are short and equal labels keep their order.
+                    while ((position != _index.begin()) && (entry.first < std::prev(position)->first)) {
+                        position--;
+                    }
+                    _index.insert(position, entry);
+                }
+            }
+
         private:
             uint8_t _state;
             uint16_t _count;
@@ -4045,6 +4299,7 @@ namespace Core {
                 mutable IMessagePack* pack;
             } _current;
             JSONElementList _data;
+            std::vector<JSONLabelIndex> _index;
             mutable JSONElementList::const_iterator _iterator;
             mutable String _fieldName;
         };
@@ -34,6 +34,86 @@ namespace Core {
     namespace JSONRPC {
 
         class EXTERNAL Message : public Core::JSON::Container {
+        public:
+            // The result of a call, as JSON text, or as the object a typed handler returned. The
+            // latter is serialized straight into the message, it is never turned into text first.
+            class Outcome : public Core::JSON::String {
+            public:
+                Outcome()
+                    : Core::JSON::String(false)
+                    , _object()
+                {
+                }
+                Outcome(const Outcome& copy)
+                    : Core::JSON::String(copy)
+                    , _object(copy._object)
+                {
+                }
+                Outcome(Outcome&& move) noexcept
+                    : Core::JSON::String(std::move(move))
+                    , _object(std::move(move._object))
+                {
+                }
+                ~Outcome() override = default;
+
+                Outcome& operator=(const Outcome& RHS)
+                {
+                    Core::JSON::String::operator=(RHS);
+                    _object = RHS._object;
+                    return (*this);
+                }
+                Outcome& operator=(const string& RHS)
+                {
+                    if (_object.IsValid() == true) {
+                        _object.Release();
+                    }
+                    Core::JSON::String::operator=(RHS);
+                    return (*this);
+                }
+
+            public:
+                void Object(const Core::ProxyType<const Core::JSON::IElement>& object)
+                {
+                    Core::JSON::String::Clear();
+                    _object = object;
+                }
+                const string Value() const
+                {
+                    string result;
+
+                    if (_object.IsValid() == false) {
+                        result = Core::JSON::String::Value();
+                    }
+                    else {
+                        _object->ToString(result);
+                    }
+
+                    return (result);
+                }
+                void Clear() override
+                {
+                    if (_object.IsValid() == true) {
+                        _object.Release();
+                    }
+                    Core::JSON::String::Clear();
+                }
+                bool IsSet() const override
+                {
+                    return ((_object.IsValid() == true) || (Core::JSON::String::IsSet() == true));
+                }
+                bool IsNull() const override
+                {
+                    return ((_object.IsValid() == false) && (Core::JSON::String::IsNull() == true));
+                }
+                uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
+                {
+                    return (_object.IsValid() == true ? _object->Serialize(stream, maxLength, offset) : Core::JSON::String::Serialize(stream, maxLength, offset));
+                }
+
+            private:
+                Core::ProxyType<const Core::JSON::IElement> _object;
+            };
+
         public:
             // Arbitrary code base selected in discussion with the team to use 
             // this magical value as a base for Thunder error codes (0..999).
@@ -187,9 +267,10 @@ namespace Core {
                 , Id(~0)
                 , Designator()
                 , Parameters(false)
-                , Result(false)
+                , Result()
                 , Error()
                 , _implicitCallsign()
+                , _packed()
             {
                 Add(_T("jsonrpc"), &JSONRPC);
                 Add(_T("id"), &Id);
@@ -209,6 +290,7 @@ namespace Core {
                 , Result(copy.Result)
                 , Error(copy.Error)
                 , _implicitCallsign(copy._implicitCallsign)
+                , _packed()
             {
                 Add(_T("jsonrpc"), &JSONRPC);
                 Add(_T("id"), &Id);
@@ -227,6 +309,7 @@ namespace Core {
                 , Result(std::move(move.Result))
                 , Error(std::move(move.Error))
                 , _implicitCallsign(std::move(move._implicitCallsign))
+                , _packed()
             {
                 Add(_T("jsonrpc"), &JSONRPC);
                 Add(_T("id"), &Id);
@@ -413,15 +496,80 @@ namespace Core {
                 _implicitCallsign = implicitCallsign;
             }
 
+            // IMessagePack iface:
+            // The parameters and the result are kept as JSON text, so on a MessagePack wire the message
+            // is transcoded as a whole. That way they go out as MessagePack values too.
+            using Core::JSON::Container::Serialize;
+            using Core::JSON::Container::Deserialize;
+
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, uint32_t& offset) const override
+            {
+                if (offset == 0) {
+                    string text;
+
+                    _packed.clear();
+                    static_cast<const Core::JSON::IElement&>(*this).ToString(text);
+                    Core::JSON::IMessagePack::FromText(text, _packed);
+                }
+
+                const uint16_t loaded = static_cast<uint16_t>(std::min(static_cast<size_t>(maxLength), _packed.size() - offset));
+
+                if (loaded > 0) {
+                    ::memcpy(stream, &(_packed[offset]), loaded);
+                    offset += loaded;
+                }
+                if (offset >= _packed.size()) {
+                    _packed.clear();
+                    offset = 0;
+                }
+
+                return (loaded);
+            }
+            uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, uint32_t& offset) override
+            {
+                uint16_t loaded = maxLength;
+
+                if (offset == 0) {
+                    _packed.clear();
+                }
+
+                const size_t received = _packed.size();
+
+                _packed.insert(_packed.end(), stream, stream + maxLength);
+
+                const uint32_t length = Core::JSON::IMessagePack::Length(_packed.data(), static_cast<uint32_t>(_packed.size()));
+
+                if (length == 0) {
+                    // Not complete yet, keep what we have.
+                    offset = static_cast<uint32_t>(_packed.size());
+                } else {
+                    string text;
+
+                    // What is not valid MessagePack, leaves an empty message.
+                    if (length != static_cast<uint32_t>(~0)) {
+                        loaded = static_cast<uint16_t>(length - received);
+                        Core::JSON::IMessagePack::ToText(_packed.data(), length, text);
+                    }
+
+                    static_cast<Core::JSON::IElement&>(*this).FromString(text);
+
+                    _packed.clear();
+                    offset = 0;
+                }
+
+                return (loaded);
+            }
+
             Core::JSON::String JSONRPC;
             Core::JSON::DecUInt32 Id;
             Core::JSON::String Designator;
             Core::JSON::String Parameters;
-            Core::JSON::String Result;
+            Outcome Result;
             Info Error;
 
         private:
             string _implicitCallsign;
+            mutable std::vector<uint8_t> _packed;
         };
 
         class EXTERNAL Context {
@@ -431,22 +579,34 @@ namespace Core {
             Context() 
                 : _channelId(~0)
                 , _sequence(~0)
-                , _token() {
+                , _token()
+                , _result(nullptr) {
             }
             Context(const Context& copy) 
                 : _channelId(copy._channelId)
                 , _sequence(copy._sequence)
-                , _token(copy._token) {
+                , _token(copy._token)
+                , _result(nullptr) {
             }
             Context(Context&& move)
                 : _channelId(move._channelId)
                 , _sequence(move._sequence)
-                , _token(std::move(move._token)) {
+                , _token(std::move(move._token))
+                , _result(nullptr) {
             }
             Context(const uint32_t channelId, const uint32_t sequence, const string& token)
                 : _channelId(channelId)
                 , _sequence(sequence)
-                , _token(token) {
+                , _token(token)
+                , _result(nullptr) {
+            }
+            // The caller takes the result object of a typed handler as is, copies of the context
+            // (e.g. kept for an asynchronous response) do not.
+            Context(const uint32_t channelId, const uint32_t sequence, const string& token, Core::ProxyType<const Core::JSON::IElement>& result)
+                : _channelId(channelId)
+                , _sequence(sequence)
+                , _token(token)
+                , _result(&result) {
             }
             ~Context() = default;
 
@@ -462,11 +622,19 @@ namespace Core {
             const string& Token() const {
                 return (_token);
             }
+            bool HasResult() const {
+                return (_result != nullptr);
+            }
+            void Result(const Core::ProxyType<const Core::JSON::IElement>& result) const {
+                ASSERT(_result != nullptr);
+                (*_result) = result;
+            }
 
         private:
             const uint32_t _channelId;
             const uint32_t _sequence;
             const string _token;
+            Core::ProxyType<const Core::JSON::IElement>* _result;
         };
 
         typedef std::function<void(const Context& context, const string& parameters, Core::OptionalType<Core::JSON::Error>&)> CallbackFunction;
@@ -1047,15 +1215,15 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD> // outbound
             void InternalRegister(const ::TemplateIntToType<0>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                Register(methodName, [method](const Core::JSONRPC::Context&, const string&, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND, METHOD>(result, method));
+                Register(methodName, [method](const Context& context, const string&, const string&, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<OUTBOUND, METHOD>(context, result, method));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD> // inbound+outbound
             void InternalRegister(const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                Register(methodName, [method](const Core::JSONRPC::Context&, const string&, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(parameters, result, method, int()));
+                Register(methodName, [method](const Context& context, const string&, const string& parameters, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(context, parameters, result, method, int()));
                 });
             }
 
@@ -1078,14 +1246,14 @@ namespace Core {
             void InternalRegister(const ::TemplateIntToType<1>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
                 Register(methodName, [method](const Context& context, const string&, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND, METHOD>(result, method, context));
+                    return (InternalRegisterImpl<OUTBOUND, METHOD>(context, result, method, context));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD> // context+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
                 Register(methodName, [method](const Context& context, const string&, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(parameters, result, method, int(), context));
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(context, parameters, result, method, int(), context));
                 });
             }
 
@@ -1100,15 +1268,15 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD> // index+outbound
             void InternalRegister(const ::TemplateIntToType<2>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                Register(methodName, [method](const Context&, const string& methodName, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND, METHOD>(result, method, Message::Index(methodName)));
+                Register(methodName, [method](const Context& context, const string& methodName, const string&, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<OUTBOUND, METHOD>(context, result, method, Message::Index(methodName)));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD> /// index+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<2>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                Register(methodName, [method](const Context&, const string& methodName, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(parameters, result, method, int(), Message::Index(methodName)));
+                Register(methodName, [method](const Context& context, const string& methodName, const string& parameters, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(context, parameters, result, method, int(), Message::Index(methodName)));
                 });
             }
 
@@ -1124,14 +1292,14 @@ namespace Core {
             void InternalRegister(const ::TemplateIntToType<3>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
                 Register(methodName, [method](const Context& context, const string& methodName, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND, METHOD>(result, method, context, Message::Index(methodName)));
+                    return (InternalRegisterImpl<OUTBOUND, METHOD>(context, result, method, context, Message::Index(methodName)));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD> /// context+index+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<3>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
                 Register(methodName, [method](const Context& context, const string& methodName, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(parameters, result, method, int(), context, Message::Index(methodName)));
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(context, parameters, result, method, int(), context, Message::Index(methodName)));
                 });
             }
 
@@ -1153,15 +1321,15 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD> // id+outbound
             void InternalRegister(const ::TemplateIntToType<4>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                Register(methodName, [method](const Context&, const string& methodName, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND, METHOD>(result, method, Message::InstanceId(methodName)));
+                Register(methodName, [method](const Context& context, const string& methodName, const string&, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<OUTBOUND, METHOD>(context, result, method, Message::InstanceId(methodName)));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD> // id+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<4>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                Register(methodName, [method](const Context&, const string& methodName, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(parameters, result, method, int(), Message::InstanceId(methodName)));
+                Register(methodName, [method](const Context& context, const string& methodName, const string& parameters, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(context, parameters, result, method, int(), Message::InstanceId(methodName)));
                 });
             }
 
@@ -1176,15 +1344,15 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD> // id+index+outbound
             void InternalRegister(const ::TemplateIntToType<6>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                Register(methodName, [method](const Context&, const string& methodName, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND, METHOD>(result, method, Message::InstanceId(methodName), Message::Index(methodName)));
+                Register(methodName, [method](const Context& context, const string& methodName, const string&, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<OUTBOUND, METHOD>(context, result, method, Message::InstanceId(methodName), Message::Index(methodName)));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD> // id+index+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<6>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method)
             {
-                Register(methodName, [method](const Context&, const string& methodName, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(parameters, result, method, int(), Message::InstanceId(methodName), Message::Index(methodName)));
+                Register(methodName, [method](const Context& context, const string& methodName, const string& parameters, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND, METHOD>(context, parameters, result, method, int(), Message::InstanceId(methodName), Message::Index(methodName)));
                 });
             }
 
@@ -1206,15 +1374,15 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> // outbound
             void InternalRegister(const ::TemplateIntToType<0>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                Register(methodName, [method, objectPtr](const Core::JSONRPC::Context&, const string&, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND>(result, std::bind(method, objectPtr, std::placeholders::_1)));
+                Register(methodName, [method, objectPtr](const Context& context, const string&, const string&, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<OUTBOUND>(context, result, std::bind(method, objectPtr, std::placeholders::_1)));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> // inbound+outbound
             void InternalRegister(const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                Register(methodName, [method, objectPtr](const Core::JSONRPC::Context&, const string&, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2), int()));
+                Register(methodName, [method, objectPtr](const Context& context, const string&, const string& parameters, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(context, parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2), int()));
                 });
             }
 
@@ -1237,14 +1405,14 @@ namespace Core {
             void InternalRegister(const ::TemplateIntToType<1>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
                 Register(methodName, [method, objectPtr](const Context& context, const string&, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND>(result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2), context));
+                    return (InternalRegisterImpl<OUTBOUND>(context, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2), context));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> // context+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
                 Register(methodName, [method, objectPtr](const Context& context, const string&, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), int(), context));
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(context, parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), int(), context));
                 });
             }
 
@@ -1259,15 +1427,15 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> // index+outbound
             void InternalRegister(const ::TemplateIntToType<2>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                Register(methodName, [method, objectPtr](const Context&, const string& methodName, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND>(result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2), Message::Index(methodName)));
+                Register(methodName, [method, objectPtr](const Context& context, const string& methodName, const string&, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<OUTBOUND>(context, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2), Message::Index(methodName)));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> /// index+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<2>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                Register(methodName, [method, objectPtr](const Context&, const string& methodName, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), int(), Message::Index(methodName)));
+                Register(methodName, [method, objectPtr](const Context& context, const string& methodName, const string& parameters, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(context, parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), int(), Message::Index(methodName)));
                 });
             }
 
@@ -1283,14 +1451,14 @@ namespace Core {
             void InternalRegister(const ::TemplateIntToType<3>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
                 Register(methodName, [method, objectPtr](const Context& context, const string& methodName, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND>(result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), context, Message::Index(methodName)));
+                    return (InternalRegisterImpl<OUTBOUND>(context, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), context, Message::Index(methodName)));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> /// context+index+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<3>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
                 Register(methodName, [method, objectPtr](const Context& context, const string& methodName, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), int(), context, Message::Index(methodName)));
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(context, parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), int(), context, Message::Index(methodName)));
                 });
             }
 
@@ -1312,15 +1480,15 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> // id+outbound
             void InternalRegister(const ::TemplateIntToType<4>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                Register(methodName, [method, objectPtr](const Context&, const string& methodName, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND>(result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2), Message::InstanceId(methodName)));
+                Register(methodName, [method, objectPtr](const Context& context, const string& methodName, const string&, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<OUTBOUND>(context, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2), Message::InstanceId(methodName)));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> // id+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<4>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                Register(methodName, [method, objectPtr](const Context&, const string& methodName, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), int(), Message::InstanceId(methodName)));
+                Register(methodName, [method, objectPtr](const Context& context, const string& methodName, const string& parameters, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(context, parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), int(), Message::InstanceId(methodName)));
                 });
             }
 
@@ -1335,15 +1503,15 @@ namespace Core {
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> // id+index+outbound
             void InternalRegister(const ::TemplateIntToType<6>&, const ::TemplateIntToType<1>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                Register(methodName, [method, objectPtr](const Context&, const string& methodName, const string&, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<OUTBOUND>(result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), Message::InstanceId(methodName), Message::Index(methodName)));
+                Register(methodName, [method, objectPtr](const Context& context, const string& methodName, const string&, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<OUTBOUND>(context, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), Message::InstanceId(methodName), Message::Index(methodName)));
                 });
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename REALOBJECT> // id+index+inbound+outbound
             void InternalRegister(const ::TemplateIntToType<6>&, const ::TemplateIntToType<0>&, const ::TemplateIntToType<0>&, const string& methodName, const METHOD& method, REALOBJECT* objectPtr)
             {
-                Register(methodName, [method, objectPtr](const Context&, const string& methodName, const string& parameters, string& result) -> uint32_t {
-                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), int(), Message::InstanceId(methodName), Message::Index(methodName)));
+                Register(methodName, [method, objectPtr](const Context& context, const string& methodName, const string& parameters, string& result) -> uint32_t {
+                    return (InternalRegisterImpl<INBOUND, OUTBOUND>(context, parameters, result, std::bind(method, objectPtr, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), int(), Message::InstanceId(methodName), Message::Index(methodName)));
                 });
             }
 
@@ -1373,23 +1541,16 @@ namespace Core {
                 return(code);
             }
             template <typename INBOUND, typename OUTBOUND, typename METHOD, typename... Args>
-            static uint32_t InternalRegisterImpl(const string& parameters, string& result, const METHOD& method, int, Args&&... args)
+            static uint32_t InternalRegisterImpl(const Context& context, const string& parameters, string& result, const METHOD& method, int, Args&&... args)
             {
                 uint32_t code;
                 INBOUND inbound;
-                OUTBOUND outbound;
                 Core::OptionalType<Core::JSON::Error> report;
 
                 inbound.FromString(parameters, report);
 
                 if (report.IsSet() == false) {
-                    code = method(std::forward<Args>(args)..., inbound, outbound);
-                    if (code == Core::ERROR_NONE) {
-                        outbound.ToString(result);
-                    }
-                    else {
-                        result.clear();
-                    }
+                    code = InternalOutbound<OUTBOUND>(context, result, method, std::forward<Args>(args)..., inbound);
                 }
                 else {
                     result = report.Value().Message();
@@ -1399,16 +1560,41 @@ namespace Core {
                 return (code);
             }
             template <typename OUTBOUND, typename METHOD, typename... Args>
-            static uint32_t InternalRegisterImpl(string& result, const METHOD& method, Args&&... args)
+            static uint32_t InternalRegisterImpl(const Context& context, string& result, const METHOD& method, Args&&... args)
+            {
+                return (InternalOutbound<OUTBOUND>(context, result, method, std::forward<Args>(args)...));
+            }
+            template <typename OUTBOUND, typename METHOD, typename... Args>
+            static uint32_t InternalOutbound(const Context& context, string& result, const METHOD& method, Args&&... args)
             {
-                OUTBOUND outbound;
+                uint32_t code;
+
+                if (context.HasResult() == true) {
+                    // The caller serializes the object straight into the response.
+                    Core::ProxyType<OUTBOUND> outbound(Core::ProxyType<OUTBOUND>::Create());
 
-                uint32_t code = method(std::forward<Args>(args)..., outbound);
+                    code = method(std::forward<Args>(args)..., *outbound);
 
-                if (code == Core::ERROR_NONE) {
-                    outbound.ToString(result);
+                    if (code == Core::ERROR_NONE) {
+                        if (outbound->IsSet() == true) {
+                            context.Result(Core::ProxyType<const Core::JSON::IElement>(outbound));
+                        }
+                        else {
+                            outbound->ToString(result);
+                        }
+                    }
                 }
                 else {
+                    OUTBOUND outbound;
+
+                    code = method(std::forward<Args>(args)..., outbound);
+
+                    if (code == Core::ERROR_NONE) {
+                        outbound.ToString(result);
+                    }
+                }
+
+                if (code != Core::ERROR_NONE) {
                     result.clear();
                 }
 
@@ -436,6 +436,8 @@ extern "C" EXTERNAL uint64_t gettid();
 #include <linux/types.h>
 #include <linux/uinput.h>
 #include <sys/signalfd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 
 uint64_t htonll(const uint64_t& value);
 uint64_t ntohll(const uint64_t& value);
@@ -0,0 +1,83 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Proxy.h"
+
+namespace WPEFramework {
+
+namespace Core {
+
+    /* static */ ProxyPoolAdministrator& ProxyPoolAdministrator::Instance()
+    {
+        // Pools are mostly static objects themselves, they register while being constructed, so
+        // this one is destructed after the last of them. Not a SingletonType, Dispose() would be
+        // too early.
+        static ProxyPoolAdministrator administrator;
+
+        return (administrator);
+    }
+
+    /* static */ uint8_t ProxyPoolAdministrator::Slot()
+    {
+        static std::atomic<uint8_t> next(0);
+        static thread_local uint8_t slot = next++;
+
+        return (slot);
+    }
+
+    void ProxyPoolAdministrator::Register(const IPool* pool)
+    {
+        _adminLock.Lock();
+
+        ASSERT(std::find(_pools.begin(), _pools.end(), pool) == _pools.end());
+
+        _pools.push_back(pool);
+
+        _adminLock.Unlock();
+    }
+
+    void ProxyPoolAdministrator::Unregister(const IPool* pool)
+    {
+        _adminLock.Lock();
+
+        std::vector<const IPool*>::iterator index(std::find(_pools.begin(), _pools.end(), pool));
+
+        ASSERT(index != _pools.end());
+
+        if (index != _pools.end()) {
+            _pools.erase(index);
+        }
+
+        _adminLock.Unlock();
+    }
+
+    void ProxyPoolAdministrator::Snapshot(std::vector<Metadata>& pools) const
+    {
+        _adminLock.Lock();
+
+        pools.resize(_pools.size());
+
+        for (uint32_t index = 0; index < _pools.size(); index++) {
+            _pools[index]->Snapshot(pools[index]);
+        }
+
+        _adminLock.Unlock();
+    }
+}
+}
@@ -23,6 +23,7 @@
  // ---- Include system wide include files ----
 #include <memory>
 #include <atomic>
+#include <vector>
 
 // ---- Include local include files ----
 #include "Portability.h"
@@ -1418,11 +1419,121 @@ POP_WARNING()
             CONTAINER* _parent;
         };
 
+        // Keeps track of all ProxyPoolTypes in the process, so the way they are used can be reported.
+        class EXTERNAL ProxyPoolAdministrator {
+        public:
+            struct Metadata {
+                const char* Name; // As reported by typeid, use ClassNameOnly to make it readable.
+                uint32_t Created;
+                uint32_t Outstanding;
+                uint32_t HighWater;
+                uint32_t Hits;
+                uint32_t Misses;
+            };
+
+            struct IPool {
+                virtual ~IPool() = default;
+
+                virtual void Snapshot(Metadata& info) const = 0;
+            };
+
+        private:
+            ProxyPoolAdministrator()
+                : _adminLock()
+                , _pools()
+            {
+            }
+
+        public:
+            ProxyPoolAdministrator(ProxyPoolAdministrator&&) = delete;
+            ProxyPoolAdministrator(const ProxyPoolAdministrator&) = delete;
+            ProxyPoolAdministrator& operator=(ProxyPoolAdministrator&&) = delete;
+            ProxyPoolAdministrator& operator=(const ProxyPoolAdministrator&) = delete;
+
+            ~ProxyPoolAdministrator() = default;
+
+            static ProxyPoolAdministrator& Instance();
+
+            // The magazine a thread uses in every pool. Threads get one in the order they first
+            // ask for it, so the threads of a (small) thread pool do not share.
+            static uint8_t Slot();
+
+        public:
+            void Register(const IPool* pool);
+            void Unregister(const IPool* pool);
+            void Snapshot(std::vector<Metadata>& pools) const;
+
+        private:
+            mutable CriticalSection _adminLock;
+            std::vector<const IPool*> _pools;
+        };
+
         template <typename PROXYELEMENT>
-        class ProxyPoolType {
+        class ProxyPoolType : public ProxyPoolAdministrator::IPool {
         private:
             using ContainerElement = ProxyContainerType< ProxyPoolType<PROXYELEMENT>, PROXYELEMENT, PROXYELEMENT>;
-            using ContainerList = std::list< Core::ProxyType<ContainerElement> >;
+            using ContainerList = std::vector< Core::ProxyType<ContainerElement> >;
+
+            // A handful of recycled elements set aside for the threads using this slot, so taking
+            // and returning elements does not contend on the pool lock. A thread that finds the
+            // magazine in use by another thread, goes to the pool instead of waiting for it.
+            class Magazine {
+            public:
+                static constexpr uint8_t Size = 4;
+
+            public:
+                Magazine(Magazine&&) = delete;
+                Magazine(const Magazine&) = delete;
+                Magazine& operator=(Magazine&&) = delete;
+                Magazine& operator=(const Magazine&) = delete;
+
+                Magazine()
+                    : _busy(false)
+                    , _count(0)
+                    , _elements()
+                {
+                }
+                ~Magazine() = default;
+
+            public:
+                bool Lock()
+                {
+                    return (_busy.exchange(true, std::memory_order_acquire) == false);
+                }
+                void Unlock()
+                {
+                    _busy.store(false, std::memory_order_release);
+                }
+                bool Pop(Core::ProxyType<ContainerElement>& element)
+                {
+                    bool result = (_count > 0);
+
+                    if (result == true) {
+                        _count--;
+                        element = std::move(_elements[_count]);
+                    }
+
+                    return (result);
+                }
+                bool Push(Core::ProxyType<ContainerElement>& element)
+                {
+                    bool result = (_count < Size);
+
+                    if (result == true) {
+                        _elements[_count] = std::move(element);
+                        _count++;
+                    }
+
+                    return (result);
+                }
+
+            private:
+                std::atomic<bool> _busy;
+                uint8_t _count;
+                Core::ProxyType<ContainerElement> _elements[Size];
+            };
+
+            static constexpr uint8_t Magazines = 4;
 
         public:
             ProxyPoolType(const ProxyPoolType<PROXYELEMENT>&) = delete;
@@ -1431,8 +1542,16 @@ POP_WARNING()
             template <typename... Args>
             ProxyPoolType(const uint32_t initialQueueSize, Args&&... args)
                 : _createdElements(initialQueueSize)
+                , _queue()
+                , _magazines()
+                , _outstanding(0)
+                , _highWater(0)
+                , _hits(0)
+                , _misses(0)
                 , _lock()
             {
+                _queue.reserve(initialQueueSize);
+
                 for (uint32_t index = 0; index < initialQueueSize; index++) {
                     Core::ProxyType<ContainerElement> newElement;
 
@@ -1440,19 +1559,37 @@ POP_WARNING()
                     _queue.emplace_back(std::move(newElement));
                     ASSERT(_queue.back().IsValid() == true);
                 }
+
+                ProxyPoolAdministrator::Instance().Register(this);
             }
-            ~ProxyPoolType()
+            ~ProxyPoolType() override
             {
+                ProxyPoolAdministrator::Instance().Unregister(this);
+
                 // Clear the created objects..
                 uint16_t attempt = 500;
                 do {
+                    // Whatever the magazines hold, goes back into the queue to be cleared as well.
+                    for (Magazine& magazine : _magazines) {
+                        Core::ProxyType<ContainerElement> element;
+
+                        if (magazine.Lock() == true) {
+                            while (magazine.Pop(element) == true) {
+                                _lock.Lock();
+                                _queue.emplace_back(std::move(element));
+                                _lock.Unlock();
+                            }
+                            magazine.Unlock();
+                        }
+                    }
+
                     while (_queue.size() != 0) {
 
                         _lock.Lock();
 
-                        Core::ProxyType<ContainerElement> expendable(std::move(_queue.front()));
+                        Core::ProxyType<ContainerElement> expendable(std::move(_queue.back()));
                         expendable->Unlink();
-                        _queue.pop_front();
+                        _queue.pop_back();
                         _createdElements--;
 
                         _lock.Unlock();
@@ -1479,29 +1616,54 @@ POP_WARNING()
             {
                 Core::ProxyType<PROXYELEMENT> result;
                 Core::ProxyType<ContainerElement> element;
+                Magazine& magazine(_magazines[ProxyPoolAdministrator::Slot() % Magazines]);
 
-                _lock.Lock();
+                if (magazine.Lock() == true) {
+                    magazine.Pop(element);
+                    magazine.Unlock();
+                }
 
-                if (_queue.size() == 0) {
+                if (element.IsValid() == false) {
+                    _lock.Lock();
 
-                    _createdElements++;
+                    if (_queue.size() != 0) {
+                        element = std::move(_queue.back());
+                        _queue.pop_back();
 
-                    _lock.Unlock();
+                        _lock.Unlock();
+                    }
+                    else {
+                        _lock.Unlock();
 
-                    Core::ProxyType<ContainerElement>::template CreateMove(element, 0, *this, std::forward<Args>(args)...);
+                        // Before creating a new one, see if other threads have some set aside.
+                        Steal(element);
+                    }
+                }
 
-                    result = Core::ProxyType<PROXYELEMENT>(element);
+                if (element.IsValid() == true) {
+                    _hits++;
                 }
                 else {
-                    element = _queue.front();
-                    result = Core::ProxyType<PROXYELEMENT>(element);
-                    _queue.pop_front();
+                    _lock.Lock();
+
+                    _createdElements++;
+
+                    // Make sure returning elements never has to allocate room for them.
+                    if (_queue.capacity() < _createdElements) {
+                        _queue.reserve(2 * _createdElements);
+                    }
 
                     _lock.Unlock();
+
+                    _misses++;
+
+                    Core::ProxyType<ContainerElement>::template CreateMove(element, 0, *this, std::forward<Args>(args)...);
                 }
 
                 ASSERT(element.IsValid());
 
+                result = Core::ProxyType<PROXYELEMENT>(element);
+
                 // As it is removed from the queue, we will keep a "flying reference", this
                 // way if the user of ths object releases it, it will trigger the last
                 // refernce notification (Relinquish) prior to the user dropping the
@@ -1509,6 +1671,13 @@ POP_WARNING()
                 // and move this "AddRef" into the queue again (move)
                 result.AddRef();
 
+                uint32_t outstanding = ++_outstanding;
+                uint32_t highWater = _highWater.load(std::memory_order_relaxed);
+
+                while ((outstanding > highWater) && (_highWater.compare_exchange_weak(highWater, outstanding, std::memory_order_relaxed) == false)) {
+                    // highWater got reloaded, try again if we are still above it.
+                }
+
                 // TRACE_L1("Reused an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*result));
 
                 return (result);
@@ -1519,7 +1688,7 @@ POP_WARNING()
             }
             inline uint32_t QueuedElements() const
             {
-                return (static_cast<uint32_t>(_queue.size()));
+                return (_createdElements - _outstanding);
             }
             void Notify(Core::ProxyType<ContainerElement>& source)
             {
@@ -1528,25 +1697,68 @@ POP_WARNING()
                 // lets skip it for now..
                 // TODO: Call source->Relinquish(Core::ProxyType<PROXYELEMENT>&);
 
-                _lock.Lock();
+                Magazine& magazine(_magazines[ProxyPoolAdministrator::Slot() % Magazines]);
+                bool stored = false;
 
                 source->Clear();
 
-                // Lets see if the source is already in there :-)
-                ASSERT(std::find(_queue.begin(), _queue.end(), source) == _queue.end());
+                _outstanding--;
 
-                // TRACE_L1("Returned an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*element));
-                _queue.emplace_back(std::move(source));
+                if (magazine.Lock() == true) {
+                    stored = magazine.Push(source);
+                    magazine.Unlock();
+                }
 
-                _lock.Unlock();
+                if (stored == false) {
+                    _lock.Lock();
+
+                    // Lets see if the source is already in there :-)
+                    ASSERT(std::find(_queue.begin(), _queue.end(), source) == _queue.end());
+
+                    // TRACE_L1("Returned an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*element));
+                    _queue.emplace_back(std::move(source));
+
+                    _lock.Unlock();
+                }
             }
             uint32_t Count() const {
                 return (_createdElements);
             }
+            void Snapshot(ProxyPoolAdministrator::Metadata& info) const override
+            {
+                info.Name = typeid(PROXYELEMENT).name();
+                info.Created = _createdElements;
+                info.Outstanding = _outstanding;
+                info.HighWater = _highWater;
+                info.Hits = _hits;
+                info.Misses = _misses;
+            }
+
+        private:
+            void Steal(Core::ProxyType<ContainerElement>& element)
+            {
+                uint8_t index = 0;
+
+                while ((element.IsValid() == false) && (index < Magazines)) {
+                    Magazine& magazine(_magazines[index]);
+
+                    if (magazine.Lock() == true) {
+                        magazine.Pop(element);
+                        magazine.Unlock();
+                    }
+
+                    index++;
+                }
+            }
 
         private:
             uint32_t _createdElements;
             ContainerList _queue;
+            Magazine _magazines[Magazines];
+            std::atomic<uint32_t> _outstanding;
+            std::atomic<uint32_t> _highWater;
+            std::atomic<uint32_t> _hits;
+            std::atomic<uint32_t> _misses;
             mutable Core::CriticalSection _lock;
         };
 
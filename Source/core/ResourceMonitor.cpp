@@ -20,10 +20,198 @@
 #include "ResourceMonitor.h"
 #include "Singleton.h"
 
+#ifdef __CORE_IO_URING__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 namespace WPEFramework {
 
 namespace Core {
 
+#ifdef __CORE_IO_URING__
+    // There is no need for liburing, the few calls needed are made here directly.
+    static int Setup(const uint32_t entries, struct io_uring_params& parameters)
+    {
+        return (static_cast<int>(::syscall(__NR_io_uring_setup, entries, &parameters)));
+    }
+    static int Enter(const int descriptor, const uint32_t submit, const uint32_t complete, const uint32_t flags)
+    {
+        return (static_cast<int>(::syscall(__NR_io_uring_enter, descriptor, submit, complete, flags, nullptr, 0)));
+    }
+
+    CompletionRing::CompletionRing(const uint16_t entries)
+        : _descriptor(-1)
+        , _entries(0)
+        , _submissionRing(static_cast<uint8_t*>(MAP_FAILED))
+        , _submissionRingSize(0)
+        , _completionRing(static_cast<uint8_t*>(MAP_FAILED))
+        , _completionRingSize(0)
+        , _submissions(MAP_FAILED)
+        , _submissionsSize(0)
+        , _submissionHead(nullptr)
+        , _submissionTail(nullptr)
+        , _submissionArray(nullptr)
+        , _submissionMask(0)
+        , _completionHead(nullptr)
+        , _completionTail(nullptr)
+        , _completions(nullptr)
+        , _completionMask(0)
+    {
+        struct io_uring_params parameters;
+        ::memset(&parameters, 0, sizeof(parameters));
+
+        int descriptor = Setup(entries, parameters);
+
+        if (descriptor == -1) {
+            TRACE_L1("io_uring_setup failed with error <%d>", errno);
+        }
+        else if ((parameters.features & (IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL)) != (IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL)) {
+            // Kernels before 5.7, completions could get lost and reads are not known yet.
+            TRACE_L1("io_uring lacks the required features, only 0x%X available", parameters.features);
+            ::close(descriptor);
+        }
+        else {
+            _submissionRingSize = parameters.sq_off.array + (parameters.sq_entries * sizeof(uint32_t));
+            _completionRingSize = parameters.cq_off.cqes + (parameters.cq_entries * sizeof(struct io_uring_cqe));
+            _submissionsSize = parameters.sq_entries * sizeof(struct io_uring_sqe);
+
+            _submissionRing = static_cast<uint8_t*>(::mmap(nullptr, _submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, IORING_OFF_SQ_RING));
+            _completionRing = static_cast<uint8_t*>(::mmap(nullptr, _completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, IORING_OFF_CQ_RING));
+            _submissions = ::mmap(nullptr, _submissionsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, descriptor, IORING_OFF_SQES);
+
+            if ((_submissionRing == MAP_FAILED) || (_completionRing == MAP_FAILED) || (_submissions == MAP_FAILED)) {
+                TRACE_L1("io_uring rings could not be mapped, error <%d>", errno);
+                ::close(descriptor);
+            }
+            else {
+                _entries = parameters.sq_entries;
+                _submissionHead = reinterpret_cast<uint32_t*>(_submissionRing + parameters.sq_off.head);
+                _submissionTail = reinterpret_cast<uint32_t*>(_submissionRing + parameters.sq_off.tail);
+                _submissionArray = reinterpret_cast<uint32_t*>(_submissionRing + parameters.sq_off.array);
+                _submissionMask = *reinterpret_cast<uint32_t*>(_submissionRing + parameters.sq_off.ring_mask);
+                _completionHead = reinterpret_cast<uint32_t*>(_completionRing + parameters.cq_off.head);
+                _completionTail = reinterpret_cast<uint32_t*>(_completionRing + parameters.cq_off.tail);
+                _completions = _completionRing + parameters.cq_off.cqes;
+                _completionMask = *reinterpret_cast<uint32_t*>(_completionRing + parameters.cq_off.ring_mask);
+
+                // Each slot of the submission ring points to its own entry, for good.
+                for (uint32_t index = 0; index < _entries; index++) {
+                    _submissionArray[index] = index;
+                }
+
+                _descriptor = descriptor;
+            }
+        }
+    }
+    CompletionRing::~CompletionRing()
+    {
+        if (_submissions != MAP_FAILED) {
+            ::munmap(_submissions, _submissionsSize);
+        }
+        if (_completionRing != MAP_FAILED) {
+            ::munmap(_completionRing, _completionRingSize);
+        }
+        if (_submissionRing != MAP_FAILED) {
+            ::munmap(_submissionRing, _submissionRingSize);
+        }
+        if (_descriptor != -1) {
+            ::close(_descriptor);
+        }
+    }
+
+    void* CompletionRing::Entry()
+    {
+        ASSERT(IsValid() == true);
+
+        uint32_t tail = *_submissionTail;
+
+        // All slots taken, the kernel has to pick them up first.
+        while ((tail - __atomic_load_n(_submissionHead, __ATOMIC_ACQUIRE)) >= _entries) {
+            Submit();
+        }
+
+        struct io_uring_sqe* entry = &(static_cast<struct io_uring_sqe*>(_submissions)[tail & _submissionMask]);
+        ::memset(entry, 0, sizeof(struct io_uring_sqe));
+
+        return (entry);
+    }
+    void CompletionRing::Poll(const int descriptor, const uint16_t events, const uint64_t token)
+    {
+        struct io_uring_sqe* entry = static_cast<struct io_uring_sqe*>(Entry());
+
+        entry->opcode = IORING_OP_POLL_ADD;
+        entry->fd = descriptor;
+        entry->user_data = token;
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        entry->poll32_events = (static_cast<uint32_t>(events) << 16);
+#else
+        entry->poll32_events = events;
+#endif
+
+        __atomic_store_n(_submissionTail, *_submissionTail + 1, __ATOMIC_RELEASE);
+    }
+    void CompletionRing::Cancel(const uint64_t token)
+    {
+        struct io_uring_sqe* entry = static_cast<struct io_uring_sqe*>(Entry());
+
+        entry->opcode = IORING_OP_POLL_REMOVE;
+        entry->fd = -1;
+        entry->addr = token;
+        entry->user_data = 0;
+
+        __atomic_store_n(_submissionTail, *_submissionTail + 1, __ATOMIC_RELEASE);
+    }
+    void CompletionRing::Read(const int descriptor, void* buffer, const uint32_t length, const uint64_t token)
+    {
+        struct io_uring_sqe* entry = static_cast<struct io_uring_sqe*>(Entry());
+
+        entry->opcode = IORING_OP_READ;
+        entry->fd = descriptor;
+        entry->addr = reinterpret_cast<uintptr_t>(buffer);
+        entry->len = length;
+        entry->off = static_cast<uint64_t>(-1);
+        entry->user_data = token;
+
+        __atomic_store_n(_submissionTail, *_submissionTail + 1, __ATOMIC_RELEASE);
+    }
+    void CompletionRing::Submit()
+    {
+        if (Enter(_descriptor, _entries, 0, 0) == -1) {
+            TRACE_L1("io_uring_enter failed to submit, error <%d>", errno);
+        }
+    }
+    uint16_t CompletionRing::Wait(Completion completions[], const uint16_t count)
+    {
+        uint32_t head = *_completionHead;
+        uint16_t result = 0;
+
+        const bool empty = (head == __atomic_load_n(_completionTail, __ATOMIC_ACQUIRE));
+        const bool queued = (*_submissionTail != __atomic_load_n(_submissionHead, __ATOMIC_ACQUIRE));
+
+        // Submits whatever is queued and waits for something to complete, all in one call.
+        if (((empty == true) || (queued == true)) && (Enter(_descriptor, _entries, (empty == true ? 1 : 0), IORING_ENTER_GETEVENTS) == -1) && (errno != EINTR)) {
+            TRACE_L1("io_uring_enter failed to wait, error <%d>", errno);
+        }
+
+        const uint32_t tail = __atomic_load_n(_completionTail, __ATOMIC_ACQUIRE);
+
+        while ((head != tail) && (result < count)) {
+            const struct io_uring_cqe& entry(static_cast<const struct io_uring_cqe*>(_completions)[head & _completionMask]);
+
+            completions[result].Token = entry.user_data;
+            completions[result].Result = entry.res;
+            result++;
+            head++;
+        }
+
+        __atomic_store_n(_completionHead, head, __ATOMIC_RELEASE);
+
+        return (result);
+    }
+#endif
+
     /* static */ ResourceMonitor& ResourceMonitor::Instance()
     {
         // Tests build/destroy the ResourceMonitor for each test. In production the
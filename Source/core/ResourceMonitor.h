@@ -20,12 +20,21 @@
 #pragma once
 
 #include "Module.h"
+#include "Number.h"
 #include "Portability.h"
 #include "Singleton.h"
 #include "Thread.h"
 #include "Trace.h"
 #include "Timer.h"
 
+#if defined(__LINUX__) && !defined(__APPLE__)
+#define __CORE_RESOURCE_REACTORS__
+#endif
+
+#if defined(__CORE_IO_URING__) && !defined(__CORE_RESOURCE_REACTORS__)
+#undef __CORE_IO_URING__
+#endif
+
 namespace WPEFramework {
 
 namespace Core {
@@ -41,6 +50,66 @@ namespace Core {
         virtual void Handle(const uint16_t events) = 0;
     };
 
+    #ifdef __CORE_IO_URING__
+    // A minimal io_uring instance. Operations are queued in the submission ring and only handed to
+    // the kernel on Submit() or Wait(), so a whole batch of them costs a single system call. Whether
+    // the running kernel offers what is needed is only known at runtime, see IsValid().
+    class EXTERNAL CompletionRing {
+    public:
+        struct Completion {
+            uint64_t Token;
+            int32_t Result;
+        };
+
+    public:
+        CompletionRing() = delete;
+        CompletionRing(CompletionRing&&) = delete;
+        CompletionRing(const CompletionRing&) = delete;
+        CompletionRing& operator=(CompletionRing&&) = delete;
+        CompletionRing& operator=(const CompletionRing&) = delete;
+
+        explicit CompletionRing(const uint16_t entries);
+        ~CompletionRing();
+
+    public:
+        bool IsValid() const
+        {
+            return (_descriptor != -1);
+        }
+
+        // One shot poll, completes with the poll events that are set.
+        void Poll(const int descriptor, const uint16_t events, const uint64_t token);
+        // Cancels the poll that was queued with the given token, it completes with -ECANCELED.
+        void Cancel(const uint64_t token);
+        void Read(const int descriptor, void* buffer, const uint32_t length, const uint64_t token);
+
+        // Only the queueing is not thread safe, a Submit() may run next to a Wait() on another thread.
+        void Submit();
+        uint16_t Wait(Completion completions[], const uint16_t count);
+
+    private:
+        void* Entry();
+
+    private:
+        int _descriptor;
+        uint32_t _entries;
+        uint8_t* _submissionRing;
+        size_t _submissionRingSize;
+        uint8_t* _completionRing;
+        size_t _completionRingSize;
+        void* _submissions;
+        size_t _submissionsSize;
+        uint32_t* _submissionHead;
+        uint32_t* _submissionTail;
+        uint32_t* _submissionArray;
+        uint32_t _submissionMask;
+        uint32_t* _completionHead;
+        uint32_t* _completionTail;
+        void* _completions;
+        uint32_t _completionMask;
+    };
+    #endif
+
     template <typename RESOURCE, typename WATCHDOG, const uint32_t STACK_SIZE, const uint8_t RESOURCE_SLOTS>
     class ResourceMonitorType {
     private:
@@ -94,6 +163,8 @@ namespace Core {
         };
 
     public:
+        static constexpr uint8_t AnyReactor = static_cast<uint8_t>(~0);
+
         struct Metadata {
             Core::IResource::handle descriptor;
             uint16_t monitor;
@@ -102,6 +173,696 @@ namespace Core {
             char filename[128];
         };
 
+    private:
+        #ifdef __CORE_RESOURCE_REACTORS__
+        // A Reactor owns a shard of the resources. Each resource sticks to one reactor for its lifetime,
+        // the reactor keeps its resources registered in its own epoll instance so (un)registration is O(1)
+        // and a wakeup only visits the resources that were reported ready or were broken by a
+        // Break(resource). A plain Break() still causes all resources of the reactor to be Handle()d and
+        // their Events() to be reevaluated, as with poll().
+        class Reactor : public Core::Thread {
+        private:
+            static constexpr uint16_t BatchSize = 64;
+
+            struct Entry {
+                Core::IResource::handle descriptor;
+                uint16_t events;
+                uint16_t revents;
+                bool alive;
+                bool signalled;
+                bool queued;
+                #ifdef __CORE_IO_URING__
+                uint64_t token;
+                #endif
+            };
+
+            #ifdef __CORE_IO_URING__
+            // With a completion ring, the resources are watched with one shot polls. Each poll has its own
+            // token, so a late completion of a poll that was cancelled can not be taken for a new one.
+            static constexpr uint16_t RingSize = 256;
+            static constexpr uint64_t CancelToken = 0;
+            static constexpr uint64_t BreakToken = 1;
+
+            using Tokens = std::unordered_map<uint64_t, RESOURCE*>;
+            #endif
+
+            using Entries = std::unordered_map<RESOURCE*, Entry>;
+
+            struct Retirement {
+                RESOURCE* resource;
+                Core::Event* dropped;
+            };
+
+        public:
+            Reactor() = delete;
+            Reactor(Reactor&&) = delete;
+            Reactor(const Reactor&) = delete;
+            Reactor& operator=(Reactor&&) = delete;
+            Reactor& operator=(const Reactor&) = delete;
+
+            Reactor(Parent& parent, const string& name)
+                : Core::Thread(STACK_SIZE == 0 ? Thread::DefaultStackSize() : STACK_SIZE, name.c_str())
+                , _parent(parent)
+                , _lock()
+                , _pendingLock()
+                , _entries()
+                , _pending()
+                , _retired()
+                , _breaks()
+                , _ready()
+                , _dirty()
+                , _evaluating()
+                , _breakAll(false)
+                , _retiring(false)
+                , _awaiting(nullptr)
+                , _reevaluate(false)
+                , _runs(0)
+                , _count(0)
+                , _epoll(::epoll_create1(EPOLL_CLOEXEC))
+                , _signal(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+                #ifdef __CORE_IO_URING__
+                , _ring(new CompletionRing(RingSize))
+                , _tokens()
+                , _token(BreakToken)
+                , _signalled(0)
+                #endif
+            {
+                ASSERT(_epoll != -1);
+                ASSERT(_signal != -1);
+
+                _ready.reserve(BatchSize);
+
+                #ifdef __CORE_IO_URING__
+                if (_ring->IsValid() == true) {
+                    // The break signal is read as soon as it is given, no poll and read needed.
+                    _ring->Read(_signal, &_signalled, sizeof(_signalled), BreakToken);
+                }
+                else {
+                    TRACE_L1("io_uring is not available, %s falls back to epoll", name.c_str());
+                    delete _ring;
+                    _ring = nullptr;
+                }
+
+                if (_ring == nullptr)
+                #endif
+                {
+                    struct epoll_event event;
+                    event.events = EPOLLIN;
+                    event.data.ptr = nullptr;
+
+                    int VARIABLE_IS_NOT_USED result = ::epoll_ctl(_epoll, EPOLL_CTL_ADD, _signal, &event);
+                    ASSERT(result == 0);
+                }
+
+                Thread::Init();
+            }
+            ~Reactor() override
+            {
+                Stop();
+                Wake();
+                Wait(Thread::BLOCKED | Thread::STOPPED, Core::infinite);
+
+                #ifdef __CORE_IO_URING__
+                if (_ring != nullptr) {
+                    // Closing the ring cancels whatever is still queued in it.
+                    delete _ring;
+                }
+                #endif
+
+                ::close(_signal);
+                ::close(_epoll);
+            }
+
+        public:
+            uint32_t Runs() const
+            {
+                return (_runs);
+            }
+            uint32_t Count() const
+            {
+                return (_count);
+            }
+            bool Info(uint32_t& position, Metadata& info) const
+            {
+                bool found = false;
+
+                _lock.Lock();
+
+                typename Entries::const_iterator index(_entries.cbegin());
+
+                while ((index != _entries.cend()) && ((index->second.alive == false) || (position != 0))) {
+                    if (index->second.alive == true) {
+                        position--;
+                    }
+                    index++;
+                }
+
+                if (index != _entries.cend()) {
+                    info.descriptor = index->second.descriptor;
+                    info.classname  = typeid(*(index->first)).name();
+                    info.monitor    = index->second.events;
+                    info.events     = index->second.revents;
+
+                    char procfn[64];
+                    sprintf(procfn, "/proc/self/fd/%d", info.descriptor);
+
+                    ssize_t len = readlink(procfn, info.filename, sizeof(info.filename) - 1);
+                    info.filename[(len < 0 ? 0 : len)] = '\0';
+
+                    found = true;
+                }
+
+                _lock.Unlock();
+
+                return (found);
+            }
+            void Register(RESOURCE& resource)
+            {
+                // Registration does not wait for the reactor to finish its cycle, the resource is
+                // picked up at the start of the next cycle. This way a resource being handled on
+                // one reactor can register resources on another reactor without any lock ordering.
+                _pendingLock.Lock();
+
+                if (std::find(_pending.cbegin(), _pending.cend(), &resource) == _pending.cend()) {
+                    _pending.push_back(&resource);
+                }
+
+                Run();
+                Wake();
+
+                _pendingLock.Unlock();
+            }
+            void Unregister(RESOURCE& resource)
+            {
+                // Wait till the reactor is not handling any of its resources, so once we return
+                // the resource will not be called anymore. Only for this reactor itself and for
+                // threads that are not a reactor, other reactors must Retire() the resource.
+                _lock.Lock();
+
+                _pendingLock.Lock();
+                Forget(resource);
+                _pendingLock.Unlock();
+
+                Remove(resource);
+
+                _lock.Unlock();
+            }
+            void Retire(RESOURCE& resource, Reactor& caller)
+            {
+                // Unregistration from another reactor, that might be in the middle of handling its own
+                // resources. Waiting for our lock could deadlock, so the resource is handed over and
+                // dropped before this reactor handles any other resource. Only once it is dropped, so
+                // it is not handled anymore, we return. Unless this reactor is itself waiting for the
+                // caller to drop a resource, then waiting would deadlock.
+                Core::Event dropped(false, true);
+
+                caller._awaiting = this;
+
+                const bool wait = (IsAwaiting(caller) == false);
+
+                _pendingLock.Lock();
+
+                Forget(resource);
+
+                _retired.push_back({ &resource, (wait == true ? &dropped : nullptr) });
+
+                _retiring = true;
+
+                Run();
+                Wake();
+
+                _pendingLock.Unlock();
+
+                if (wait == true) {
+                    dropped.Lock(Core::infinite);
+                }
+
+                caller._awaiting = nullptr;
+            }
+            void Break()
+            {
+                _pendingLock.Lock();
+                _breakAll = true;
+                _pendingLock.Unlock();
+
+                Wake();
+            }
+            void Break(RESOURCE& resource)
+            {
+                _pendingLock.Lock();
+
+                if (std::find(_breaks.cbegin(), _breaks.cend(), &resource) == _breaks.cend()) {
+                    _breaks.push_back(&resource);
+                }
+
+                _pendingLock.Unlock();
+
+                Wake();
+            }
+            uint32_t Worker() override
+            {
+                uint32_t delay = 0;
+
+                _runs++;
+
+                _lock.Lock();
+
+                if (_retiring == true) {
+                    Drop();
+                }
+
+                Adopt();
+                Evaluate();
+
+                _pendingLock.Lock();
+
+                if ((_entries.empty() == true) && (_pending.empty() == true)) {
+                    Block();
+                    delay = Core::infinite;
+                }
+
+                _pendingLock.Unlock();
+
+                #ifdef __CORE_IO_URING__
+                if ((delay == 0) && (_ring != nullptr)) {
+                    _lock.Unlock();
+
+                    // Hands all (re)armed polls to the kernel and waits, in one go.
+                    const uint16_t count = _ring->Wait(_completions, BatchSize);
+
+                    _lock.Lock();
+
+                    Complete(count);
+                }
+                else
+                #endif
+                if (delay == 0) {
+                    _lock.Unlock();
+
+                    int result = ::epoll_wait(_epoll, _events, BatchSize, -1);
+
+                    _lock.Lock();
+
+                    if (result == -1) {
+                        TRACE_L1("epoll_wait failed with error <%d>", errno);
+                    }
+                    else {
+                        Dispatch(result);
+                    }
+                }
+
+                _lock.Unlock();
+
+                return (delay);
+            }
+
+        private:
+            void Wake()
+            {
+                const uint64_t value = 1;
+                ssize_t VARIABLE_IS_NOT_USED written = ::write(_signal, &value, sizeof(value));
+            }
+            bool IsAwaiting(const Reactor& reactor) const
+            {
+                // Follow the chain of reactors waiting on each other, it can not be longer than
+                // the number of reactors unless it runs in circles.
+                const Reactor* next = _awaiting;
+                uint16_t hops = 0;
+
+                while ((next != nullptr) && (next != &reactor) && (hops++ < 256)) {
+                    next = next->_awaiting;
+                }
+
+                return (next == &reactor);
+            }
+            void Forget(RESOURCE& resource)
+            {
+                typename std::vector<RESOURCE*>::iterator pending(std::find(_pending.begin(), _pending.end(), &resource));
+
+                if (pending != _pending.end()) {
+                    _pending.erase(pending);
+                }
+            }
+            void Remove(RESOURCE& resource)
+            {
+                typename Entries::iterator index(_entries.find(&resource));
+
+                if ((index != _entries.end()) && (index->second.alive == true)) {
+                    index->second.alive = false;
+                    _count--;
+
+                    #ifdef __CORE_IO_URING__
+                    if (_ring != nullptr) {
+                        // The poll holds on to the file, so cancel it right away. The descriptor
+                        // might be closed already, only then it is really released.
+                        if (Disarm(index->second) == true) {
+                            _ring->Submit();
+                        }
+                        index->second.events = 0;
+                    }
+                    else
+                    #endif
+                    if (index->second.events != 0) {
+                        ::epoll_ctl(_epoll, EPOLL_CTL_DEL, index->second.descriptor, nullptr);
+                        index->second.events = 0;
+                    }
+
+                    _dirty.push_back(&resource);
+                }
+            }
+            void Drop()
+            {
+                _pendingLock.Lock();
+
+                for (const Retirement& retirement : _retired) {
+                    Forget(*retirement.resource);
+                    Remove(*retirement.resource);
+
+                    if (retirement.dropped != nullptr) {
+                        retirement.dropped->SetEvent();
+                    }
+                }
+
+                _retired.clear();
+                _retiring = false;
+
+                _pendingLock.Unlock();
+            }
+            void Adopt()
+            {
+                _pendingLock.Lock();
+
+                for (RESOURCE* resource : _pending) {
+                    Entry& entry(_entries[resource]);
+
+                    if (entry.alive == false) {
+                        entry.descriptor = Core::IResource::INVALID;
+                        entry.events = 0;
+                        entry.revents = 0;
+                        entry.alive = true;
+                        entry.signalled = false;
+                        entry.queued = false;
+                        #ifdef __CORE_IO_URING__
+                        entry.token = CancelToken;
+                        #endif
+                        _count++;
+                    }
+
+                    _dirty.push_back(resource);
+                }
+
+                _pending.clear();
+
+                _pendingLock.Unlock();
+            }
+            void Evaluate()
+            {
+                if (_reevaluate == true) {
+                    _reevaluate = false;
+
+                    // All of them are visited, only what gets dirty while doing so is left.
+                    _dirty.clear();
+
+                    typename Entries::iterator index(_entries.begin());
+
+                    while (index != _entries.end()) {
+                        index = Evaluate(index);
+                    }
+                }
+
+                // Asking a resource for its Events() can get resources removed, which makes them
+                // dirty again. So walk a copy and repeat till nothing new got dirty.
+                while (_dirty.empty() == false) {
+                    _evaluating.swap(_dirty);
+
+                    for (RESOURCE* resource : _evaluating) {
+                        typename Entries::iterator index(_entries.find(resource));
+
+                        if (index != _entries.end()) {
+                            Evaluate(index);
+                        }
+                    }
+
+                    _evaluating.clear();
+                }
+            }
+            typename Entries::iterator Evaluate(typename Entries::iterator index)
+            {
+                Entry& entry(index->second);
+                uint16_t events;
+
+                if ((entry.alive == false) || ((events = index->first->Events()) == 0)) {
+                    if (entry.alive == true) {
+                        _count--;
+                    }
+                    #ifdef __CORE_IO_URING__
+                    if (_ring != nullptr) {
+                        Disarm(entry);
+                    }
+                    else
+                    #endif
+                    if (entry.events != 0) {
+                        ::epoll_ctl(_epoll, EPOLL_CTL_DEL, entry.descriptor, nullptr);
+                    }
+                    index = _entries.erase(index);
+                }
+                #ifdef __CORE_IO_URING__
+                else if (_ring != nullptr) {
+                    const Core::IResource::handle descriptor = index->first->Descriptor();
+
+                    if ((descriptor != entry.descriptor) || (events != entry.events)) {
+                        Disarm(entry);
+                    }
+
+                    // A poll fires only once, it is armed again after every completion.
+                    if (entry.token == CancelToken) {
+                        entry.token = ++_token;
+                        entry.descriptor = descriptor;
+                        entry.events = events;
+                        _tokens.emplace(entry.token, index->first);
+                        _ring->Poll(descriptor, events, entry.token);
+                    }
+                    index++;
+                }
+                #endif
+                else {
+                    const Core::IResource::handle descriptor = index->first->Descriptor();
+
+                    if ((descriptor != entry.descriptor) || (events != entry.events)) {
+                        struct epoll_event event;
+                        event.events = events;
+                        event.data.ptr = index->first;
+
+                        if ((descriptor != entry.descriptor) && (entry.events != 0)) {
+                            ::epoll_ctl(_epoll, EPOLL_CTL_DEL, entry.descriptor, nullptr);
+                            entry.events = 0;
+                        }
+
+                        if (::epoll_ctl(_epoll, (entry.events == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD), descriptor, &event) == 0) {
+                            entry.descriptor = descriptor;
+                            entry.events = events;
+                        }
+                        else {
+                            TRACE_L1("epoll_ctl failed for descriptor %d with error <%d>", descriptor, errno);
+                        }
+                    }
+                    index++;
+                }
+
+                return (index);
+            }
+            void Dispatch(const int count)
+            {
+                for (int slot = 0; slot < count; slot++) {
+                    RESOURCE* resource = static_cast<RESOURCE*>(_events[slot].data.ptr);
+
+                    if (resource == nullptr) {
+                        uint64_t value;
+                        ssize_t VARIABLE_IS_NOT_USED bytes = ::read(_signal, &value, sizeof(value));
+                    }
+                    else {
+                        typename Entries::iterator index(_entries.find(resource));
+
+                        if (index != _entries.end()) {
+                            index->second.revents = static_cast<uint16_t>(_events[slot].events);
+                            index->second.signalled = true;
+                            Queue(index);
+                        }
+                    }
+                }
+
+                Handle();
+            }
+            void Queue(typename Entries::iterator& index)
+            {
+                if ((index->second.alive == true) && (index->second.queued == false)) {
+                    index->second.queued = true;
+                    _ready.push_back(index->first);
+                }
+            }
+            void Handle()
+            {
+                bool all;
+
+                // Resources registered while we waited can be broken already.
+                Adopt();
+
+                _pendingLock.Lock();
+
+                all = _breakAll;
+                _breakAll = false;
+
+                for (RESOURCE* resource : _breaks) {
+                    typename Entries::iterator index(_entries.find(resource));
+
+                    if (index != _entries.end()) {
+                        Queue(index);
+                    }
+                }
+
+                _breaks.clear();
+
+                _pendingLock.Unlock();
+
+                if (all == true) {
+                    // A break was issued, all resources get a chance to act, even if no flags are set,
+                    // and they will all be asked for their Events() again in the next cycle.
+                    for (std::pair<RESOURCE* const, Entry>& entry : _entries) {
+                        if (_retiring == true) {
+                            Drop();
+                        }
+                        if (entry.second.alive == true) {
+                            Handle(*entry.first, entry.second);
+                        }
+                        entry.second.queued = false;
+                    }
+                    _reevaluate = true;
+                }
+                else {
+                    for (RESOURCE* resource : _ready) {
+                        if (_retiring == true) {
+                            Drop();
+                        }
+
+                        typename Entries::iterator index(_entries.find(resource));
+
+                        // The entry might have been removed from observing in the mean time...
+                        if ((index != _entries.end()) && (index->second.queued == true)) {
+                            index->second.queued = false;
+
+                            if (index->second.alive == true) {
+                                Handle(*resource, index->second);
+                                _dirty.push_back(resource);
+                            }
+                        }
+                    }
+                }
+
+                _ready.clear();
+            }
+            #ifdef __CORE_IO_URING__
+            bool Disarm(Entry& entry)
+            {
+                bool cancelled = false;
+
+                if (entry.token != CancelToken) {
+                    _tokens.erase(entry.token);
+                    _ring->Cancel(entry.token);
+                    entry.token = CancelToken;
+                    cancelled = true;
+                }
+
+                return (cancelled);
+            }
+            void Complete(const uint16_t count)
+            {
+                for (uint16_t slot = 0; slot < count; slot++) {
+                    const CompletionRing::Completion& completion(_completions[slot]);
+
+                    if (completion.Token == BreakToken) {
+                        _ring->Read(_signal, &_signalled, sizeof(_signalled), BreakToken);
+                    }
+                    else if (completion.Token != CancelToken) {
+                        typename Tokens::iterator token(_tokens.find(completion.Token));
+
+                        // Polls that were cancelled in the mean time are not known anymore.
+                        if (token != _tokens.end()) {
+                            typename Entries::iterator index(_entries.find(token->second));
+
+                            _tokens.erase(token);
+
+                            if (index != _entries.end()) {
+                                index->second.token = CancelToken;
+
+                                if (completion.Result >= 0) {
+                                    index->second.revents = static_cast<uint16_t>(completion.Result);
+                                    index->second.signalled = true;
+                                    Queue(index);
+                                }
+                                else if ((completion.Result == -EINTR) || (completion.Result == -EAGAIN) || (completion.Result == -ENOMEM)) {
+                                    // Nothing wrong with the descriptor, the next Evaluate() arms the poll again.
+                                    _dirty.push_back(index->first);
+                                }
+                                else {
+                                    TRACE_L1("poll failed for descriptor %d with error <%d>", index->second.descriptor, -completion.Result);
+
+                                    // The descriptor can not be watched anymore, report it as broken so the
+                                    // resource gets the chance to close. It is asked for its Events() after.
+                                    index->second.revents = (POLLERR | POLLHUP);
+                                    index->second.signalled = true;
+                                    Queue(index);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                Handle();
+            }
+            #endif
+            void Handle(RESOURCE& resource, Entry& entry)
+            {
+                const uint16_t flagsSet = (entry.signalled == true ? entry.revents : 0);
+
+                entry.signalled = false;
+
+                _parent.Arm();
+
+                resource.Handle(flagsSet);
+
+                _parent.Reset();
+            }
+
+        private:
+            Parent& _parent;
+            mutable Core::CriticalSection _lock;
+            Core::CriticalSection _pendingLock;
+            Entries _entries;
+            std::vector<RESOURCE*> _pending;
+            std::vector<Retirement> _retired;
+            std::vector<RESOURCE*> _breaks;
+            std::vector<RESOURCE*> _ready;
+            std::vector<RESOURCE*> _dirty;
+            std::vector<RESOURCE*> _evaluating;
+            bool _breakAll;
+            std::atomic<bool> _retiring;
+            std::atomic<Reactor*> _awaiting;
+            bool _reevaluate;
+            uint32_t _runs;
+            std::atomic<uint32_t> _count;
+            int _epoll;
+            int _signal;
+            struct epoll_event _events[BatchSize];
+            #ifdef __CORE_IO_URING__
+            CompletionRing* _ring;
+            Tokens _tokens;
+            uint64_t _token;
+            uint64_t _signalled;
+            CompletionRing::Completion _completions[BatchSize];
+            #endif
+        };
+        #endif
+
     public:
         ResourceMonitorType(ResourceMonitorType&&) = delete;
         ResourceMonitorType(const ResourceMonitorType&) = delete;
@@ -122,6 +883,11 @@ namespace Core {
             , _descriptorArray(static_cast<struct pollfd*>(::malloc(sizeof(::pollfd) * (RESOURCE_SLOTS + 1))))
             , _signalDescriptor(-1)
             #endif
+            #ifdef __CORE_RESOURCE_REACTORS__
+            , _reactorCount(0)
+            , _reacting(false)
+            , _reactors()
+            #endif
         {
         }
 
@@ -150,6 +916,12 @@ namespace Core {
                 delete _monitor;
             }
 
+            #ifdef __CORE_RESOURCE_REACTORS__
+            for (Reactor* reactor : _reactors) {
+                delete reactor;
+            }
+            #endif
+
             #ifdef __LINUX__
             ::free(_descriptorArray);
             if (_signalDescriptor != -1) {
@@ -168,20 +940,119 @@ namespace Core {
         }
         uint32_t Runs() const
         {
-            return (_monitorRuns);
+            uint32_t runs = _monitorRuns;
+
+            #ifdef __CORE_RESOURCE_REACTORS__
+            if (_reacting == true) {
+                for (const Reactor* reactor : _reactors) {
+                    runs += reactor->Runs();
+                }
+            }
+            #endif
+
+            return (runs);
         }
         ::ThreadId Id() const
         {
+            #ifdef __CORE_RESOURCE_REACTORS__
+            if (_reacting == true) {
+                return (_reactors.front()->Id());
+            }
+            #endif
+
             return (_monitor != nullptr ? _monitor->Id() : 0);
         }
+        bool IsMonitorThread() const
+        {
+            const ::ThreadId current = Thread::ThreadId();
+
+            #ifdef __CORE_RESOURCE_REACTORS__
+            if (_reacting == true) {
+                for (const Reactor* reactor : _reactors) {
+                    if (reactor->Id() == current) {
+                        return (true);
+                    }
+                }
+            }
+            #endif
+
+            return ((_monitor != nullptr) && (_monitor->Id() == current));
+        }
         uint32_t Count() const 
         {
+            #ifdef __CORE_RESOURCE_REACTORS__
+            if (_reacting == true) {
+                uint32_t count = 0;
+
+                for (const Reactor* reactor : _reactors) {
+                    count += reactor->Count();
+                }
+
+                return (count);
+            }
+            #endif
+
             return (static_cast<uint32_t>(_resources.size()));
         }
+        uint8_t Reactors() const
+        {
+            #ifdef __CORE_RESOURCE_REACTORS__
+            return (_reactorCount);
+            #else
+            return (0);
+            #endif
+        }
+        // Switch between the single threaded poll() based monitor (count == 0) and the epoll() based
+        // monitor with count reactor threads. Built with IO_URING, the reactors use io_uring instead
+        // if the kernel offers it. The reactors are only started once the first resource
+        // is registered. This can only be done as long as nothing is registered.
+        uint32_t Reactors(const uint8_t count)
+        {
+            uint32_t result = Core::ERROR_NOT_SUPPORTED;
+
+            #ifdef __CORE_RESOURCE_REACTORS__
+            _adminLock.Lock();
+
+            if ((_resources.empty() == false) || (Count() != 0)) {
+                result = Core::ERROR_ILLEGAL_STATE;
+            }
+            else {
+                _reacting = false;
+
+                for (Reactor* reactor : _reactors) {
+                    delete reactor;
+                }
+
+                _reactors.clear();
+                _reactorCount = count;
+
+                result = Core::ERROR_NONE;
+            }
+
+            _adminLock.Unlock();
+            #else
+            if (count == 0) {
+                result = Core::ERROR_NONE;
+            }
+            #endif
+
+            return (result);
+        }
         bool Info (const uint32_t position, Metadata& info) const
         {
             uint32_t count = position;
 
+            #ifdef __CORE_RESOURCE_REACTORS__
+            if (_reactorCount != 0) {
+                for (const Reactor* reactor : _reactors) {
+                    if ((_reacting == true) && (reactor->Info(count, info) == true)) {
+                        return (true);
+                    }
+                }
+                return (false);
+            }
+            #endif
+
             _adminLock.Lock();
 
             typename Resources::const_iterator index(_resources.cbegin());
@@ -216,6 +1087,32 @@ namespace Core {
         }
         void Register(RESOURCE& resource)
         {
+            Register(resource, AnyReactor);
+        }
+        // With reactors, the resource is handled by the given reactor (modulo the number of reactors)
+        // instead of the one picked by its address. It must be unregistered with the same reactor.
+        void Register(RESOURCE& resource, const uint8_t reactor VARIABLE_IS_NOT_USED)
+        {
+            #ifdef __CORE_RESOURCE_REACTORS__
+            if (_reactorCount != 0) {
+                if (_reacting == false) {
+                    _adminLock.Lock();
+
+                    if (_reacting == false) {
+                        for (uint8_t index = 0; index < _reactorCount; index++) {
+                            _reactors.push_back(new Reactor(*this, _name + _T("::") + Core::NumberType<uint8_t>(index).Text()));
+                        }
+                        _reacting = true;
+                    }
+
+                    _adminLock.Unlock();
+                }
+
+                _reactors[Shard(resource, reactor)]->Register(resource);
+                return;
+            }
+            #endif
+
             _adminLock.Lock();
 
             // Make sure this entry is only registered once !!!
@@ -240,6 +1137,27 @@ namespace Core {
         }
         void Unregister(RESOURCE& resource)
         {
+            Unregister(resource, AnyReactor);
+        }
+        void Unregister(RESOURCE& resource, const uint8_t reactor VARIABLE_IS_NOT_USED)
+        {
+            #ifdef __CORE_RESOURCE_REACTORS__
+            if (_reactorCount != 0) {
+                if (_reacting == true) {
+                    Reactor* owner = _reactors[Shard(resource, reactor)];
+                    Reactor* caller = OtherReactor(*owner);
+
+                    if (caller != nullptr) {
+                        owner->Retire(resource, *caller);
+                    }
+                    else {
+                        owner->Unregister(resource);
+                    }
+                }
+                return;
+            }
+            #endif
+
             _adminLock.Lock();
 
             // Make sure this entry does not exist, only register resources once !!!
@@ -254,6 +1172,17 @@ namespace Core {
         }
         inline void Break()
         {
+            #ifdef __CORE_RESOURCE_REACTORS__
+            if (_reactorCount != 0) {
+                if (_reacting == true) {
+                    for (Reactor* reactor : _reactors) {
+                        reactor->Break();
+                    }
+                }
+                return;
+            }
+            #endif
+
             ASSERT(_monitor != nullptr);
 
             #ifdef __APPLE__
@@ -269,8 +1198,57 @@ namespace Core {
             ::WSASetEvent(_action);
             #endif
         };
+        void Break(RESOURCE& resource)
+        {
+            Break(resource, AnyReactor);
+        }
+        // With reactors, only the reactor of the resource wakes up and only this resource is handled
+        // and asked for its Events() again. Without, this is the same as a Break().
+        void Break(RESOURCE& resource VARIABLE_IS_NOT_USED, const uint8_t reactor VARIABLE_IS_NOT_USED)
+        {
+            #ifdef __CORE_RESOURCE_REACTORS__
+            if (_reactorCount != 0) {
+                if (_reacting == true) {
+                    _reactors[Shard(resource, reactor)]->Break(resource);
+                }
+                return;
+            }
+            #endif
+
+            Break();
+        }
 
     private:
+        #ifdef __CORE_RESOURCE_REACTORS__
+        uint8_t Shard(const RESOURCE& resource, const uint8_t reactor) const
+        {
+            if (reactor != AnyReactor) {
+                return (static_cast<uint8_t>(reactor % _reactors.size()));
+            }
+
+            // Spread the resources over the reactors based on their address, a resource always
+            // lands on the same reactor so no bookkeeping is needed to find it back.
+            uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&resource));
+            key = (key ^ (key >> 33)) * 0xFF51AFD7ED558CCDULL;
+            key = key ^ (key >> 33);
+
+            return (static_cast<uint8_t>(key % _reactors.size()));
+        }
+        // The reactor we are running on, if that is not the owner.
+        Reactor* OtherReactor(const Reactor& owner) const
+        {
+            const ::ThreadId current = Thread::ThreadId();
+
+            for (Reactor* reactor : _reactors) {
+                if ((reactor != &owner) && (reactor->Id() == current)) {
+                    return (reactor);
+                }
+            }
+
+            return (nullptr);
+        }
+        #endif
+
         IS_MEMBER_AVAILABLE(Arm, hasArm);
 
         template <typename TYPE=WATCHDOG>
@@ -415,13 +1393,14 @@ namespace Core {
 
                 // We are only interested in the filedescriptors that have a corresponding client.
                 // We also know that once a file descriptor is not found, we handled them all...
+                // Resources registered while handling (e.g. accepted clients) are appended and may
+                // move the vector, so it is walked by position rather than by iterator.
                 int fd_index = 1;
-                index = _resources.begin();
 
                 while (fd_index < filledFileDescriptors) {
-                    ASSERT(index != _resources.end());
+                    ASSERT(static_cast<size_t>(fd_index - 1) < _resources.size());
 
-                    RESOURCE* entry = (*index);
+                    RESOURCE* entry = _resources[fd_index - 1];
 
                     // The entry might have been removed from observing in the mean time...
                     if (entry != nullptr) {
@@ -440,7 +1419,6 @@ namespace Core {
                         Reset();
                     }
 
-                    index++;
                     fd_index++;
                 }
             } else {
@@ -549,6 +1527,12 @@ namespace Core {
         #ifdef __APPLE__
         Core::NodeId _signalNode;
         #endif
+
+        #ifdef __CORE_RESOURCE_REACTORS__
+        uint8_t _reactorCount;
+        std::atomic<bool> _reacting;
+        std::vector<Reactor*> _reactors;
+        #endif
     };
 
     #ifdef WATCHDOG_ENABLED
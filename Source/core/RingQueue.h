@@ -0,0 +1,474 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
+
+#include "Module.h"
+#include "Sync.h"
+
+namespace WPEFramework {
+namespace Core {
+
+    // -------------------------------------------------------------------
+    // Multi-producer/multi-consumer queue with the same interface as the
+    // QueueType. The entries are spread over a number of shards, each a
+    // preallocated ring with its own lock, so producers and consumers only
+    // contend if they hit the same shard and no node is allocated per entry.
+    // Threads only block (on a semaphore) if the queue is empty or full.
+    // The ordering is FIFO per shard, and close to FIFO over all shards as
+    // producers and consumers walk the shards in the same round-robin order.
+    // -------------------------------------------------------------------
+    template <typename CONTEXT>
+    class RingQueueType {
+    private:
+        static constexpr uint8_t MaxShards = 8;
+
+        class Shard {
+        public:
+            Shard(const Shard&) = delete;
+            Shard& operator=(const Shard&) = delete;
+
+            Shard()
+                : _adminLock()
+                , _slots()
+                , _head(0)
+                , _length(0)
+                , _overflow()
+            {
+            }
+            ~Shard() = default;
+
+        public:
+            void Size(const uint32_t slots)
+            {
+                _slots.resize(slots);
+            }
+            void Lock() const
+            {
+                _adminLock.Lock();
+            }
+            void Unlock() const
+            {
+                _adminLock.Unlock();
+            }
+            // Post() may exceed the highwatermark, those entries are parked in
+            // the overflow list until the ring has room again.
+            void Push(const CONTEXT& entry)
+            {
+                if ((_overflow.empty() == true) && (_length < _slots.size())) {
+                    _slots[Slot(_length)] = entry;
+                    _length++;
+                } else {
+                    _overflow.push_back(entry);
+                }
+            }
+            bool Pop(CONTEXT& result)
+            {
+                bool popped = (_length != 0);
+
+                if (popped == true) {
+                    result = _slots[_head];
+                    _slots[_head] = CONTEXT();
+                    _head = Slot(1);
+                    _length--;
+
+                    Refill();
+                }
+
+                return (popped);
+            }
+            bool Remove(const CONTEXT& entry)
+            {
+                bool removed = true;
+                uint32_t index = Find(entry);
+
+                if (index < _length) {
+                    // Close the gap, the remaining entries keep their order.
+                    while ((index + 1) < _length) {
+                        _slots[Slot(index)] = _slots[Slot(index + 1)];
+                        index++;
+                    }
+                    _length--;
+                    _slots[Slot(_length)] = CONTEXT();
+
+                    Refill();
+                } else {
+                    typename std::list<CONTEXT>::iterator position = std::find(_overflow.begin(), _overflow.end(), entry);
+
+                    if (position != _overflow.end()) {
+                        _overflow.erase(position);
+                    } else {
+                        removed = false;
+                    }
+                }
+
+                return (removed);
+            }
+            bool HasEntry(const CONTEXT& entry) const
+            {
+                return ((Find(entry) < _length) || (std::find(_overflow.cbegin(), _overflow.cend(), entry) != _overflow.cend()));
+            }
+            template <typename ACTION>
+            void Visit(ACTION&& action) const
+            {
+                for (uint32_t index = 0; index < _length; index++) {
+                    action(_slots[Slot(index)]);
+                }
+                for (const CONTEXT& entry : _overflow) {
+                    action(entry);
+                }
+            }
+            void Clear()
+            {
+                while (_length != 0) {
+                    _slots[_head] = CONTEXT();
+                    _head = Slot(1);
+                    _length--;
+                }
+                _overflow.clear();
+            }
+
+        private:
+            uint32_t Slot(const uint32_t offset) const
+            {
+                return ((_head + offset) % static_cast<uint32_t>(_slots.size()));
+            }
+            uint32_t Find(const CONTEXT& entry) const
+            {
+                uint32_t index = 0;
+
+                while ((index < _length) && (_slots[Slot(index)] != entry)) {
+                    index++;
+                }
+
+                return (index);
+            }
+            void Refill()
+            {
+                if (_overflow.empty() == false) {
+                    _slots[Slot(_length)] = _overflow.front();
+                    _overflow.pop_front();
+                    _length++;
+                }
+            }
+
+        private:
+            mutable CriticalSection _adminLock;
+            std::vector<CONTEXT> _slots;
+            uint32_t _head;
+            uint32_t _length;
+            std::list<CONTEXT> _overflow;
+        };
+
+    public:
+        RingQueueType() = delete;
+        RingQueueType(const RingQueueType<CONTEXT>&) = delete;
+        RingQueueType& operator=(const RingQueueType<CONTEXT>&) = delete;
+
+        explicit RingQueueType(const uint32_t highWaterMark, const uint8_t shards = 0)
+            : _shards(nullptr)
+            , _count(shards != 0 ? shards : DefaultShards())
+            , _maxSlots(highWaterMark)
+            , _entries(0, std::numeric_limits<int32_t>::max())
+            , _space(0, std::numeric_limits<int32_t>::max())
+            , _length(0)
+            , _producer(0)
+            , _consumer(0)
+            , _waitingConsumers(0)
+            , _waitingProducers(0)
+            , _enabled(true)
+        {
+            // A highwatermark of 0 is bullshit.
+            ASSERT(_maxSlots != 0);
+
+            if (_count > _maxSlots) {
+                _count = static_cast<uint8_t>(_maxSlots);
+            }
+
+            _shards = new Shard[_count];
+
+            for (uint8_t index = 0; index < _count; index++) {
+                _shards[index].Size((_maxSlots + _count - 1) / _count);
+            }
+
+            TRACE_L5("Constructor RingQueueType <%p>", (this));
+        }
+        ~RingQueueType()
+        {
+            TRACE_L5("Destructor RingQueueType <%p>", (this));
+
+            // Disable the queue and flush all entries.
+            Disable();
+
+            delete[] _shards;
+        }
+
+    public:
+        bool Remove(const CONTEXT& entry)
+        {
+            bool removed = false;
+
+            if (_enabled == true) {
+                uint8_t index = 0;
+
+                while ((removed == false) && (index < _count)) {
+                    _shards[index].Lock();
+                    removed = _shards[index].Remove(entry);
+                    _shards[index].Unlock();
+                    index++;
+                }
+
+                if (removed == true) {
+                    Released();
+                }
+            }
+
+            return (removed);
+        }
+        bool Post(const CONTEXT& entry)
+        {
+            bool result = (_enabled == true);
+
+            if (result == true) {
+                // Posting never blocks, if needed we go beyond the highwatermark.
+                _length++;
+                Push(entry);
+            }
+
+            return (result);
+        }
+        bool Insert(const CONTEXT& entry, const uint32_t waitTime)
+        {
+            bool posted = false;
+            bool triggered = true;
+
+            while ((posted == false) && (triggered == true) && (_enabled == true)) {
+                if (Reserve() == true) {
+                    Push(entry);
+                    posted = true;
+                } else {
+                    _waitingProducers++;
+
+                    // Check again, now that the consumers know we are waiting.
+                    if ((_length >= _maxSlots) && (_enabled == true)) {
+                        triggered = (_space.Lock(waitTime) == ERROR_NONE);
+                    }
+
+                    _waitingProducers--;
+                }
+            }
+
+            return (posted);
+        }
+        bool Extract(CONTEXT& result, const uint32_t waitTime)
+        {
+            bool received = false;
+            bool triggered = true;
+
+            while ((received == false) && (triggered == true) && (_enabled == true)) {
+                received = Pop(result);
+
+                if (received == false) {
+                    _waitingConsumers++;
+
+                    // Check again, now that the producers know we are waiting.
+                    if (_enabled == true) {
+                        received = Pop(result);
+
+                        if (received == false) {
+                            triggered = (_entries.Lock(waitTime) == ERROR_NONE);
+                        }
+                    }
+
+                    _waitingConsumers--;
+                }
+            }
+
+            return (received);
+        }
+        void Enable()
+        {
+            _enabled = true;
+        }
+        void Disable()
+        {
+            if (_enabled.exchange(false) == true) {
+                // Wake up everyone that is waiting, they will see we are disabled.
+                uint32_t waiting = _waitingConsumers;
+                if (waiting != 0) {
+                    _entries.Unlock(waiting);
+                }
+                waiting = _waitingProducers;
+                if (waiting != 0) {
+                    _space.Unlock(waiting);
+                }
+            }
+        }
+        void Flush()
+        {
+            // Clear is only possible in a "DISABLED" state !!
+            ASSERT(_enabled == false);
+
+            for (uint8_t index = 0; index < _count; index++) {
+                _shards[index].Lock();
+                _shards[index].Clear();
+                _shards[index].Unlock();
+            }
+
+            _length = 0;
+        }
+        bool IsEmpty() const
+        {
+            return (_length == 0);
+        }
+        bool IsFull() const
+        {
+            return (_length >= _maxSlots);
+        }
+        uint32_t Length() const
+        {
+            return (_length);
+        }
+        uint8_t Shards() const
+        {
+            return (_count);
+        }
+        // void action(const CONTEXT& element)
+        template <typename ACTION>
+        void Visit(ACTION&& action) const
+        {
+            Lock();
+            for (uint8_t index = 0; index < _count; index++) {
+                _shards[index].Visit(action);
+            }
+            Unlock();
+        }
+        bool HasEntry(const CONTEXT& element) const
+        {
+            bool found = false;
+            uint8_t index = 0;
+
+            while ((found == false) && (index < _count)) {
+                _shards[index].Lock();
+                found = _shards[index].HasEntry(element);
+                _shards[index].Unlock();
+                index++;
+            }
+
+            return (found);
+        }
+        // Locks all shards, nothing is added or taken out until Unlock().
+        void Lock() const
+        {
+            for (uint8_t index = 0; index < _count; index++) {
+                _shards[index].Lock();
+            }
+        }
+        void Unlock() const
+        {
+            uint8_t index = _count;
+            while (index != 0) {
+                index--;
+                _shards[index].Unlock();
+            }
+        }
+
+    private:
+        static uint8_t DefaultShards()
+        {
+            const uint32_t cores = std::thread::hardware_concurrency();
+
+            return (cores == 0 ? 1 : static_cast<uint8_t>(std::min(cores, static_cast<uint32_t>(MaxShards))));
+        }
+        bool Reserve()
+        {
+            uint32_t current = _length;
+
+            while ((current < _maxSlots) && (_length.compare_exchange_weak(current, current + 1) == false)) {
+                // current is reloaded by the failing exchange, try again.
+            }
+
+            return (current < _maxSlots);
+        }
+        void Push(const CONTEXT& entry)
+        {
+            // The slot is already accounted for in _length.
+            Shard& shard(_shards[_producer++ % _count]);
+
+            shard.Lock();
+            shard.Push(entry);
+            shard.Unlock();
+
+            if (_waitingConsumers != 0) {
+                _entries.Unlock();
+            }
+        }
+        bool Pop(CONTEXT& result)
+        {
+            bool popped = false;
+
+            if (_length != 0) {
+                const uint8_t start = static_cast<uint8_t>(_consumer++ % _count);
+                uint8_t index = 0;
+
+                while ((popped == false) && (index < _count)) {
+                    Shard& shard(_shards[(start + index) % _count]);
+
+                    shard.Lock();
+                    popped = shard.Pop(result);
+                    shard.Unlock();
+                    index++;
+                }
+
+                if (popped == true) {
+                    Released();
+                }
+            }
+
+            return (popped);
+        }
+        void Released()
+        {
+            _length--;
+
+            if (_waitingProducers != 0) {
+                _space.Unlock();
+            }
+        }
+
+    private:
+        Shard* _shards;
+        uint8_t _count;
+        const uint32_t _maxSlots;
+        CountingSemaphore _entries;
+        CountingSemaphore _space;
+        std::atomic<uint32_t> _length;
+        std::atomic<uint32_t> _producer;
+        std::atomic<uint32_t> _consumer;
+        std::atomic<uint32_t> _waitingConsumers;
+        std::atomic<uint32_t> _waitingProducers;
+        std::atomic<bool> _enabled;
+    };
+}
+} // namespace Core
@@ -614,7 +614,7 @@ namespace Core {
             // subscribtion.
             _state |= SerialPort::EXCEPTION;
             _state &= ~SerialPort::OPEN;
-            ResourceMonitor::Instance().Break();
+            ResourceMonitor::Instance().Break(*this);
         } 
 #endif
 
@@ -680,7 +680,7 @@ namespace Core {
 #else
     if ((_state & (SerialPort::OPEN | SerialPort::EXCEPTION | SerialPort::WRITESLOT)) == SerialPort::OPEN) {
         _state |= SerialPort::WRITESLOT;
-        ResourceMonitor::Instance().Break();
+        ResourceMonitor::Instance().Break(*this);
     }
 #endif
 
@@ -30,6 +30,7 @@
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <net/if.h>
+#include <sys/uio.h>
 #define __ERRORRESULT__ errno
 #define __ERROR_AGAIN__ EAGAIN
 #define __ERROR_WOULDBLOCK__ EWOULDBLOCK
@@ -43,7 +44,9 @@
 #include <sys/event.h>
 #elif defined(__LINUX__)
 #include <signal.h>
+#include <linux/errqueue.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <sys/signalfd.h>
 #ifdef SYSTEMD_FOUND
 #include <systemd/sd-daemon.h>
@@ -346,6 +349,15 @@ namespace WPEFramework {
             , m_SendOffset(0)
             , m_Interface(~0)
             , m_SystemdSocket(false)
+            , m_SegmentCount(0)
+            , m_SegmentIndex(0)
+            , m_SegmentOffset(0)
+            , m_ZeroCopy(false)
+            , m_ZeroCopySent(0)
+            , m_ZeroCopyDone(0)
+            , m_Region()
+            , m_ReusePort(false)
+            , m_Affinity(ResourceMonitor::AnyReactor)
         {
             TRACE_L5("Constructor SocketPort (NodeId&) <%p>", (this));
         }
@@ -386,6 +398,15 @@ namespace WPEFramework {
             , m_SendOffset(0)
             , m_Interface(~0)
             , m_SystemdSocket(false)
+            , m_SegmentCount(0)
+            , m_SegmentIndex(0)
+            , m_SegmentOffset(0)
+            , m_ZeroCopy(false)
+            , m_ZeroCopySent(0)
+            , m_ZeroCopyDone(0)
+            , m_Region()
+            , m_ReusePort(false)
+            , m_Affinity(ResourceMonitor::AnyReactor)
         {
             NodeId::SocketInfo localAddress;
             socklen_t localSize = sizeof(localAddress);
@@ -473,6 +494,32 @@ namespace WPEFramework {
             return (true);
         }
 
+        bool SocketPort::ZeroCopy(const bool enabled VARIABLE_IS_NOT_USED)
+        {
+            m_syncAdmin.Lock();
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+            uint32_t flag = (enabled ? 1 : 0);
+
+            if ((m_Socket == INVALID_SOCKET) || ((m_State & SocketPort::LINK) == 0)) {
+                m_ZeroCopy = false;
+            }
+            else if (::setsockopt(m_Socket, SOL_SOCKET, SO_ZEROCOPY, reinterpret_cast<char*>(&flag), sizeof(flag)) != 0) {
+                TRACE_L1("Error: Could not set zero copy option on socket, error: %d\n", __ERRORRESULT__);
+                m_ZeroCopy = false;
+            }
+            else {
+                m_ZeroCopy = enabled;
+            }
+#else
+            m_ZeroCopy = false;
+#endif
+
+            m_syncAdmin.Unlock();
+
+            return (m_ZeroCopy);
+        }
+
         /* virtual */ uint32_t SocketPort::Initialize()
         {
             return (Core::ERROR_NONE);
@@ -494,6 +541,11 @@ namespace WPEFramework {
             else {
                 ASSERT((m_Socket == INVALID_SOCKET) && (m_State.load(Core::memory_order::memory_order_relaxed) == 0));
 
+                // A new socket, zero copy has to be asked for again.
+                m_ZeroCopy = false;
+                m_ZeroCopySent = 0;
+                m_ZeroCopyDone = 0;
+
                 if ((m_SocketType == SocketPort::STREAM) || (m_SocketType == SocketPort::SEQUENCED) || (m_SocketType == SocketPort::RAW)) {
                     if (m_LocalNode.IsValid() == false) {
                         m_LocalNode = m_RemoteNode.Origin();
@@ -559,7 +611,7 @@ namespace WPEFramework {
 
             if ((nStatus == Core::ERROR_NONE) || (nStatus == Core::ERROR_INPROGRESS)) {
 
-                ResourceMonitor::Instance().Register(*this);
+                ResourceMonitor::Instance().Register(*this, m_Affinity);
 
                 if (nStatus == Core::ERROR_INPROGRESS) {
                     if (waitTime > 0) {
@@ -613,7 +665,7 @@ namespace WPEFramework {
 #endif
                     }
 
-                    ResourceMonitor::Instance().Break();
+                    ResourceMonitor::Instance().Break(*this, m_Affinity);
                 } else {
                     TRACE_L3("Socket is already closed or being closed");
                 }
@@ -627,7 +679,7 @@ namespace WPEFramework {
 
                         // We probably did not get a response from the otherside on the close
                         // sloppy but let's forcefully close it
-                        ResourceMonitor::Instance().Break();
+                        ResourceMonitor::Instance().Break(*this, m_Affinity);
 
                         closed = (WaitForClosure(Core::infinite) == Core::ERROR_NONE);
 
@@ -650,7 +702,7 @@ namespace WPEFramework {
             if ((m_State & (SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) {
 
                 m_State |= SocketPort::WRITESLOT;
-                ResourceMonitor::Instance().Break();
+                ResourceMonitor::Instance().Break(*this, m_Affinity);
             }
             m_syncAdmin.Unlock();
         }
@@ -793,6 +845,11 @@ namespace WPEFramework {
                 if (::setsockopt(l_Result, SOL_SOCKET, SO_REUSEADDR, (const char*)&optval, optionLength) < 0) {
                     TRACE_L1("Error on setting SO_REUSEADDR option. Error %d: %s", __ERRORRESULT__, strerror(__ERRORRESULT__));
                 }
+#ifdef SO_REUSEPORT
+                if ((m_ReusePort == true) && (m_SocketType == SocketPort::LISTEN) && (::setsockopt(l_Result, SOL_SOCKET, SO_REUSEPORT, (const char*)&optval, optionLength) < 0)) {
+                    TRACE_L1("Error on setting SO_REUSEPORT option. Error %d: %s", __ERRORRESULT__, strerror(__ERRORRESULT__));
+                }
+#endif
             }
 
 #ifndef __WINDOWS__
@@ -1088,6 +1145,15 @@ namespace WPEFramework {
                     }
                 }
                 else if (IsOpen()) {
+                    if (((flagsSet & POLLERR) != 0) && (m_ZeroCopySent != m_ZeroCopyDone)) {
+                        m_syncAdmin.Lock();
+                        Completed();
+                        Settle();
+                        m_syncAdmin.Unlock();
+
+                        // Released segments make room for the next ones.
+                        breakIssued = true;
+                    }
                     if (((flagsSet & POLLOUT) != 0) || (breakIssued == true)) {
                         Write();
                     }
@@ -1119,15 +1185,50 @@ namespace WPEFramework {
             m_State &= (~(SocketPort::WRITE | SocketPort::WRITESLOT));
 
             while (((m_State & (SocketPort::WRITE | SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) && (dataLeftToSend == true)) {
-                if (m_SendOffset == m_SendBytes) {
-                    m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
-                    m_SendOffset = 0;
-                    dataLeftToSend = (m_SendOffset != m_SendBytes);
+                if ((m_SendOffset == m_SendBytes) && (m_SegmentIndex == m_SegmentCount) && (m_Region.Length == 0)) {
+                    // Segments still referred to by the kernel are not handed out again, meanwhile the
+                    // send buffer can still go.
+                    if ((m_SegmentCount == 0) && ((m_State & SocketPort::LINK) != 0)) {
+                        m_SegmentCount = SendSegments(m_Segments, MaxSegments);
+                        m_SegmentIndex = 0;
+                        m_SegmentOffset = 0;
+
+                        ASSERT(m_SegmentCount <= MaxSegments);
+                    }
+
+#if defined(__LINUX__) && !defined(__APPLE__)
+                    if ((m_SegmentIndex == m_SegmentCount) && ((m_State & SocketPort::LINK) != 0) && (SendFile(m_Region) == false)) {
+                        m_Region.Length = 0;
+                    }
+#endif
+
+                    if ((m_SegmentIndex == m_SegmentCount) && (m_Region.Length == 0)) {
+                        m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
+                        m_SendOffset = 0;
+                        dataLeftToSend = (m_SendOffset != m_SendBytes);
 
-                    ASSERT(m_SendBytes <= m_SendBufferSize);
+                        ASSERT(m_SendBytes <= m_SendBufferSize);
+                    }
                 }
 
-                if (dataLeftToSend == true) {
+                if ((m_SegmentIndex != m_SegmentCount) || (m_Region.Length != 0)) {
+                    if ((m_SegmentIndex != m_SegmentCount ? WriteSegments() : WriteRegion()) < 0) {
+                        uint32_t l_Result = __ERRORRESULT__;
+
+                        if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__)) {
+                            m_State |= SocketPort::WRITE;
+                        }
+                        else {
+                            printf("Write exception %d: %s\n", l_Result, strerror(__ERRORRESULT__));
+                            m_State |= SocketPort::EXCEPTION;
+                            StateChange();
+                        }
+                    }
+                    else {
+                        Settle();
+                    }
+                }
+                else if (dataLeftToSend == true) {
                     int32_t sendSize;
 
                     // Sockets are non blocking the Send buffer size is equal to the buffer size. We only send
@@ -1167,6 +1268,150 @@ namespace WPEFramework {
             m_syncAdmin.Unlock();
         }
 
+        int32_t SocketPort::WriteSegments()
+        {
+            int32_t result = 0;
+
+#ifdef __POSIX__
+            struct iovec vector[MaxSegments];
+            uint32_t total = 0;
+            uint8_t count = 0;
+            int flags = 0;
+
+            for (uint8_t index = m_SegmentIndex; index < m_SegmentCount; index++, count++) {
+                const uint32_t skip = (index == m_SegmentIndex ? m_SegmentOffset : 0);
+
+                vector[count].iov_base = const_cast<uint8_t*>(&(m_Segments[index].Data[skip]));
+                vector[count].iov_len = m_Segments[index].Length - skip;
+                total += static_cast<uint32_t>(vector[count].iov_len);
+            }
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+            if ((m_ZeroCopy == true) && (total >= ZeroCopyThreshold)) {
+                flags |= MSG_ZEROCOPY;
+            }
+#endif
+
+            struct msghdr message;
+            ::memset(&message, 0, sizeof(message));
+            message.msg_iov = vector;
+            message.msg_iovlen = count;
+
+            result = static_cast<int32_t>(::sendmsg(m_Socket, &message, flags));
+
+            if (result >= 0) {
+                uint32_t written = static_cast<uint32_t>(result);
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+                if ((flags & MSG_ZEROCOPY) != 0) {
+                    // Every successful zero copy send gets its own completion.
+                    m_ZeroCopySent++;
+                }
+#endif
+
+                // Keep track of a partial write, the next one continues halfway a segment.
+                while ((m_SegmentIndex < m_SegmentCount) && (written >= (m_Segments[m_SegmentIndex].Length - m_SegmentOffset))) {
+                    written -= (m_Segments[m_SegmentIndex].Length - m_SegmentOffset);
+                    m_SegmentOffset = 0;
+                    m_SegmentIndex++;
+                }
+                m_SegmentOffset += written;
+            }
+#else
+            // No scatter-gather here, the segments go out one by one.
+            bool partial = false;
+
+            while ((m_SegmentIndex < m_SegmentCount) && (partial == false)) {
+                const Segment& segment(m_Segments[m_SegmentIndex]);
+                const int32_t length = static_cast<int32_t>(segment.Length - m_SegmentOffset);
+
+                result = ::send(m_Socket, reinterpret_cast<const char*>(&(segment.Data[m_SegmentOffset])), length, 0);
+
+                if (result == length) {
+                    m_SegmentOffset = 0;
+                    m_SegmentIndex++;
+                }
+                else {
+                    m_SegmentOffset += (result > 0 ? result : 0);
+                    partial = true;
+                }
+            }
+#endif
+
+            return (result);
+        }
+
+        int32_t SocketPort::WriteRegion()
+        {
+            int32_t result = -1;
+
+#if defined(__LINUX__) && !defined(__APPLE__)
+            off_t offset = static_cast<off_t>(m_Region.Offset);
+
+            // The kernel moves at most 2GB in one go anyway.
+            ssize_t sent = ::sendfile(m_Socket, m_Region.Descriptor, &offset, static_cast<size_t>(std::min(m_Region.Length, static_cast<uint64_t>(0x7FFFF000))));
+
+            if (sent > 0) {
+                m_Region.Offset += sent;
+                m_Region.Length -= sent;
+                result = static_cast<int32_t>(sent);
+            }
+            else if (sent == 0) {
+                // The file got shorter than what was announced, the rest can not be sent.
+                errno = ENODATA;
+            }
+#endif
+
+            return (result);
+        }
+
+        // Reads the completions of the zero copy sends from the error queue.
+        void SocketPort::Completed()
+        {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+            uint8_t control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+            struct msghdr message;
+            bool drained = false;
+
+            while (drained == false) {
+                ::memset(&message, 0, sizeof(message));
+                message.msg_control = control;
+                message.msg_controllen = sizeof(control);
+
+                if (::recvmsg(m_Socket, &message, MSG_ERRQUEUE) < 0) {
+                    drained = true;
+                }
+                else {
+                    for (struct cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+                        const struct sock_extended_err* error = reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(header));
+
+                        if ((error->ee_errno == 0) && (error->ee_origin == SO_EE_ORIGIN_ZEROCOPY)) {
+                            // The sends ee_info up to and including ee_data have been completed.
+                            m_ZeroCopyDone += (error->ee_data - error->ee_info + 1);
+
+                            if ((error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0) {
+                                // The kernel copied anyway (loopback), no point in asking for it again.
+                                m_ZeroCopy = false;
+                            }
+                        }
+                    }
+                }
+            }
+#endif
+        }
+
+        // Hands the segments back once all is written and the kernel no longer refers to them.
+        void SocketPort::Settle()
+        {
+            if ((m_SegmentCount != 0) && (m_SegmentIndex == m_SegmentCount) && (m_ZeroCopySent == m_ZeroCopyDone)) {
+                m_SegmentCount = 0;
+                m_SegmentIndex = 0;
+                m_SegmentOffset = 0;
+
+                ReleaseSegments();
+            }
+        }
+
         void SocketPort::Read()
         {
             m_syncAdmin.Lock();
@@ -1257,8 +1502,14 @@ namespace WPEFramework {
                 result = false;
             }
             else {
+                // Nothing will be written anymore, whatever the kernel still sends is not waited for.
+                m_SegmentIndex = m_SegmentCount;
+                m_ZeroCopyDone = m_ZeroCopySent;
+                m_Region.Length = 0;
+                Settle();
+
                 DestroySocket(m_Socket);
-                ResourceMonitor::Instance().Unregister(*this);
+                ResourceMonitor::Instance().Unregister(*this, m_Affinity);
                 // Remove socket descriptor for UNIX domain datagram socket.
                 if ((m_LocalNode.Type() == NodeId::TYPE_DOMAIN) &&
                     ((m_SocketType == SocketPort::LISTEN) || (SocketMode() != SOCK_STREAM)) &&
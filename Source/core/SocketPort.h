@@ -81,6 +81,22 @@ namespace WPEFramework {
 
             } enumType;
 
+            // A reference to data that is ready to go out, handed over through SendSegments.
+            struct Segment {
+                const uint8_t* Data;
+                uint32_t Length;
+            };
+
+            // A part of a file that goes out straight from the file, handed over through SendFile.
+            struct Region {
+                int Descriptor;
+                uint64_t Offset;
+                uint64_t Length;
+            };
+
+            static constexpr uint8_t MaxSegments = 8;
+            static constexpr uint32_t ZeroCopyThreshold = 16 * 1024;
+
         public:
             SocketPort(const enumType socketType,
                 const NodeId& localNode,
@@ -215,6 +231,9 @@ namespace WPEFramework {
                 m_ReadBytes = 0;
                 m_SendBytes = 0;
                 m_SendOffset = 0;
+                m_SegmentIndex = m_SegmentCount;
+                m_Region.Length = 0;
+                Settle();
                 m_syncAdmin.Unlock();
             }
 
@@ -235,10 +254,56 @@ namespace WPEFramework {
             uint32_t Close(const uint32_t waitTime);
             void Trigger();
 
+            // Sends the segments of at least ZeroCopyThreshold bytes with MSG_ZEROCOPY, if the system
+            // supports it. Returns whether it is active.
+            bool ZeroCopy(const bool enabled);
+            inline bool ZeroCopy() const
+            {
+                return (m_ZeroCopy);
+            }
+
+            // Lets more listening sockets bind to the same address and port (SO_REUSEPORT), the system
+            // spreads the incoming connections over them. Must be set before the socket is opened.
+            inline void ReusePort(const bool enabled)
+            {
+                ASSERT(m_Socket == INVALID_SOCKET);
+
+                m_ReusePort = enabled;
+            }
+            // The reactor of the ResourceMonitor that handles this socket, by default it is picked by
+            // the address of the port. Must be set before the socket is opened.
+            inline void Affinity(const uint8_t reactor)
+            {
+                ASSERT(m_Socket == INVALID_SOCKET);
+
+                m_Affinity = reactor;
+            }
+
             // Methods to extract and insert data into the socket buffers
             virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
             virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
 
+            // Optional scatter-gather path for connected sockets, asked before SendData. The segments
+            // are written as they are, without being copied into the send buffer first. They must stay
+            // valid until ReleaseSegments is called, after they have been written, the port is flushed
+            // or it is closed. Returning 0 falls back to SendData.
+            virtual uint8_t SendSegments(Segment /* segments */[], const uint8_t /* maxSegments */)
+            {
+                return (0);
+            }
+            virtual void ReleaseSegments()
+            {
+            }
+
+            // Optional path for connected sockets to send a part of a file without copying it through user
+            // space, asked for once the segments are written and before SendData. The descriptor must stay
+            // open until SendData is called again, the port is flushed or it is closed. Only asked for where
+            // the system offers sendfile(), returning false falls back to SendData.
+            virtual bool SendFile(Region& /* region */)
+            {
+                return (false);
+            }
+
             // Signal a state change, Opened, Closed or Accepted
             virtual void StateChange() = 0;
 
@@ -281,6 +346,10 @@ namespace WPEFramework {
             void Accepted();
             void Read();
             void Write();
+            int32_t WriteSegments();
+            int32_t WriteRegion();
+            void Completed();
+            void Settle();
             void BufferAlignment(SOCKET socket);
             SOCKET ConstructSocket(NodeId& localNode, const string& interfaceName);
             uint32_t WaitForOpen(const uint32_t time) const;
@@ -306,6 +375,16 @@ namespace WPEFramework {
             uint16_t m_SendOffset;
             uint32_t m_Interface;
             bool m_SystemdSocket;
+            Segment m_Segments[MaxSegments];
+            uint8_t m_SegmentCount;
+            uint8_t m_SegmentIndex;
+            uint32_t m_SegmentOffset;
+            bool m_ZeroCopy;
+            uint32_t m_ZeroCopySent;
+            uint32_t m_ZeroCopyDone;
+            Region m_Region;
+            bool m_ReusePort;
+            uint8_t m_Affinity;
         };
 
         class EXTERNAL SocketStream : public SocketPort {
@@ -430,6 +509,10 @@ namespace WPEFramework {
                 }
 
             public:
+                inline const NodeId& LocalNode() const
+                {
+                    return (SocketPort::LocalNode());
+                }
                 inline void LocalNode(const Core::NodeId& localNode)
                 {
                     SocketPort::LocalNode(localNode);
@@ -514,6 +597,18 @@ namespace WPEFramework {
             {
                 return (RHS._socket != _socket);
             }
+            inline const NodeId& LocalNode() const
+            {
+                return (_socket.LocalNode());
+            }
+            inline void ReusePort(const bool enabled)
+            {
+                _socket.ReusePort(enabled);
+            }
+            inline void Affinity(const uint8_t reactor)
+            {
+                _socket.Affinity(reactor);
+            }
 
             virtual void Accept(SOCKET& newClient, const NodeId& remoteId) = 0;
 
@@ -56,6 +56,12 @@ namespace Core {
                 }
                 _iterator = _clients.begin();
             }
+            IteratorType(std::list<HANDLECLIENT>&& clients)
+                : _atHead(true)
+                , _clients(std::move(clients))
+                , _iterator(_clients.begin())
+            {
+            }
             IteratorType(const IteratorType<HANDLECLIENT>& copy)
                 : _atHead(true)
                 , _clients(copy._clients)
@@ -133,9 +139,25 @@ namespace Core {
         typedef IteratorType<ProxyType<CLIENT>> Iterator;
 
     private:
+        // A client id holds the position of its slot in the low SlotBits and the generation of that
+        // slot above it. The generation changes every time a slot is reused, so an id of a client that
+        // is gone never reaches the client that took over its slot. The positions are interleaved
+        // over the listeners, position % listeners tells which listener owns the client.
+        static constexpr uint8_t SlotBits = 20;
+        static constexpr uint32_t SlotMask = ((1UL << SlotBits) - 1);
+        static constexpr uint16_t GenerationMask = static_cast<uint16_t>((1UL << (32 - SlotBits)) - 1);
+
+        // Slots looked at by a Cleanup() or Accept() for clients that closed without being reclaimed.
+        static constexpr uint16_t SweepSlots = 32;
+
         template <typename HANDLECLIENT>
         class SocketHandler : public SocketListner {
         private:
+            struct Slot {
+                uint16_t Generation;
+                ProxyType<HANDLECLIENT> Client;
+            };
+
             SocketHandler() = delete;
             SocketHandler(const SocketHandler<HANDLECLIENT>&) = delete;
             SocketHandler<HANDLECLIENT>& operator=(const SocketHandler<HANDLECLIENT>&) = delete;
@@ -143,23 +165,42 @@ namespace Core {
         public:
             SocketHandler(SocketServerType<CLIENT>* parent)
                 : SocketListner()
-                , _nextClient(1)
+                , _index(0)
+                , _step(1)
                 , _lock()
-                , _clients()
+                , _slots()
+                , _free()
+                , _reclaimLock()
+                , _reclaim()
+                , _count(0)
+                , _cursor(0)
                 , _parent(*parent)
             {
 
                 ASSERT(parent != nullptr);
             }
             SocketHandler(const NodeId& listenNode, SocketServerType<CLIENT>* parent)
+                : SocketHandler(listenNode, parent, 0, 1)
+            {
+            }
+            // One of the listeners of a sharded server, it only hands out the slot positions that belong
+            // to its index, so the id of a client tells which listener owns it.
+            SocketHandler(const NodeId& listenNode, SocketServerType<CLIENT>* parent, const uint8_t index, const uint8_t listeners)
                 : SocketListner(listenNode)
-                , _nextClient(1)
+                , _index(index)
+                , _step(listeners)
                 , _lock()
-                , _clients()
+                , _slots()
+                , _free()
+                , _reclaimLock()
+                , _reclaim()
+                , _count(0)
+                , _cursor(0)
                 , _parent(*parent)
             {
 
                 ASSERT(parent != nullptr);
+                ASSERT(index < listeners);
             }
             ~SocketHandler()
             {
@@ -168,43 +209,40 @@ namespace Core {
 
                 _lock.Lock();
 
-                while (_clients.size() > 0) {
-                    ProxyType<HANDLECLIENT> client = _clients.begin()->second;
+                for (Slot& slot : _slots) {
+                    if (slot.Client.IsValid() == true) {
+                        ProxyType<HANDLECLIENT> client(slot.Client);
 
-                    while (client->IsClosed() == false) {
-                        SleepMs(10);
-                    }
+                        while (client->IsClosed() == false) {
+                            SleepMs(10);
+                        }
 
-                    _clients.erase(_clients.begin());
+                        slot.Client.Release();
 
-                    client.Release();
+                        client.Release();
+                    }
                 }
 
+                _slots.clear();
+                _count = 0;
+
                 _lock.Unlock();
             }
 
         public:
             inline uint32_t Count() const
             {
-                return (static_cast<uint32_t>(_clients.size()));
+                return (_count);
             }
             template <typename PACKAGE>
             uint32_t Submit(const uint32_t ID, PACKAGE package)
             {
                 uint32_t result = Core::ERROR_UNAVAILABLE;
 
-                _lock.Lock();
-
-                typename ClientMap::iterator index = _clients.find(ID);
+                Core::ProxyType<HANDLECLIENT> client(Client(ID));
 
-                if (index == _clients.end()) {
-                    _lock.Unlock();
-                }
-                else {
+                if (client.IsValid() == true) {
                     // Oke connection still exists, send the message..
-                    Core::ProxyType<HANDLECLIENT> client (index->second);
-                    _lock.Unlock();
-
                     client->Submit(package);
                     client.Release();
 
@@ -214,12 +252,28 @@ namespace Core {
                 return (result);
             }
             inline Iterator Clients() const
+            {
+                std::list<ProxyType<HANDLECLIENT>> clients;
+
+                Snapshot(clients);
+
+                return (Iterator(std::move(clients)));
+            }
+            void Snapshot(std::list<ProxyType<HANDLECLIENT>>& clients) const
             {
                 _lock.Lock();
-                Iterator result(_clients);
-                _lock.Unlock();
 
-                return (result);
+                for (const Slot& slot : _slots) {
+                    if (slot.Client.IsValid() == true) {
+                        clients.push_back(slot.Client);
+                    }
+                }
+
+                _lock.Unlock();
+            }
+            inline const Core::NodeId& LocalNode() const
+            {
+                return (SocketListner::LocalNode());
             }
             inline void LocalNode(const Core::NodeId& localNode)
             {
@@ -231,11 +285,11 @@ namespace Core {
 
                 _lock.Lock();
 
-                typename ClientMap::iterator index = _clients.find(ID);
+                Slot* slot = Find(ID);
 
-                if (index != _clients.end()) {
+                if (slot != nullptr) {
                     // Oke connection still exists, send the message..
-                    result = index->second;
+                    result = slot->Client;
                 }
 
                 _lock.Unlock();
@@ -246,34 +300,69 @@ namespace Core {
             {
                 _lock.Lock();
 
-                typename ClientMap::iterator index = _clients.begin();
-
-                while (index != _clients.end()) {
-                    // Oke connection still exists, send the message..
-                    index->second->Close(waiTime);
-                    ++index;
+                for (Slot& slot : _slots) {
+                    if (slot.Client.IsValid() == true) {
+                        slot.Client->Close(waiTime);
+                    }
                 }
 
                 _lock.Unlock();
             }
+            // Queues a client that is closing, it is removed by the next Cleanup() that finds it closed.
+            // It is called from the state change of the client, so it only takes a lock of its own.
+            void Reclaim(const uint32_t ID)
+            {
+                _reclaimLock.Lock();
+                _reclaim.push_back(ID);
+                _reclaimLock.Unlock();
+            }
             void Cleanup()
             {
+                std::vector<uint32_t> candidates;
+
+                _reclaimLock.Lock();
+                candidates.swap(_reclaim);
+                _reclaimLock.Unlock();
+
+                const size_t reclaimed = candidates.size();
+
                 _lock.Lock();
 
-                // Check if we can remove closed clients.
-                typename ClientMap::iterator index = _clients.begin();
+                // Clients that were never reclaimed are found by sweeping a few slots at a time.
+                for (uint16_t count = 0; (count < SweepSlots) && (_slots.empty() == false); count++) {
+                    const Slot& slot(_slots[_cursor]);
 
-                while (index != _clients.end()) {
-                    if ((index->second->IsClosed() == true) || ((index->second->IsSuspended() == true) && (index->second->Close(100) == Core::ERROR_NONE))) {
-                        // Step forward but remember where we were and delete that one....
-                        index = _clients.erase(index);
-                    }
-                    else {
-                        index++;
+                    if (slot.Client.IsValid() == true) {
+                        candidates.push_back(Identifier(_cursor, slot.Generation));
                     }
+
+                    _cursor = static_cast<uint32_t>((_cursor + 1) % _slots.size());
                 }
 
                 _lock.Unlock();
+
+                // Closing a suspended client takes time, do not hold up the others meanwhile.
+                for (size_t index = 0; index < candidates.size(); index++) {
+                    Core::ProxyType<HANDLECLIENT> client(Client(candidates[index]));
+
+                    if (client.IsValid() == true) {
+                        if ((client->IsClosed() == true) || ((client->IsSuspended() == true) && (client->Close(100) == Core::ERROR_NONE))) {
+                            _lock.Lock();
+
+                            Slot* slot = Find(candidates[index]);
+
+                            if (slot != nullptr) {
+                                Remove(*slot);
+                            }
+
+                            _lock.Unlock();
+                        }
+                        else if (index < reclaimed) {
+                            // Still on its way down, look again next time.
+                            Reclaim(candidates[index]);
+                        }
+                    }
+                }
             }
             virtual void Accept(SOCKET& newClient, const NodeId& remoteId)
             {
@@ -286,25 +375,51 @@ namespace Core {
 
                     _lock.Lock();
 
-                    // Check if we can remove closed clients.
-                    typename ClientMap::iterator index = _clients.begin();
+                    // Check if we can remove a few closed clients.
+                    for (uint16_t count = 0; (count < SweepSlots) && (_slots.empty() == false); count++) {
+                        Slot& slot(_slots[_cursor]);
 
-                    while (index != _clients.end()) {
-                        if (index->second->IsClosed() == true) {
-                            index = _clients.erase(index);
-                        }
-                        else {
-                            ++index;
+                        if ((slot.Client.IsValid() == true) && (slot.Client->IsClosed() == true)) {
+                            Remove(slot);
                         }
+
+                        _cursor = static_cast<uint32_t>((_cursor + 1) % _slots.size());
                     }
 
-                    // If the CLient has a method to receive it's Id pass it on..
-                    __Id(*client, _nextClient);
+                    uint32_t index;
 
-                    // A new connection is available, open up a new client
-                    _clients.insert(std::pair<uint32_t, ProxyType<HANDLECLIENT>>(_nextClient++, client));
+                    if (_free.empty() == false) {
+                        index = _free.back();
+                        _free.pop_back();
+                    }
+                    else if (((_slots.size() * _step) + _index) <= SlotMask) {
+                        index = static_cast<uint32_t>(_slots.size());
+                        _slots.push_back({ 1, ProxyType<HANDLECLIENT>() });
+                    }
+                    else {
+                        index = static_cast<uint32_t>(~0);
+                    }
 
-                    _lock.Unlock();
+                    if (index == static_cast<uint32_t>(~0)) {
+                        TRACE_L1("No room left for client %s", remoteId.HostAddress().c_str());
+
+                        _lock.Unlock();
+
+                        client->Close(0);
+                    }
+                    else {
+                        Slot& slot(_slots[index]);
+                        const uint32_t id = Identifier(index, slot.Generation);
+
+                        // If the CLient has a method to receive it's Id pass it on..
+                        __Id(*client, id);
+
+                        // A new connection is available, open up a new client
+                        slot.Client = client;
+                        _count++;
+
+                        _lock.Unlock();
+                    }
                 }
             }
             void Lock()
@@ -317,6 +432,34 @@ namespace Core {
             }
 
         private:
+            inline uint32_t Identifier(const uint32_t index, const uint16_t generation) const
+            {
+                return ((static_cast<uint32_t>(generation) << SlotBits) | ((index * _step) + _index));
+            }
+            Slot* Find(const uint32_t ID)
+            {
+                Slot* result = nullptr;
+                const uint32_t index = ((ID & SlotMask) / _step);
+
+                if ((index < _slots.size()) && (_slots[index].Generation == (ID >> SlotBits)) && (_slots[index].Client.IsValid() == true)) {
+                    result = &(_slots[index]);
+                }
+
+                return (result);
+            }
+            void Remove(Slot& slot)
+            {
+                ASSERT(slot.Client.IsValid() == true);
+
+                slot.Client.Release();
+
+                // Never generation 0, so no id is ever 0.
+                slot.Generation = ((slot.Generation & GenerationMask) == GenerationMask ? 1 : slot.Generation + 1);
+
+                _free.push_back(static_cast<uint32_t>(&slot - _slots.data()));
+                _count--;
+            }
+
             // -----------------------------------------------------
             // Check for Id  method on Object
             // -----------------------------------------------------
@@ -336,9 +479,15 @@ namespace Core {
             }
 
         private:
-            uint32_t _nextClient;
+            const uint8_t _index;
+            const uint8_t _step;
             mutable Core::CriticalSection _lock;
-            std::map<uint32_t, ProxyType<HANDLECLIENT>> _clients;
+            std::vector<Slot> _slots;
+            std::vector<uint32_t> _free;
+            Core::CriticalSection _reclaimLock;
+            std::vector<uint32_t> _reclaim;
+            std::atomic<uint32_t> _count;
+            uint32_t _cursor;
             SocketServerType<CLIENT>& _parent;
         };
 
@@ -349,68 +498,161 @@ namespace Core {
 PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
         SocketServerType()
             : _handler(this)
+            , _shards()
         {
+            _shards.push_back(&_handler);
         }
         SocketServerType(const NodeId& listeningNode)
             : _handler(listeningNode, this)
+            , _shards()
         {
+            _shards.push_back(&_handler);
+        }
+        // Accepts the connections on a number of listeners bound to the same port (SO_REUSEPORT), so a
+        // storm of connections is not handled by a single accept loop and client table. Each listener
+        // runs on its own reactor of the ResourceMonitor and owns the clients it accepted. Only an
+        // IPv4 or IPv6 node with a fixed port can be shared, otherwise only the first listener is used.
+        SocketServerType(const NodeId& listeningNode, const uint8_t listeners)
+            : _handler(listeningNode, this, 0, (listeners == 0 ? 1 : listeners))
+            , _shards()
+        {
+            _shards.push_back(&_handler);
+
+            for (uint8_t index = 1; index < listeners; index++) {
+                _shards.push_back(new SocketHandler<CLIENT>(listeningNode, this, index, listeners));
+            }
+
+            if (_shards.size() > 1) {
+                for (uint8_t index = 0; index < _shards.size(); index++) {
+                    _shards[index]->ReusePort(true);
+                    _shards[index]->Affinity(index);
+                }
+            }
         }
 POP_WARNING()
         ~SocketServerType()
         {
+            for (uint8_t index = 1; index < _shards.size(); index++) {
+                delete _shards[index];
+            }
         }
 
     public:
         inline uint32_t Open(const uint32_t waitTime)
         {
-            return (_handler.Open(waitTime));
+            uint32_t result = _handler.Open(waitTime);
+
+            if ((result == Core::ERROR_NONE) && (IsShared() == true)) {
+                for (uint8_t index = 1; index < _shards.size(); index++) {
+                    if (_shards[index]->Open(waitTime) != Core::ERROR_NONE) {
+                        // Not fatal, the connections are spread over the listeners that are open.
+                        TRACE_L1("Could not open listener %d of %d", index, static_cast<uint32_t>(_shards.size()));
+                    }
+                }
+            }
+
+            return (result);
         }
         inline uint32_t Close(const uint32_t waitTime)
         {
             uint32_t result = _handler.Close(waitTime);
-            _handler.CloseClients(waitTime);
+
+            for (uint8_t index = 1; index < _shards.size(); index++) {
+                _shards[index]->Close(waitTime);
+            }
+            for (SocketHandler<CLIENT>* shard : _shards) {
+                shard->CloseClients(waitTime);
+            }
+
             return (result);
         }
+        // Tells that a client is closing, so the next Cleanup() removes it once it is closed. Clients
+        // that are not reclaimed are found as well, but only a few slots are looked at per Cleanup().
+        inline void Reclaim(const uint32_t ID)
+        {
+            Shard(ID).Reclaim(ID);
+        }
         inline void Cleanup()
         {
-            _handler.Cleanup();
+            for (SocketHandler<CLIENT>* shard : _shards) {
+                shard->Cleanup();
+            }
         }
         inline Core::ProxyType<CLIENT> Client(const uint32_t ID)
         {
-            return (_handler.Client(ID));
+            return (Shard(ID).Client(ID));
         }
         inline void Suspend(const uint32_t ID)
         {
-            return (_handler.Suspend(ID));
+            return (Shard(ID).Suspend(ID));
         }
         inline void LocalNode(const Core::NodeId& localNode)
         {
-            _handler.LocalNode(localNode);
+            for (SocketHandler<CLIENT>* shard : _shards) {
+                shard->LocalNode(localNode);
+            }
         }
         template <typename PACKAGE>
         inline uint32_t Submit(const uint32_t ID, PACKAGE package)
         {
-            return (_handler.Submit(ID, package));
+            return (Shard(ID).Submit(ID, package));
         }
         inline Iterator Clients() const
         {
-            return (_handler.Clients());
+            if (_shards.size() == 1) {
+                return (_handler.Clients());
+            }
+
+            std::list<Core::ProxyType<CLIENT>> clients;
+
+            for (const SocketHandler<CLIENT>* shard : _shards) {
+                shard->Snapshot(clients);
+            }
+
+            return (Iterator(std::move(clients)));
         }
         inline uint32_t Count() const
         {
-            return (_handler.Count());
+            uint32_t count = 0;
+
+            for (const SocketHandler<CLIENT>* shard : _shards) {
+                count += shard->Count();
+            }
+
+            return (count);
+        }
+        inline uint8_t Listeners() const
+        {
+            return (static_cast<uint8_t>(_shards.size()));
         }
         void Lock()
         {
-            _handler.Lock();
+            for (SocketHandler<CLIENT>* shard : _shards) {
+                shard->Lock();
+            }
         }
         void Unlock()
         {
-            _handler.Unlock();
+            for (uint8_t index = static_cast<uint8_t>(_shards.size()); index > 0; index--) {
+                _shards[index - 1]->Unlock();
+            }
+        }
+
+    private:
+        inline SocketHandler<CLIENT>& Shard(const uint32_t ID) const
+        {
+            return (*_shards[(ID & SlotMask) % _shards.size()]);
+        }
+        inline bool IsShared() const
+        {
+            const NodeId& node(_handler.LocalNode());
+
+            return ((_shards.size() > 1) && ((node.Type() == NodeId::TYPE_IPV4) || (node.Type() == NodeId::TYPE_IPV6)) && (node.PortNumber() != 0));
         }
 
     private:
         SocketHandler<CLIENT> _handler;
+        std::vector<SocketHandler<CLIENT>*> _shards;
     };
 }
 } // namespace Core
@@ -19,8 +19,11 @@
  
 #pragma once
 
+#include <deque>
+
 #include "Thread.h"
 #include "ResourceMonitor.h"
+#include "RingQueue.h"
 #include "Number.h"
 
 namespace WPEFramework {
@@ -53,6 +56,8 @@ namespace Core {
         struct EXTERNAL Metadata {
             ::ThreadId                  WorkerId;
             uint32_t                    Runs;
+            uint32_t                    Steals;
+            uint32_t                    Depth;
             Core::OptionalType<string>  Job;
         };
 
@@ -167,7 +172,11 @@ namespace Core {
         using QueueElement = ProxyType<IDispatch>;
         #endif
 
+        #ifdef __CORE_THREADPOOL_RING_QUEUE__
+        using MessageQueue = RingQueueType< QueueElement >;
+        #else
         using MessageQueue = QueueType< QueueElement >;
+        #endif
 
     public:   
         template<typename IMPLEMENTATION>
@@ -381,6 +390,9 @@ POP_WARNING()
                 , _interestCount(0)
                 , _currentRequest()
                 , _runs(0)
+                , _queueLock()
+                , _local()
+                , _steals(0)
             {
                 ASSERT(dispatcher != nullptr);
             }
@@ -393,6 +405,8 @@ POP_WARNING()
             }
             void Info(Metadata& info) const {
                 info.Runs = _runs;
+                info.Steals = _steals;
+                info.Depth = Depth();
 
                 _adminLock.Lock();
                 if (_currentRequest.IsValid() == false) {
@@ -421,11 +435,73 @@ POP_WARNING()
 
                 return(result);
             }
+            // The local queue is only filled in work-stealing mode, by jobs
+            // this minion executes. Other minions steal from it if idle.
+            void Push(const ProxyType<IDispatch>& job) {
+                _queueLock.Lock();
+                _local.push_back(job);
+                _queueLock.Unlock();
+            }
+            bool Pop(QueueElement& result) {
+                bool popped = false;
+
+                _queueLock.Lock();
+                if (_local.empty() == false) {
+                    result = _local.front();
+                    _local.pop_front();
+                    popped = true;
+                }
+                _queueLock.Unlock();
+
+                return (popped);
+            }
+            bool Steal(Minion& victim, QueueElement& result) {
+                // The result is the slot of the job this minion runs. The job moves from the queue of
+                // the victim into it under both locks, so Revoke always finds it in one of the two.
+                _adminLock.Lock();
+                bool stolen = victim.Pop(result);
+                _adminLock.Unlock();
+
+                if (stolen == true) {
+                    _steals++;
+                }
+
+                return (stolen);
+            }
+            bool Remove(const ProxyType<IDispatch>& job) {
+                bool removed = false;
+
+                _queueLock.Lock();
+                std::deque<QueueElement>::iterator index = std::find(_local.begin(), _local.end(), QueueElement(job));
+                if (index != _local.end()) {
+                    _local.erase(index);
+                    removed = true;
+                }
+                _queueLock.Unlock();
+
+                return (removed);
+            }
+            bool HasEntry(const ProxyType<IDispatch>& job) const {
+                Core::SafeSyncType<Core::CriticalSection> lock(_queueLock);
+                return (std::find(_local.cbegin(), _local.cend(), QueueElement(job)) != _local.cend());
+            }
+            uint32_t Depth() const {
+                Core::SafeSyncType<Core::CriticalSection> lock(_queueLock);
+                return (static_cast<uint32_t>(_local.size()));
+            }
+            template<typename ACTION>
+            void Visit(ACTION&& action) const {
+                _queueLock.Lock();
+                for (const QueueElement& entry : _local) {
+                    action(entry);
+                }
+                _queueLock.Unlock();
+            }
             void Process()
             {
                 _dispatcher->Initialize();
 
-                while (_parent._queue.Extract(_currentRequest, infinite) == true) {
+                while (_parent.Next(*this, _currentRequest) == true) {
 
                     ASSERT(_currentRequest.IsValid() == true);
 
@@ -497,6 +573,9 @@ POP_WARNING()
             ProxyType<IDispatch> _currentRequest;
             #endif
             uint32_t _runs;
+            mutable CriticalSection _queueLock;
+            std::deque<QueueElement> _local;
+            std::atomic<uint32_t> _steals;
         };
 
     private:
@@ -521,6 +600,16 @@ POP_WARNING()
             bool IsActive() const {
                 return (_minion.IsActive());
             }
+            bool HasEntry(const ProxyType<IDispatch>& job) const {
+                return (_minion.HasEntry(job));
+            }
+            uint32_t Depth() const {
+                return (_minion.Depth());
+            }
+            template<typename ACTION>
+            void Visit(ACTION&& action) const {
+                _minion.Visit(action);
+            }
             void Info(Metadata& info) const {
                 _minion.Info(info);
                 info.WorkerId = Id();
@@ -551,8 +640,12 @@ POP_WARNING()
         ThreadPool(const ThreadPool& a_Copy) = delete;
         ThreadPool& operator=(const ThreadPool& a_RHS) = delete;
 
-        ThreadPool(const uint8_t count, const uint32_t stackSize, const uint32_t queueSize, IDispatcher* dispatcher, IScheduler* scheduler, Minion* external, ICallback* callback) 
+        // In work-stealing mode, jobs submitted by a job that runs on this pool are queued
+        // locally on that thread, other threads of the pool steal them once they are idle.
+        ThreadPool(const uint8_t count, const uint32_t stackSize, const uint32_t queueSize, IDispatcher* dispatcher, IScheduler* scheduler, Minion* external, ICallback* callback, const bool stealing = false) 
             : _queue(queueSize)
+            , _stealing(stealing)
+            , _idle(0)
             , _scheduler(scheduler)
             #ifdef __CORE_WARNING_REPORTING__
             , _dispatchedJobMonitor(nullptr)
@@ -578,6 +671,9 @@ POP_WARNING()
         uint32_t Pending() const {
             return (_queue.Length());
         }
+        bool IsStealing() const {
+            return (_stealing);
+        }
         void Snapshot(const uint8_t length, Metadata* entries, std::vector<string>& jobs) const
         {
             uint8_t count = 0;
@@ -595,6 +691,14 @@ POP_WARNING()
                 jobs.emplace_back(element->Identifier());
                 });
 
+            if (_stealing == true) {
+                for (const Executor& unit : _units) {
+                    unit.Visit([&](const QueueElement& element) {
+                        jobs.emplace_back(element->Identifier());
+                        });
+                }
+            }
+
             _queue.Unlock();
         }
         ::ThreadId Id(const uint8_t index) const
@@ -611,8 +715,26 @@ POP_WARNING()
         {
             ASSERT(job.IsValid() == true);
             ASSERT(_queue.HasEntry(job) == false);
+            ASSERT((_stealing == false) || (HasLocal(job) == false));
 
-            if (Thread::ThreadId() == ResourceMonitor::Instance().Id()) {
+            Minion* local = (_stealing == true ? Local() : nullptr);
+
+            // If a thread is idle, it is blocked on the shared queue, so there it is picked up fastest.
+            if ((local != nullptr) && (_idle == 0)) {
+                local->Push(job);
+
+                // A thread might have gone idle right after we looked, without seeing the job. It
+                // only watches the shared queue now, so move the job over unless it was taken already.
+                // The shared queue is locked during the move, so a Revoke can not miss it in between.
+                if (_idle != 0) {
+                    _queue.Lock();
+                    if (local->Remove(job) == true) {
+                        _queue.Post(job);
+                    }
+                    _queue.Unlock();
+                }
+            }
+            else if (ResourceMonitor::Instance().IsMonitorThread() == true) {
                 _queue.Post(job);
             }
             else {
@@ -626,7 +748,9 @@ POP_WARNING()
 
             ASSERT(job.IsValid() == true);
 
-            if (_queue.Remove(job) == true) {
+            // Jobs only move from a local queue to the shared queue and from there to a running slot,
+            // so they are looked for in that order, to not miss one that moves meanwhile.
+            if (((_stealing == true) && (RemoveLocal(job) == true)) || (_queue.Remove(job) == true)) {
                 result = ERROR_NONE;
             }
             else {
@@ -692,6 +816,82 @@ POP_WARNING()
         #endif
 
     private:
+        bool Next(Minion& minion, QueueElement& result) {
+            bool found = false;
+
+            if (_stealing == false) {
+                found = _queue.Extract(result, infinite);
+            }
+            else {
+                bool running = true;
+
+                while ((found == false) && (running == true)) {
+                    found = ((minion.Pop(result) == true) || (_queue.Extract(result, 0) == true) || (Steal(minion, result) == true));
+
+                    if (found == false) {
+                        // Let the submitters know we are idle, and look once more before we block.
+                        _idle++;
+                        found = (Steal(minion, result) == true);
+                        if (found == false) {
+                            found = _queue.Extract(result, infinite);
+                            running = found;
+                        }
+                        _idle--;
+                    }
+                }
+            }
+
+            return (found);
+        }
+        bool Steal(Minion& thief, QueueElement& result) {
+            bool stolen = false;
+            std::list<Executor>::iterator index = _units.begin();
+
+            while ((stolen == false) && (index != _units.end())) {
+                if (&(index->Me()) != &thief) {
+                    stolen = thief.Steal(index->Me(), result);
+                }
+                index++;
+            }
+
+            return (stolen);
+        }
+        Minion* Local() {
+            Minion* result = nullptr;
+            const ::ThreadId id = Thread::ThreadId();
+            std::list<Executor>::iterator index = _units.begin();
+
+            while ((index != _units.end()) && (index->Id() != id)) {
+                index++;
+            }
+            if (index != _units.end()) {
+                result = &(index->Me());
+            }
+
+            return (result);
+        }
+        bool HasLocal(const ProxyType<IDispatch>& job) const {
+            bool found = false;
+            std::list<Executor>::const_iterator index = _units.cbegin();
+
+            while ((found == false) && (index != _units.cend())) {
+                found = index->HasEntry(job);
+                index++;
+            }
+
+            return (found);
+        }
+        bool RemoveLocal(const ProxyType<IDispatch>& job) {
+            bool removed = false;
+            std::list<Executor>::iterator index = _units.begin();
+
+            while ((removed == false) && (index != _units.end())) {
+                removed = index->Me().Remove(job);
+                index++;
+            }
+
+            return (removed);
+        }
         void Idle() {
             if (_callback != nullptr) {
                 _queue.Lock();
@@ -700,7 +900,7 @@ POP_WARNING()
                 }
                 else {
                     std::list<Executor>::const_iterator index(_units.begin());
-                    while ((index != _units.end()) && (index->IsActive() == false)) { index++; }
+                    while ((index != _units.end()) && (index->IsActive() == false) && (index->Depth() == 0)) { index++; }
                     bool idle = (index == _units.end());
                     _queue.Unlock();
 
@@ -729,6 +929,8 @@ POP_WARNING()
 
     private:
         MessageQueue _queue;
+        const bool _stealing;
+        std::atomic<uint32_t> _idle;
         std::list<Executor> _units;
         IScheduler* _scheduler;
         #ifdef __CORE_WARNING_REPORTING__
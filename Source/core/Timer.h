@@ -27,6 +27,7 @@
 #include "Sync.h"
 #include "Thread.h"
 #include "Time.h"
+#include <unordered_map>
 #include <utility>
 
 // ---- Referenced classes and types ----
@@ -156,12 +157,278 @@ namespace Core {
         using TimeInfoBlocks = TimedInfo<CONTENT>;
         using SubscriberList = typename std::list<TimeInfoBlocks>;
 
+        // -----------------------------------------------------
+        // Check for a Hash method on the content
+        // -----------------------------------------------------
+        IS_MEMBER_AVAILABLE(Hash, hasHash);
+
+        // A 4-ary min-heap on the schedule time, entries with the same time keep
+        // the order in which they were scheduled. Entries are allocated once and
+        // only their pointers move around in the heap. If the content offers a
+        // "uint64_t Hash() const", entries are indexed on it, so finding them for
+        // a Revoke() or Trigger() does not need a scan either.
+        class Heap {
+        private:
+            static constexpr uint8_t Arity = 4;
+
+            class Slot {
+            public:
+                Slot() = delete;
+                Slot(const Slot&) = delete;
+                Slot& operator=(const Slot&) = delete;
+
+                Slot(TimeInfoBlocks&& info, const uint64_t sequence)
+                    : Info(std::move(info))
+                    , Sequence(sequence)
+                    , Position(0)
+                    , Key(0)
+                {
+                }
+                ~Slot() = default;
+
+            public:
+                bool operator<(const Slot& RHS) const
+                {
+                    return ((Info.ScheduleTime() < RHS.Info.ScheduleTime()) || ((Info.ScheduleTime() == RHS.Info.ScheduleTime()) && (Sequence < RHS.Sequence)));
+                }
+
+            public:
+                TimeInfoBlocks Info;
+                const uint64_t Sequence;
+                uint32_t Position;
+                uint64_t Key;
+            };
+
+            using Index = std::unordered_multimap<uint64_t, Slot*>;
+
+        public:
+            Heap(const Heap&) = delete;
+            Heap& operator=(const Heap&) = delete;
+
+            Heap()
+                : _heap()
+                , _index()
+                , _sequence(0)
+            {
+            }
+            ~Heap()
+            {
+                Clear();
+            }
+
+        public:
+            bool IsEmpty() const
+            {
+                return (_heap.empty());
+            }
+            uint32_t Size() const
+            {
+                return (static_cast<uint32_t>(_heap.size()));
+            }
+            TimeInfoBlocks& Front()
+            {
+                ASSERT(_heap.empty() == false);
+
+                return (_heap[0]->Info);
+            }
+            // Returns true if the entry became the first one to expire.
+            bool Push(TimeInfoBlocks&& info)
+            {
+                Slot* slot = new Slot(std::move(info), _sequence++);
+
+                slot->Position = static_cast<uint32_t>(_heap.size());
+                _heap.push_back(slot);
+                Up(slot->Position);
+                AddIndex<CONTENT>(slot);
+
+                return (slot->Position == 0);
+            }
+            void PopFront()
+            {
+                ASSERT(_heap.empty() == false);
+
+                Erase(0);
+            }
+            // Returns true if the first entry to expire was removed.
+            bool Remove(const CONTENT& info, const bool all, bool& found)
+            {
+                std::vector<Slot*> matches;
+                bool changedHead = false;
+
+                Lookup<CONTENT>(info, all, matches);
+
+                found = (matches.empty() == false);
+
+                for (Slot* slot : matches) {
+                    changedHead |= (slot->Position == 0);
+                    Erase(slot->Position);
+                }
+
+                return (changedHead);
+            }
+            bool HasEntry(const CONTENT& info) const
+            {
+                std::vector<Slot*> matches;
+
+                Lookup<CONTENT>(info, false, matches);
+
+                return (matches.empty() == false);
+            }
+            void Clear()
+            {
+                for (Slot* slot : _heap) {
+                    delete slot;
+                }
+                _heap.clear();
+                _index.clear();
+            }
+
+        private:
+            void Erase(const uint32_t position)
+            {
+                Slot* slot = _heap[position];
+                Slot* last = _heap.back();
+
+                _heap.pop_back();
+
+                if (last != slot) {
+                    last->Position = position;
+                    _heap[position] = last;
+
+                    if ((position > 0) && (*last < *_heap[(position - 1) / Arity])) {
+                        Up(position);
+                    } else {
+                        Down(position);
+                    }
+                }
+
+                RemoveIndex<CONTENT>(slot);
+
+                delete slot;
+            }
+            void Up(uint32_t position)
+            {
+                Slot* slot = _heap[position];
+
+                while ((position > 0) && (*slot < *_heap[(position - 1) / Arity])) {
+                    const uint32_t parent = (position - 1) / Arity;
+                    _heap[position] = _heap[parent];
+                    _heap[position]->Position = position;
+                    position = parent;
+                }
+
+                _heap[position] = slot;
+                slot->Position = position;
+            }
+            void Down(uint32_t position)
+            {
+                Slot* slot = _heap[position];
+                const uint32_t size = static_cast<uint32_t>(_heap.size());
+                bool moving = true;
+
+                while (moving == true) {
+                    const uint32_t first = (position * Arity) + 1;
+                    const uint32_t end = std::min(first + Arity, size);
+                    uint32_t smallest = position;
+
+                    for (uint32_t child = first; child < end; child++) {
+                        if (*_heap[child] < (smallest == position ? *slot : *_heap[smallest])) {
+                            smallest = child;
+                        }
+                    }
+
+                    moving = (smallest != position);
+
+                    if (moving == true) {
+                        _heap[position] = _heap[smallest];
+                        _heap[position]->Position = position;
+                        position = smallest;
+                    }
+                }
+
+                _heap[position] = slot;
+                slot->Position = position;
+            }
+
+            template <typename TYPE>
+            inline typename Core::TypeTraits::enable_if<hasHash<const TYPE, uint64_t>::value, void>::type
+            AddIndex(Slot* slot)
+            {
+                // Remember the key, the content is moved out before the slot is removed.
+                slot->Key = slot->Info.Content().Hash();
+                _index.emplace(slot->Key, slot);
+            }
+            template <typename TYPE>
+            inline typename Core::TypeTraits::enable_if<!hasHash<const TYPE, uint64_t>::value, void>::type
+            AddIndex(Slot*)
+            {
+            }
+            template <typename TYPE>
+            inline typename Core::TypeTraits::enable_if<hasHash<const TYPE, uint64_t>::value, void>::type
+            RemoveIndex(Slot* slot)
+            {
+                std::pair<typename Index::iterator, typename Index::iterator> range = _index.equal_range(slot->Key);
+
+                while ((range.first != range.second) && (range.first->second != slot)) {
+                    range.first++;
+                }
+
+                ASSERT(range.first != range.second);
+
+                _index.erase(range.first);
+            }
+            template <typename TYPE>
+            inline typename Core::TypeTraits::enable_if<!hasHash<const TYPE, uint64_t>::value, void>::type
+            RemoveIndex(Slot*)
+            {
+            }
+            template <typename TYPE>
+            inline typename Core::TypeTraits::enable_if<hasHash<const TYPE, uint64_t>::value, void>::type
+            Lookup(const CONTENT& info, const bool all, std::vector<Slot*>& matches) const
+            {
+                std::pair<typename Index::const_iterator, typename Index::const_iterator> range = _index.equal_range(info.Hash());
+
+                while ((range.first != range.second) && ((all == true) || (matches.empty() == true))) {
+                    if (range.first->second->Info == info) {
+                        matches.push_back(range.first->second);
+                    }
+                    range.first++;
+                }
+            }
+            template <typename TYPE>
+            inline typename Core::TypeTraits::enable_if<!hasHash<const TYPE, uint64_t>::value, void>::type
+            Lookup(const CONTENT& info, const bool all, std::vector<Slot*>& matches) const
+            {
+                typename std::vector<Slot*>::const_iterator index = _heap.cbegin();
+
+                while ((index != _heap.cend()) && ((all == true) || (matches.empty() == true))) {
+                    if ((*index)->Info == info) {
+                        matches.push_back(*index);
+                    }
+                    index++;
+                }
+            }
+
+        private:
+            std::vector<Slot*> _heap;
+            Index _index;
+            uint64_t _sequence;
+        };
+
+    public:
+        enum mode : uint8_t {
+            LIST, // Sorted list, O(n) schedule and revoke, fine for a handful of entries.
+            HEAP  // d-ary heap, O(log n) schedule and revoke (see Heap).
+        };
+
     public:
         TimerType(const TimerType&) = delete;
         TimerType& operator=(const TimerType&) = delete;
 
-        TimerType(const uint32_t stackSize, const TCHAR* timerName)
+        TimerType(const uint32_t stackSize, const TCHAR* timerName, const mode storage = LIST)
             : _pendingQueue()
+            , _heap()
+            , _mode(storage)
             , _timerThread(*this, stackSize, timerName)
             , _adminLock()
             , _nextTrigger(NUMBER_MAX_UNSIGNED(uint64_t))
@@ -180,6 +447,7 @@ namespace Core {
 
             // Force kill on all pending stuff...
             _pendingQueue.clear();
+            _heap.Clear();
 
             _adminLock.Unlock();
 
@@ -213,6 +481,7 @@ namespace Core {
 
             // Force kill on all pending stuff...
             _pendingQueue.clear();
+            _heap.Clear();
             _adminLock.Unlock();
 
             _timerThread.Wait(Thread::BLOCKED, Core::infinite);
@@ -220,17 +489,23 @@ namespace Core {
 
         inline bool HasEntry(const CONTENT& element) const {
 
+            bool found;
+
             // This needs to be atomic. Make sure it is.
             _adminLock.Lock();
 
-            typename SubscriberList::const_iterator index = _pendingQueue.cbegin();
+            if (_mode == HEAP) {
+                found = _heap.HasEntry(element);
+            } else {
+                typename SubscriberList::const_iterator index = _pendingQueue.cbegin();
 
-            // Clear all entries !!
-            while ((index != _pendingQueue.cend()) && (*index != element)) {
-                index++;
-            }
+                // Clear all entries !!
+                while ((index != _pendingQueue.cend()) && (*index != element)) {
+                    index++;
+                }
 
-            bool found = (index != _pendingQueue.cend());
+                found = (index != _pendingQueue.cend());
+            }
 
             // Done with the administration. Release the lock.
             _adminLock.Unlock();
@@ -257,14 +532,19 @@ namespace Core {
 
             _adminLock.Lock();
 
-            typename SubscriberList::iterator index = _pendingQueue.begin();
+            if (_mode == HEAP) {
+                bool found;
+                _heap.Remove(info, false, found);
+            } else {
+                typename SubscriberList::iterator index = _pendingQueue.begin();
 
-            while ((index != _pendingQueue.end()) && ((*index).Content() != info)) {
-                ++index;
-            }
+                while ((index != _pendingQueue.end()) && ((*index).Content() != info)) {
+                    ++index;
+                }
 
-            if (index != _pendingQueue.end()) {
-                _pendingQueue.erase(index);
+                if (index != _pendingQueue.end()) {
+                    _pendingQueue.erase(index);
+                }
             }
 
             if (ScheduleEntry(std::move(newEntry)) == true) {
@@ -292,20 +572,24 @@ namespace Core {
                 _adminLock.Lock();
             }
 
-            typename SubscriberList::iterator index = _pendingQueue.begin();
-
             bool changedHead = false;
 
-            while (index != _pendingQueue.end()) {
-                if (index->Content() == info) {
-                    changedHead |= (index == _pendingQueue.begin());
-                    foundElement = true;
-
-                    // Remove this... Found it, remove it.
-                    index = _pendingQueue.erase(index);
-                }
-                else {
-                    ++index;
+            if (_mode == HEAP) {
+                changedHead = _heap.Remove(info, true, foundElement);
+            } else {
+                typename SubscriberList::iterator index = _pendingQueue.begin();
+
+                while (index != _pendingQueue.end()) {
+                    if (index->Content() == info) {
+                        changedHead |= (index == _pendingQueue.begin());
+                        foundElement = true;
+
+                        // Remove this... Found it, remove it.
+                        index = _pendingQueue.erase(index);
+                    }
+                    else {
+                        ++index;
+                    }
                 }
             }
 
@@ -326,7 +610,7 @@ namespace Core {
 
         uint32_t Pending() const
         {
-            return (static_cast<uint32_t>(_pendingQueue.size()));
+            return (_mode == HEAP ? _heap.Size() : static_cast<uint32_t>(_pendingQueue.size()));
         }
 
         ::ThreadId ThreadId() const
@@ -346,12 +630,12 @@ namespace Core {
             // Ranging from 0-Core::infinite
             _timerThread.Block();
 
-            while ((_pendingQueue.empty() == false) && (_pendingQueue.front().ScheduleTime() <= now)) {
-                TimedInfo<CONTENT> info(std::move(_pendingQueue.front()));
+            while ((IsEmpty() == false) && (Front().ScheduleTime() <= now)) {
+                TimedInfo<CONTENT> info(std::move(Front()));
                 _executing = &(info.Content());
 
                 // Make sure we loose the current one before we do the call, that one might add ;-)
-                _pendingQueue.pop_front();
+                PopFront();
                 _waitForCompletion.ResetEvent();
 
                 _adminLock.Unlock();
@@ -373,19 +657,19 @@ namespace Core {
             }
 
             // Calculate the delay...
-            if (_pendingQueue.empty() == true) {
+            if (IsEmpty() == true) {
                 _nextTrigger = NUMBER_MAX_UNSIGNED(uint64_t);
             } else {
                 // Refresh the time, just to be on the safe side...
                 uint64_t delta = Time::Now().Ticks();
 
-                if (delta >= _pendingQueue.front().ScheduleTime()) {
+                if (delta >= Front().ScheduleTime()) {
                     _nextTrigger = delta;
                     delayTime = 0;
                 } else {
                     // The windows counter is in 100ns intervals dus we mmoeten even delen door  1000 (us) * 10 ns = 10.000
                     // om de waarde in ms te krijgen.
-                    _nextTrigger = _pendingQueue.front().ScheduleTime();
+                    _nextTrigger = Front().ScheduleTime();
                     delayTime = static_cast<uint32_t>((_nextTrigger - delta) / Time::TicksPerMillisecond);
                 }
             }
@@ -396,24 +680,45 @@ namespace Core {
         }
 
     private:
+        bool IsEmpty() const
+        {
+            return (_mode == HEAP ? _heap.IsEmpty() : _pendingQueue.empty());
+        }
+        TimeInfoBlocks& Front()
+        {
+            return (_mode == HEAP ? _heap.Front() : _pendingQueue.front());
+        }
+        void PopFront()
+        {
+            if (_mode == HEAP) {
+                _heap.PopFront();
+            } else {
+                _pendingQueue.pop_front();
+            }
+        }
         bool ScheduleEntry(TimedInfo<CONTENT>&& infoBlock)
         {
             bool reevaluate = false;
-            typename SubscriberList::iterator index = _pendingQueue.begin();
 
-            while ((index != _pendingQueue.end()) && (infoBlock.ScheduleTime() >= (*index).ScheduleTime())) {
-                ++index;
-            }
+            if (_mode == HEAP) {
+                reevaluate = _heap.Push(std::move(infoBlock));
+            } else {
+                typename SubscriberList::iterator index = _pendingQueue.begin();
 
-            if (index == _pendingQueue.begin()) {
-                _pendingQueue.push_front(std::move(infoBlock));
+                while ((index != _pendingQueue.end()) && (infoBlock.ScheduleTime() >= (*index).ScheduleTime())) {
+                    ++index;
+                }
 
-                // If we added the new time up front, retrigger the scheduler.
-                reevaluate = true;
-            } else if (index == _pendingQueue.end()) {
-                _pendingQueue.push_back(std::move(infoBlock));
-            } else {
-                _pendingQueue.insert(index, std::move(infoBlock));
+                if (index == _pendingQueue.begin()) {
+                    _pendingQueue.push_front(std::move(infoBlock));
+
+                    // If we added the new time up front, retrigger the scheduler.
+                    reevaluate = true;
+                } else if (index == _pendingQueue.end()) {
+                    _pendingQueue.push_back(std::move(infoBlock));
+                } else {
+                    _pendingQueue.insert(index, std::move(infoBlock));
+                }
             }
 
             return (reevaluate);
@@ -421,6 +726,8 @@ namespace Core {
 
     private:
         SubscriberList _pendingQueue;
+        Heap _heap;
+        const mode _mode;
         TimeWorker _timerThread;
         mutable CriticalSection _adminLock;
         uint64_t _nextTrigger;
@@ -150,6 +150,10 @@ namespace Core {
             {
                 return (!operator==(RHS));
             }
+            uint64_t Hash() const
+            {
+                return (_job.IsValid() == true ? reinterpret_cast<uintptr_t>(&(*_job)) : 0);
+            }
             uint64_t Timed(const uint64_t /* scheduledTime */)
             {
                 ASSERT(_pool != nullptr);
@@ -314,11 +318,11 @@ namespace Core {
         WorkerPool& operator=(const WorkerPool&) = delete;
 
 PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
-        WorkerPool(const uint8_t threadCount, const uint32_t stackSize, const uint32_t queueSize, ThreadPool::IDispatcher* dispatcher, ThreadPool::ICallback* callback = nullptr)
+        WorkerPool(const uint8_t threadCount, const uint32_t stackSize, const uint32_t queueSize, ThreadPool::IDispatcher* dispatcher, ThreadPool::ICallback* callback = nullptr, const bool stealing = false)
             : _scheduler(this, _timer)
-            , _threadPool(threadCount, stackSize, queueSize, dispatcher, &_scheduler, &_external, callback)
+            , _threadPool(threadCount, stackSize, queueSize, dispatcher, &_scheduler, &_external, callback, stealing)
             , _external(_threadPool, dispatcher)
-            , _timer(1024 * 1024, _T("WorkerPoolType::Timer"))
+            , _timer(1024 * 1024, _T("WorkerPoolType::Timer"), Core::TimerType<Timer>::HEAP)
             , _metadata()
             , _joined(0)
             #ifdef __CORE_WARNING_REPORTING__
@@ -404,6 +408,8 @@ POP_WARNING()
         {
             _metadata.Slot[0].WorkerId = _timer.ThreadId();
             _metadata.Slot[0].Runs = _timer.Pending();
+            _metadata.Slot[0].Steals = 0;
+            _metadata.Slot[0].Depth = 0;
             _metadata.Slot[0].Job = string(_T("WorkerPool::Timer"));
             _external.Info(_metadata.Slot[1]);
             _threadPool.Snapshot(_threadPool.Count(), &(_metadata.Slot[2]), _metadata.Pending);
@@ -64,6 +64,7 @@
 #include "ProcessInfo.h"
 #include "Proxy.h"
 #include "Queue.h"
+#include "RingQueue.h"
 #include "Range.h"
 #include "Rectangle.h"
 #include "ReadWriteLock.h"
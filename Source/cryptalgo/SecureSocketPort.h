@@ -219,6 +219,13 @@ namespace Crypto {
         virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
         virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
 
+        // Data has to be encrypted before it goes out, so files can not be sent from the kernel. Here
+        // to offer links the same interface as a plain SocketPort, it is never asked for.
+        virtual bool SendFile(Core::SocketPort::Region& /* region */)
+        {
+            return (false);
+        }
+
         // Signal a state change, Opened, Closed or Accepted
         virtual void StateChange() = 0;
 
@@ -79,6 +79,7 @@ namespace Messaging {
         using BaseClass = BASECATEGORY;                     \
     public:                                                 \
         using BaseClass::BaseClass;                         \
+        using DeferredCategory = CATEGORY;                  \
         CATEGORY() = default;                               \
         ~CATEGORY() = default;                              \
         CATEGORY(const CATEGORY&) = delete;                 \
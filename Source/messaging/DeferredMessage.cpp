@@ -0,0 +1,239 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DeferredMessage.h"
+
+namespace WPEFramework {
+
+namespace Messaging {
+
+    namespace {
+
+        struct Argument {
+            uint8_t Type;
+            union {
+                int64_t Signed;
+                uint64_t Unsigned;
+                double Real;
+            };
+            const char* Text;
+
+            long long AsSigned() const
+            {
+                return (Type == DeferredMessage::SIGNED ? static_cast<long long>(Signed) : (Type == DeferredMessage::REAL ? static_cast<long long>(Real) : (Type == DeferredMessage::TEXT ? 0 : static_cast<long long>(Unsigned))));
+            }
+            unsigned long long AsUnsigned() const
+            {
+                return (static_cast<unsigned long long>(AsSigned()));
+            }
+            double AsReal() const
+            {
+                return (Type == DeferredMessage::REAL ? Real : (Type == DeferredMessage::SIGNED ? static_cast<double>(Signed) : (Type == DeferredMessage::TEXT ? 0.0 : static_cast<double>(Unsigned))));
+            }
+        };
+
+        class Arguments {
+        public:
+            Arguments() = delete;
+            Arguments(const Arguments&) = delete;
+            Arguments& operator=(const Arguments&) = delete;
+
+            Arguments(const uint8_t buffer[], const uint16_t length)
+                : _buffer(buffer)
+                , _length(length)
+                , _offset(0)
+            {
+            }
+            ~Arguments() = default;
+
+        public:
+            bool Next(Argument& argument)
+            {
+                bool result = false;
+
+                if (_offset < _length) {
+                    argument.Type = _buffer[_offset];
+                    argument.Text = nullptr;
+
+                    if (argument.Type == DeferredMessage::TEXT) {
+                        const uint8_t* end = static_cast<const uint8_t*>(::memchr(&(_buffer[_offset + 1]), '\0', _length - _offset - 1));
+
+                        if (end != nullptr) {
+                            argument.Text = reinterpret_cast<const char*>(&(_buffer[_offset + 1]));
+                            _offset = static_cast<uint16_t>(end - _buffer + 1);
+                            result = true;
+                        }
+                    } else if ((argument.Type >= DeferredMessage::SIGNED) && (argument.Type <= DeferredMessage::POINTER) && (static_cast<uint32_t>(_length - _offset) > sizeof(uint64_t))) {
+                        ::memcpy(&argument.Unsigned, &(_buffer[_offset + 1]), sizeof(uint64_t));
+                        _offset += (1 + sizeof(uint64_t));
+                        result = true;
+                    }
+
+                    if (result == false) {
+                        // Truncated or garbled, there is nothing more to read.
+                        _offset = _length;
+                    }
+                }
+
+                return (result);
+            }
+
+        private:
+            const uint8_t* _buffer;
+            const uint16_t _length;
+            uint16_t _offset;
+        };
+
+        template <typename TYPE>
+        void Append(string& result, const string& specification, const TYPE value)
+        {
+            char buffer[64];
+            int length = ::snprintf(buffer, sizeof(buffer), specification.c_str(), value);
+
+            if (length > 0) {
+                if (static_cast<uint32_t>(length) < sizeof(buffer)) {
+                    result.append(buffer, length);
+                } else {
+                    const string::size_type offset = result.length();
+                    result.resize(offset + length + 1);
+                    ::snprintf(&(result[offset]), length + 1, specification.c_str(), value);
+                    result.resize(offset + length);
+                }
+            }
+        }
+
+        int Width(const Argument& argument, const bool present)
+        {
+            return (present == true ? static_cast<int>(argument.AsSigned()) : 0);
+        }
+    }
+
+    /* static */ void DeferredMessage::Expand(string& result, const uint8_t buffer[], const uint16_t length)
+    {
+        result.clear();
+
+        if (IsDeferred(buffer, length) == true) {
+            const uint8_t* end = static_cast<const uint8_t*>(::memchr(&(buffer[2]), '\0', length - 2));
+
+            if (end != nullptr) {
+                const char* format = reinterpret_cast<const char*>(&(buffer[2]));
+                const uint16_t offset = static_cast<uint16_t>(end - buffer + 1);
+                Arguments arguments(&(buffer[offset]), length - offset);
+
+                while (*format != '\0') {
+                    const char* marker = ::strchr(format, '%');
+
+                    if (marker == nullptr) {
+                        result.append(format);
+                        format += ::strlen(format);
+                    } else if (marker[1] == '%') {
+                        result.append(format, marker - format + 1);
+                        format = marker + 2;
+                    } else {
+                        Argument argument;
+                        string specification(1, '%');
+
+                        result.append(format, marker - format);
+                        format = marker + 1;
+
+                        while ((*format != '\0') && (::strchr("-+ #0'", *format) != nullptr)) {
+                            specification += *format++;
+                        }
+                        if (*format == '*') {
+                            bool present = arguments.Next(argument);
+                            specification += Core::NumberType<int>(Width(argument, present)).Text();
+                            format++;
+                        } else {
+                            while (::isdigit(*format) != 0) {
+                                specification += *format++;
+                            }
+                        }
+                        if (*format == '.') {
+                            specification += *format++;
+
+                            if (*format == '*') {
+                                bool present = arguments.Next(argument);
+                                specification += Core::NumberType<int>(Width(argument, present)).Text();
+                                format++;
+                            } else {
+                                while (::isdigit(*format) != 0) {
+                                    specification += *format++;
+                                }
+                            }
+                        }
+
+                        // The arguments are shipped at their widest, so the length modifiers
+                        // of the format no longer apply.
+                        while ((*format != '\0') && (::strchr("hlLqjzt", *format) != nullptr)) {
+                            format++;
+                        }
+
+                        const char conversion = *format;
+
+                        if (conversion != '\0') {
+                            format++;
+
+                            if (arguments.Next(argument) == true) {
+                                switch (conversion) {
+                                case 'd':
+                                case 'i':
+                                    Append(result, specification + "ll" + conversion, argument.AsSigned());
+                                    break;
+                                case 'o':
+                                case 'u':
+                                case 'x':
+                                case 'X':
+                                    Append(result, specification + "ll" + conversion, argument.AsUnsigned());
+                                    break;
+                                case 'c':
+                                    Append(result, specification + conversion, static_cast<int>(argument.AsSigned()));
+                                    break;
+                                case 'e':
+                                case 'E':
+                                case 'f':
+                                case 'F':
+                                case 'g':
+                                case 'G':
+                                case 'a':
+                                case 'A':
+                                    Append(result, specification + conversion, argument.AsReal());
+                                    break;
+                                case 's':
+                                    Append(result, specification + 's', (argument.Type == TEXT ? argument.Text : "(null)"));
+                                    break;
+                                case 'p':
+                                    if (argument.Type == TEXT) {
+                                        Append(result, specification + 's', argument.Text);
+                                    } else {
+                                        Append(result, specification + 'p', reinterpret_cast<void*>(static_cast<uintptr_t>(argument.Unsigned)));
+                                    }
+                                    break;
+                                default:
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+} // namespace Messaging
+}
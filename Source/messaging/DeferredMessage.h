@@ -0,0 +1,269 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+namespace WPEFramework {
+
+namespace Messaging {
+
+    // A deferred message carries the format and the raw arguments of a trace, the
+    // text is only formatted by whoever reads it. On the wire it starts as an empty
+    // TextMessage followed by a marker, the format and the tagged arguments, so a
+    // reader that does not know about it shows an empty message.
+    class EXTERNAL DeferredMessage {
+    public:
+        static constexpr uint8_t Marker = 0xD5;
+        static constexpr uint16_t MaxLength = 1024;
+
+        enum tag : uint8_t {
+            SIGNED = 1,
+            UNSIGNED = 2,
+            REAL = 3,
+            TEXT = 4,
+            POINTER = 5
+        };
+
+        template <typename TYPE>
+        struct IsText {
+            using Type = typename std::decay<TYPE>::type;
+
+            static constexpr bool value = (std::is_same<Type, string>::value)
+                || (std::is_same<Type, char*>::value) || (std::is_same<Type, const char*>::value);
+        };
+
+        // Only types that can be shipped without running any code of them.
+        template <typename TYPE>
+        struct IsSupported {
+            using Type = typename std::decay<TYPE>::type;
+            using Pointee = typename std::remove_cv<typename std::remove_pointer<Type>::type>::type;
+
+            static constexpr bool value = (std::is_arithmetic<Type>::value) || (std::is_enum<Type>::value) || (IsText<Type>::value)
+                || ((std::is_pointer<Type>::value) && (std::is_same<Pointee, wchar_t>::value == false));
+        };
+
+        class Encoder {
+        public:
+            Encoder() = delete;
+            Encoder(const Encoder&) = delete;
+            Encoder& operator=(const Encoder&) = delete;
+
+            Encoder(uint8_t buffer[], const uint16_t size)
+                : _buffer(buffer)
+                , _size(size)
+                , _offset(0)
+            {
+            }
+            ~Encoder() = default;
+
+        public:
+            uint16_t Length() const
+            {
+                return (_offset);
+            }
+            void Header(const char format[])
+            {
+                if (_size >= 2) {
+                    _buffer[0] = '\0';
+                    _buffer[1] = Marker;
+                    _offset = 2;
+                    Text(format);
+                }
+            }
+            template <typename TYPE>
+            typename std::enable_if<(std::is_integral<TYPE>::value) && (std::is_signed<TYPE>::value)>::type
+            Add(const TYPE value)
+            {
+                Number(SIGNED, static_cast<int64_t>(value));
+            }
+            template <typename TYPE>
+            typename std::enable_if<(std::is_integral<TYPE>::value) && (std::is_signed<TYPE>::value == false)>::type
+            Add(const TYPE value)
+            {
+                Number(UNSIGNED, static_cast<uint64_t>(value));
+            }
+            template <typename TYPE>
+            typename std::enable_if<std::is_floating_point<TYPE>::value>::type
+            Add(const TYPE value)
+            {
+                Number(REAL, static_cast<double>(value));
+            }
+            template <typename TYPE>
+            typename std::enable_if<std::is_enum<TYPE>::value>::type
+            Add(const TYPE value)
+            {
+                Add(static_cast<typename std::underlying_type<TYPE>::type>(value));
+            }
+            template <typename TYPE>
+            typename std::enable_if<(std::is_pointer<TYPE>::value) && (IsText<TYPE>::value == false)>::type
+            Add(const TYPE value)
+            {
+                Number(POINTER, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+            }
+            void Add(const char value[])
+            {
+                if (value == nullptr) {
+                    Number(POINTER, static_cast<uint64_t>(0));
+                } else if (Reserve(1) == true) {
+                    _buffer[_offset++] = TEXT;
+                    Text(value);
+                }
+            }
+            void Add(const string& value)
+            {
+                Add(value.c_str());
+            }
+
+        private:
+            bool Reserve(const uint16_t length) const
+            {
+                return ((_size - _offset) >= length);
+            }
+            template <typename TYPE>
+            void Number(const tag type, const TYPE value)
+            {
+                if (Reserve(1 + sizeof(TYPE)) == true) {
+                    _buffer[_offset] = type;
+                    ::memcpy(&(_buffer[_offset + 1]), &value, sizeof(TYPE));
+                    _offset += (1 + sizeof(TYPE));
+                } else {
+                    _offset = _size;
+                }
+            }
+            void Text(const char text[])
+            {
+                // Cut the text if it does not fit, it is always terminated.
+                if (Reserve(1) == true) {
+                    const uint16_t length = static_cast<uint16_t>(std::min(::strlen(text), static_cast<size_t>(_size - _offset - 1)));
+
+                    ::memcpy(&(_buffer[_offset]), text, length);
+                    _buffer[_offset + length] = '\0';
+                    _offset += (length + 1);
+                }
+            }
+
+        private:
+            uint8_t* _buffer;
+            const uint16_t _size;
+            uint16_t _offset;
+        };
+
+    public:
+        static bool IsDeferred(const uint8_t buffer[], const uint16_t length)
+        {
+            return ((length >= 2) && (buffer[0] == '\0') && (buffer[1] == Marker));
+        }
+        static const char* Format(const char format[])
+        {
+            return (format);
+        }
+        static const char* Format(const string& format)
+        {
+            return (format.c_str());
+        }
+
+        // Formats the message as Core::Format would have done it on the sending side.
+        static void Expand(string& result, const uint8_t buffer[], const uint16_t length);
+    };
+
+    template <typename... ARGS>
+    class DeferredArguments;
+
+    template <>
+    class DeferredArguments<> {
+    public:
+        void Encode(DeferredMessage::Encoder&) const
+        {
+        }
+    };
+
+    template <typename FIRST, typename... REST>
+    class DeferredArguments<FIRST, REST...> {
+    public:
+        DeferredArguments(const FIRST& first, const REST&... rest)
+            : _first(first)
+            , _rest(rest...)
+        {
+        }
+
+    public:
+        void Encode(DeferredMessage::Encoder& encoder) const
+        {
+            encoder.Add(_first);
+            _rest.Encode(encoder);
+        }
+
+    private:
+        const FIRST& _first;
+        DeferredArguments<REST...> _rest;
+    };
+
+    // The sending side, it only references the arguments so it must not outlive them.
+    template <typename... ARGS>
+    class DeferredMessageType : public Core::Messaging::IEvent {
+    public:
+        DeferredMessageType() = delete;
+        DeferredMessageType(const DeferredMessageType<ARGS...>&) = delete;
+        DeferredMessageType<ARGS...>& operator=(const DeferredMessageType<ARGS...>&) = delete;
+
+        DeferredMessageType(const char format[], const ARGS&... args)
+            : _format(format)
+            , _arguments(args...)
+            , _text()
+        {
+        }
+        ~DeferredMessageType() override = default;
+
+    public:
+        uint16_t Serialize(uint8_t buffer[], const uint16_t bufferSize) const override
+        {
+            DeferredMessage::Encoder encoder(buffer, bufferSize);
+
+            encoder.Header(_format);
+            _arguments.Encode(encoder);
+
+            return (encoder.Length());
+        }
+        uint16_t Deserialize(const uint8_t[], const uint16_t) override
+        {
+            // Received messages are read through the TextMessage.
+            ASSERT(false);
+            return (0);
+        }
+        const string& Data() const override
+        {
+            // Only needed for direct output, format it the way the receiver would.
+            if (_text.empty() == true) {
+                uint8_t buffer[DeferredMessage::MaxLength];
+                DeferredMessage::Expand(_text, buffer, Serialize(buffer, sizeof(buffer)));
+            }
+
+            return (_text);
+        }
+
+    private:
+        const char* _format;
+        DeferredArguments<ARGS...> _arguments;
+        mutable string _text;
+    };
+
+} // namespace Messaging
+}
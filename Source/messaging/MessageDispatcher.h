@@ -102,6 +102,68 @@ namespace Messaging {
             Core::DoorBell _doorBell;
         };
 
+        // Messages are staged per thread. Whoever gets to flush moves all staged messages
+        // into the shared buffer, one reservation per stage, and rings the doorbell once.
+        class Stage {
+        public:
+            Stage(const Stage&) = delete;
+            Stage& operator=(const Stage&) = delete;
+
+            Stage()
+                : _lock()
+                , _buffer()
+                , _used(0)
+            {
+            }
+            ~Stage() = default;
+
+        public:
+            void Size(const uint16_t size)
+            {
+                _buffer.resize(size);
+            }
+            void Lock()
+            {
+                _lock.Lock();
+            }
+            void Unlock()
+            {
+                _lock.Unlock();
+            }
+            uint16_t Used() const
+            {
+                return (_used);
+            }
+            uint16_t Free() const
+            {
+                return (static_cast<uint16_t>(_buffer.size()) - _used);
+            }
+            const uint8_t* Data() const
+            {
+                return (_buffer.data());
+            }
+            // Stored the way the DataBuffer stores it, so it can be copied over as is.
+            void Append(const uint16_t fullLength, const uint8_t value[], const uint16_t length)
+            {
+                ::memcpy(&(_buffer[_used]), &fullLength, sizeof(fullLength));
+                ::memcpy(&(_buffer[_used + sizeof(fullLength)]), value, length);
+                _used += fullLength;
+            }
+            void Clear()
+            {
+                _used = 0;
+            }
+
+        private:
+            Core::CriticalSection _lock;
+            std::vector<uint8_t> _buffer;
+            uint16_t _used;
+        };
+
+        static constexpr uint8_t MaxStages = 8;
+        static constexpr uint16_t MinStageSize = 1024;
+        static constexpr uint16_t MaxStageSize = 4096;
+
     public:
         MessageDataBuffer(const MessageDataBuffer&) = delete;
         MessageDataBuffer& operator=(const MessageDataBuffer&) = delete;
@@ -118,6 +180,10 @@ namespace Messaging {
             : _filenames(PrepareFilenames(baseDirectory, identifier, instanceId, socketPort))
             , _dataLock()
             , _initialize(initialize)
+            , _stages(nullptr)
+            , _stageCount(0)
+            , _staged(0)
+            , _flushing(false)
             // clang-format off
             , _dataBuffer(_filenames.doorBell, _filenames.data,  Core::File::USER_READ    |
                                                                  Core::File::USER_WRITE   |
@@ -131,9 +197,29 @@ namespace Messaging {
             // clang-format on
         {
             if (_dataBuffer.IsValid() == true) {
-                if ( (initialize == false) && (_dataBuffer.Used() > 0) ) {
-                    TRACE_L1("%d bytes already in the buffer instance %d", _dataBuffer.Used(), instanceId);
-                    _dataBuffer.Ring();
+                // Only the side that creates the buffer produces, give it a stage per thread as long as
+                // a flushed stage is small compared to the buffer.
+                const uint16_t stageSize = std::min(static_cast<uint16_t>(MaxStageSize), static_cast<uint16_t>(dataSize / 4));
+
+                if ((initialize == true) && (stageSize >= MinStageSize)) {
+                    const uint32_t cores = std::thread::hardware_concurrency();
+
+                    _stageCount = (cores == 0 ? 1 : static_cast<uint8_t>(std::min(cores, static_cast<uint32_t>(MaxStages))));
+                    _stages = new Stage[_stageCount];
+
+                    for (uint8_t index = 0; index < _stageCount; index++) {
+                        _stages[index].Size(stageSize);
+                    }
+                }
+
+                if (initialize == false) {
+                    // Whatever was signalled before we were here, the producers should signal us again.
+                    _dataBuffer.Signalled();
+
+                    if (_dataBuffer.Used() > 0) {
+                        TRACE_L1("%d bytes already in the buffer instance %d", _dataBuffer.Used(), instanceId);
+                        _dataBuffer.Ring();
+                    }
                 }
             }
             else {
@@ -154,6 +240,8 @@ namespace Messaging {
                 _dataBuffer.Unlink();
                 _dataLock.Unlock();
             }
+
+            delete[] _stages;
         }
 
     public:
@@ -162,8 +250,10 @@ namespace Messaging {
         }
 
         /**
-        * @brief Writes data into cyclic buffer. After writing everything, this side should call Ring() to notify other side.
-        *        To receive this data other side needs to wait for the doorbell ring and then use PopData
+        * @brief Writes data into cyclic buffer and notifies the other side, if it is not notified yet.
+        *        To receive this data other side needs to wait for the doorbell ring and then use PopData.
+        *        On the producing side the data is staged per thread, it is in the cyclic buffer once this
+        *        call, or a call on another thread that takes over the flushing, returns.
         *
         * @param length length of message
         * @param value buffer
@@ -178,24 +268,44 @@ namespace Messaging {
             ASSERT(length > 0);
             ASSERT(value != nullptr);
 
-            _dataLock.Lock();
+            if (_stageCount == 0) {
+                _dataLock.Lock();
+                result = Write(fullLength, value, length);
+                _dataLock.Unlock();
 
-            if (_dataBuffer.IsValid() == true) {
-                const uint16_t reservedLength = _dataBuffer.Reserve(fullLength);
+                if (result == Core::ERROR_NONE) {
+                    Notify();
+                }
+            }
+            else {
+                Stage& stage(_stages[std::hash<std::thread::id>()(std::this_thread::get_id()) % _stageCount]);
 
-                if (reservedLength >= fullLength) {
-                    //no need to serialize because we can write to CyclicBuffer step by step
-                    _dataBuffer.Write(reinterpret_cast<const uint8_t*>(&fullLength), sizeof(fullLength)); //fullLength
-                    _dataBuffer.Write(value, length); //value
-                    _dataBuffer.Ring();
+                stage.Lock();
+
+                if (stage.Free() < fullLength) {
+                    // Keep the order of this thread, what is staged goes first.
+                    Drain(stage);
+                }
+
+                if (stage.Free() >= fullLength) {
+                    stage.Append(fullLength, value, length);
+                    _staged += fullLength;
                     result = Core::ERROR_NONE;
                 }
                 else {
-                    TRACE_L1("Buffer to small to fit message!");
+                    _dataLock.Lock();
+                    result = Write(fullLength, value, length);
+                    _dataLock.Unlock();
+
+                    if (result == Core::ERROR_NONE) {
+                        Notify();
+                    }
                 }
-            }
 
-            _dataLock.Unlock();
+                stage.Unlock();
+
+                Flush();
+            }
 
             return (result);
         }
@@ -221,7 +331,14 @@ namespace Messaging {
             _dataLock.Lock();
 
             if (_dataBuffer.IsValid() == true) {
-                const uint32_t length = _dataBuffer.Read(outValue, outLength, true);
+                uint32_t length = _dataBuffer.Read(outValue, outLength, true);
+
+                if (length == 0) {
+                    // All caught up, from now on producers should notify again. Anything they
+                    // wrote before they saw the flag lowered, is picked up here.
+                    _dataBuffer.Signalled();
+                    length = _dataBuffer.Read(outValue, outLength, true);
+                }
                 
                 if (length > 0) {
                     if (length > outLength) {
@@ -255,6 +372,7 @@ namespace Messaging {
             
             if (_dataBuffer.IsValid() == true) {
                 _dataBuffer.Flush();
+                _dataBuffer.Signalled();
             }
 
             _dataLock.Unlock();
@@ -314,9 +432,88 @@ namespace Messaging {
             return { doorBellFilename, metaDataFilename, dataFilename };
         }
 
+        // Should be called with the _dataLock taken.
+        uint32_t Write(const uint16_t fullLength, const uint8_t value[], const uint16_t length)
+        {
+            uint32_t result = Core::ERROR_WRITE_ERROR;
+
+            if (_dataBuffer.IsValid() == true) {
+                const uint16_t reservedLength = _dataBuffer.Reserve(fullLength);
+
+                if (reservedLength >= fullLength) {
+                    //no need to serialize because we can write to CyclicBuffer step by step
+                    _dataBuffer.Write(reinterpret_cast<const uint8_t*>(&fullLength), sizeof(fullLength)); //fullLength
+                    _dataBuffer.Write(value, length); //value
+                    result = Core::ERROR_NONE;
+                }
+                else {
+                    TRACE_L1("Buffer to small to fit message!");
+                }
+            }
+
+            return (result);
+        }
+        // Should be called with the lock of the stage taken.
+        bool Drain(Stage& stage)
+        {
+            bool written = false;
+
+            if (stage.Used() > 0) {
+                _dataLock.Lock();
+
+                if (_dataBuffer.IsValid() == true) {
+                    const uint32_t reservedLength = _dataBuffer.Reserve(stage.Used());
+
+                    if (reservedLength >= stage.Used()) {
+                        _dataBuffer.Write(stage.Data(), stage.Used());
+                        written = true;
+                    }
+                    else {
+                        TRACE_L1("Buffer to small to fit the staged messages!");
+                    }
+                }
+
+                _dataLock.Unlock();
+
+                // Also if they were lost, they can not be written anymore.
+                _staged -= stage.Used();
+                stage.Clear();
+
+                if (written == true) {
+                    Notify();
+                }
+            }
+
+            return (written);
+        }
+        void Flush()
+        {
+            // Only one thread flushes, it keeps going as long as others staged messages in the
+            // meantime. If another thread is flushing, it will pick up what we staged.
+            while ((_staged != 0) && (_flushing.exchange(true) == false)) {
+                for (uint8_t index = 0; index < _stageCount; index++) {
+                    _stages[index].Lock();
+                    Drain(_stages[index]);
+                    _stages[index].Unlock();
+                }
+
+                _flushing = false;
+            }
+        }
+        void Notify()
+        {
+            if (_dataBuffer.Signal() == true) {
+                _dataBuffer.Ring();
+            }
+        }
+
     private:
         mutable Core::CriticalSection _dataLock;
         bool _initialize;
+        Stage* _stages;
+        uint8_t _stageCount;
+        std::atomic<uint32_t> _staged;
+        std::atomic<bool> _flushing;
         DataBuffer _dataBuffer;
     };
 
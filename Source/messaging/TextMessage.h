@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Module.h"
+#include "DeferredMessage.h"
 
 namespace WPEFramework {
 
@@ -58,20 +59,36 @@ namespace Messaging {
 
         uint16_t Deserialize(const uint8_t buffer[], const uint16_t bufferSize) override
         {
-            Core::FrameType<0> frame(const_cast<uint8_t*>(buffer), bufferSize, bufferSize);
-            Core::FrameType<0>::Reader reader(frame, 0);
+            uint16_t length = bufferSize;
 
-            _text = reader.NullTerminatedText();
+            if (DeferredMessage::IsDeferred(buffer, bufferSize) == true) {
+                // Keep it as it is, it is only formatted if someone asks for the text.
+                _deferred.assign(reinterpret_cast<const char*>(buffer), bufferSize);
+                _text.clear();
+            }
+            else {
+                Core::FrameType<0> frame(const_cast<uint8_t*>(buffer), bufferSize, bufferSize);
+                Core::FrameType<0>::Reader reader(frame, 0);
 
-            return (static_cast<uint16_t>(_text.size() + 1));
+                _deferred.clear();
+                _text = reader.NullTerminatedText();
+                length = static_cast<uint16_t>(_text.size() + 1);
+            }
+
+            return (length);
         }
 
         const string& Data() const override {
+            if (_deferred.empty() == false) {
+                DeferredMessage::Expand(_text, reinterpret_cast<const uint8_t*>(_deferred.data()), static_cast<uint16_t>(_deferred.length()));
+                _deferred.clear();
+            }
             return (_text);
         }
 
     private:
-        string _text;
+        mutable string _text;
+        mutable string _deferred;
     };
 
 } // namespace Messaging
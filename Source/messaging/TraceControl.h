@@ -22,6 +22,87 @@
 #include "Module.h"
 #include "Control.h"
 #include "TextMessage.h"
+#include "DeferredMessage.h"
+
+namespace WPEFramework {
+
+namespace Messaging {
+
+    template <typename CATEGORY, typename ENABLE = void>
+    struct IsDeferredCategory : public std::false_type {
+    };
+
+    // Categories declared by DEFINE_MESSAGING_CATEGORY do nothing more than Core::Format.
+    template <typename CATEGORY>
+    struct IsDeferredCategory<CATEGORY, typename std::enable_if<std::is_same<typename CATEGORY::DeferredCategory, CATEGORY>::value>::type> : public std::true_type {
+    };
+
+    template <typename... ARGS>
+    struct IsDeferredArguments : public std::true_type {
+    };
+
+    template <typename FIRST, typename... REST>
+    struct IsDeferredArguments<FIRST, REST...> : public std::integral_constant<bool, (DeferredMessage::IsSupported<FIRST>::value) && (IsDeferredArguments<REST...>::value)> {
+    };
+
+    // A trace is only deferred if it has a format and arguments, a lone text is taken as is.
+    template <typename CATEGORY, typename... ARGS>
+    struct IsDeferrable : public std::false_type {
+    };
+
+    template <typename CATEGORY, typename FORMAT, typename FIRST, typename... REST>
+    struct IsDeferrable<CATEGORY, FORMAT, FIRST, REST...> : public std::integral_constant<bool,
+#ifdef __MESSAGING_BINARY_TRACING__
+        (IsDeferredCategory<CATEGORY>::value) && (DeferredMessage::IsText<FORMAT>::value) && (IsDeferredArguments<FIRST, REST...>::value)
+#else
+        false
+#endif
+        > {
+    };
+
+    // Pushes a trace of the CATEGORY. In binary mode the format and the arguments are
+    // pushed if possible, otherwise the trace is formatted here.
+    template <typename CATEGORY>
+    class TraceDispatcherType {
+    public:
+        TraceDispatcherType() = delete;
+        TraceDispatcherType(const TraceDispatcherType<CATEGORY>&) = delete;
+        TraceDispatcherType<CATEGORY>& operator=(const TraceDispatcherType<CATEGORY>&) = delete;
+
+        explicit TraceDispatcherType(const Core::Messaging::MessageInfo& info)
+            : _info(info)
+        {
+        }
+        ~TraceDispatcherType() = default;
+
+    public:
+        template <typename... ARGS>
+        void operator()(ARGS&&... args) const
+        {
+            Push(IsDeferrable<CATEGORY, ARGS...>(), std::forward<ARGS>(args)...);
+        }
+
+    private:
+        template <typename... ARGS>
+        void Push(const std::false_type&, ARGS&&... args) const
+        {
+            CATEGORY data(std::forward<ARGS>(args)...);
+            TextMessage message(data.Data());
+            MessageUnit::Instance().Push(_info, &message);
+        }
+        template <typename FORMAT, typename... ARGS>
+        void Push(const std::true_type&, const FORMAT& format, const ARGS&... args) const
+        {
+            DeferredMessageType<ARGS...> message(DeferredMessage::Format(format), args...);
+            MessageUnit::Instance().Push(_info, &message);
+        }
+
+    private:
+        const Core::Messaging::MessageInfo& _info;
+    };
+
+} // namespace Messaging
+}
 
 #ifdef _THUNDER_PRODUCTION
 
@@ -44,7 +125,8 @@
     do {                                                                                     \
         using __control__ = TRACE_CONTROL(CATEGORY);                                         \
         if (__control__::IsEnabled() == true) {                                              \
-            CATEGORY __data__ PARAMETERS;                                                    \
+            static const string __class__(WPEFramework::Core::ClassNameOnly(                 \
+                typeid(typename std::remove_pointer<decltype(this)>::type).name()).Text());  \
             WPEFramework::Core::Messaging::MessageInfo __info__(                             \
                 __control__::Metadata(),                                                     \
                 WPEFramework::Core::Time::Now().Ticks()                                      \
@@ -53,10 +135,10 @@
                 __info__,                                                                    \
                 __FILE__,                                                                    \
                 __LINE__,                                                                    \
-                WPEFramework::Core::ClassNameOnly(typeid(*this).name()).Text()               \
+                __class__                                                                    \
             );                                                                               \
-            WPEFramework::Messaging::TextMessage __message__(__data__.Data());               \
-            WPEFramework::Messaging::MessageUnit::Instance().Push(__trace__, &__message__);  \
+            const WPEFramework::Messaging::TraceDispatcherType<CATEGORY> __dispatch__(__trace__); \
+            __dispatch__ PARAMETERS;                                                         \
         }                                                                                    \
     } while(false)
 
@@ -64,7 +146,6 @@
     do {                                                                                     \
         using __control__ = TRACE_CONTROL(CATEGORY);                                         \
         if (__control__::IsEnabled() == true) {                                              \
-            CATEGORY __data__ PARAMETERS;                                                    \
             WPEFramework::Core::Messaging::MessageInfo __info__(                             \
                 __control__::Metadata(),                                                     \
                 WPEFramework::Core::Time::Now().Ticks()                                      \
@@ -75,8 +156,8 @@
                 __LINE__,                                                                    \
                 __FUNCTION__                                                                 \
             );                                                                               \
-            WPEFramework::Messaging::TextMessage __message__(__data__.Data());               \
-            WPEFramework::Messaging::MessageUnit::Instance().Push(__trace__, &__message__);  \
+            const WPEFramework::Messaging::TraceDispatcherType<CATEGORY> __dispatch__(__trace__); \
+            __dispatch__ PARAMETERS;                                                         \
         }                                                                                    \
     } while(false)
 
@@ -92,6 +92,7 @@ namespace PluginHost {
                 : _parent(parent)
                 , _current()
                 , _offset(0)
+                , _packed()
             {
             }
             ~SerializerImpl()
@@ -111,15 +112,21 @@ namespace PluginHost {
                 }
 
                 if (_current.IsValid() == true) {
-                    loaded = _current->Serialize(stream, length, _offset);
+                    if (_parent.IsPacked() == false) {
+                        loaded = _current->Serialize(stream, length, _offset);
+                    } else {
+                        loaded = Pack(reinterpret_cast<uint8_t*>(stream), length);
+                    }
                     if ( (_offset == 0) || (loaded != length) ) {
                         _current.Release();
                     }
 #if THUNDER_PERFORMANCE
                     else {
 			Core::ProxyType<const TrackingJSONRPC> tracking(_current);
-                        ASSERT (tracking.IsValid() == true);
-                        const_cast<TrackingJSONRPC&>(*tracking).Out(loaded);
+                        // Events are serialized once for all channels, they are not tracked.
+                        if (tracking.IsValid() == true) {
+                            const_cast<TrackingJSONRPC&>(*tracking).Out(loaded);
+                        }
                     }
 #endif
                 }
@@ -127,10 +134,38 @@ namespace PluginHost {
                 return (loaded);
             }
 
+        private:
+            // Not all elements speak MessagePack (e.g. the events, shared by all channels), so
+            // what goes out is transcoded from the JSON text.
+            uint16_t Pack(uint8_t stream[], const uint16_t length) const
+            {
+                if (_offset == 0) {
+                    string text;
+
+                    _packed.clear();
+                    _current->ToString(text);
+                    Core::JSON::IMessagePack::FromText(text, _packed);
+                }
+
+                const uint16_t loaded = static_cast<uint16_t>(std::min(static_cast<size_t>(length), _packed.size() - _offset));
+
+                if (loaded > 0) {
+                    ::memcpy(stream, &(_packed[_offset]), loaded);
+                    _offset += loaded;
+                }
+                if (_offset >= _packed.size()) {
+                    _packed.clear();
+                    _offset = 0;
+                }
+
+                return (loaded);
+            }
+
         private:
             Channel& _parent;
             mutable Core::ProxyType<const Core::JSON::IElement> _current;
             mutable uint32_t _offset;
+            mutable std::vector<uint8_t> _packed;
         };
         class EXTERNAL DeserializerImpl {
         public:
@@ -164,7 +199,13 @@ namespace PluginHost {
                     }
                 } 
                 if (_current.IsValid() == true) {
-                    loaded = _current->Deserialize(stream, length, _offset);
+                    Core::JSON::IMessagePack* packed = (_parent.IsPacked() == false ? nullptr : dynamic_cast<Core::JSON::IMessagePack*>(&(*_current)));
+
+                    if (packed == nullptr) {
+                        loaded = _current->Deserialize(stream, length, _offset);
+                    } else {
+                        loaded = packed->Deserialize(reinterpret_cast<const uint8_t*>(stream), length, _offset);
+                    }
 #if THUNDER_PERFORMANCE
 		    Core::ProxyType<TrackingJSONRPC> tracking (_current);
                     ASSERT (tracking.IsValid() == true);
@@ -198,6 +239,7 @@ namespace PluginHost {
             RAW = 0x08,
             TEXT = 0x10,
             JSONRPC = 0x20,
+            PACKED = 0x2000,
             PINGED = 0x4000,
             NOTIFIED = 0x8000
         };
@@ -258,6 +300,11 @@ namespace PluginHost {
         {
             return ((_state & NOTIFIED) != 0);
         }
+        // JSON(RPC) over MessagePack, in binary frames.
+        bool IsPacked() const
+        {
+            return ((_state & PACKED) != 0);
+        }
         void Submit(const string& text)
         {
             if (IsOpen() == true) {
@@ -322,9 +369,19 @@ namespace PluginHost {
         {
             BaseClass::Lock();
 
-            Binary(state == RAW);
+            _state = state | (notification ? NOTIFIED : 0x0000) | (_state & PACKED);
+
+            Binary((state == RAW) || ((_state & PACKED) != 0));
+
+            BaseClass::Unlock();
+        }
+        void Packed()
+        {
+            BaseClass::Lock();
+
+            _state |= PACKED;
 
-            _state = state | (notification ? NOTIFIED : 0x0000);
+            Binary(true);
 
             BaseClass::Unlock();
         }
@@ -32,6 +32,12 @@ namespace PluginHost {
     struct EXTERNAL ILocalDispatcher : public IDispatcher {
         virtual ~ILocalDispatcher() = default;
 
+        using IDispatcher::Invoke;
+
+        // As the IDispatcher::Invoke, but typed handlers return their result object as is, so it
+        // can be serialized straight into the response. If no object is returned, the response holds it.
+        virtual uint32_t Invoke(const uint32_t channelId, const uint32_t id, const string& token, const string& method, const string& parameters, string& response, Core::ProxyType<const Core::JSON::IElement>& result) = 0;
+
         virtual void Activate(IShell* service) = 0;
         virtual void Deactivate() = 0;
         virtual void Dropped(const IDispatcher::ICallback* callback) = 0;
@@ -74,6 +80,208 @@ namespace PluginHost {
         };
 
     private:
+        // An event as it is send to a channel. The parameters are serialized once and shared by
+        // all subscribers, only the method, that carries the designator, is their own.
+        class EventMessage : public Core::JSON::IElement {
+        public:
+            class Payload {
+            public:
+                Payload() = delete;
+                Payload(const Payload&) = delete;
+                Payload& operator=(const Payload&) = delete;
+
+                Payload(const string& parameters)
+                    : _text(parameters.empty() == true ? string(_T("}")) : (_T(",\"params\":") + parameters + '}'))
+                {
+                }
+                ~Payload() = default;
+
+            public:
+                const string& Text() const {
+                    return (_text);
+                }
+
+            private:
+                const string _text;
+            };
+
+        public:
+            EventMessage() = delete;
+            EventMessage(const EventMessage&) = delete;
+            EventMessage& operator=(const EventMessage&) = delete;
+
+            EventMessage(const string& method, const Core::ProxyType<const Payload>& payload)
+                : _method()
+                , _payload(payload)
+            {
+                Core::JSON::String designator;
+                string text;
+
+                designator = method;
+                designator.ToString(text);
+
+                _method = _T("{\"jsonrpc\":\"") + string(Core::JSONRPC::Message::DefaultVersion) + _T("\",\"method\":") + text;
+            }
+            ~EventMessage() override = default;
+
+        public:
+            // Stateless, the position is kept by the caller, so one message can be send on many channels at once.
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
+            {
+                const string& payload(_payload->Text());
+                const uint32_t length = static_cast<uint32_t>(_method.length() + payload.length());
+                uint16_t loaded = 0;
+
+                while ((loaded < maxLength) && (offset < length)) {
+                    const bool head = (offset < _method.length());
+                    const string& part(head == true ? _method : payload);
+                    const uint32_t start = (head == true ? offset : offset - static_cast<uint32_t>(_method.length()));
+                    const uint16_t size = static_cast<uint16_t>(std::min(static_cast<uint32_t>(maxLength - loaded), static_cast<uint32_t>(part.length() - start)));
+
+                    ::memcpy(&(stream[loaded]), &(part[start]), size);
+                    loaded += size;
+                    offset += size;
+                }
+
+                if (offset >= length) {
+                    offset = 0;
+                }
+
+                return (loaded);
+            }
+            uint16_t Deserialize(const char[], const uint16_t, uint32_t&, Core::OptionalType<Core::JSON::Error>&) override
+            {
+                // It is only ever send.
+                ASSERT(false);
+                return (0);
+            }
+            void Clear() override
+            {
+            }
+            bool IsSet() const override
+            {
+                return (true);
+            }
+            bool IsNull() const override
+            {
+                return (false);
+            }
+
+        private:
+            string _method;
+            Core::ProxyType<const Payload> _payload;
+        };
+
+        // Collects whom an event has to go to, so it can be send once the lock is released.
+        class Fanout {
+        private:
+            class Callback {
+            public:
+                Callback() = delete;
+                Callback& operator=(const Callback&) = delete;
+
+                Callback(IDispatcher::ICallback* callback, const string& designator, const string& event)
+                    : _callback(callback)
+                    , _designator(designator)
+                    , _event(event)
+                {
+                    _callback->AddRef();
+                }
+                Callback(Callback&& move) noexcept
+                    : _callback(move._callback)
+                    , _designator(std::move(move._designator))
+                    , _event(std::move(move._event))
+                {
+                    move._callback = nullptr;
+                }
+                Callback(const Callback& copy)
+                    : _callback(copy._callback)
+                    , _designator(copy._designator)
+                    , _event(copy._event)
+                {
+                    if (_callback != nullptr) {
+                        _callback->AddRef();
+                    }
+                }
+                ~Callback()
+                {
+                    if (_callback != nullptr) {
+                        _callback->Release();
+                    }
+                }
+
+            public:
+                void Event(const string& parameters) const
+                {
+                    _callback->Event(_event, _designator, parameters);
+                }
+
+            private:
+                IDispatcher::ICallback* _callback;
+                string _designator;
+                string _event;
+            };
+
+            using Message = std::pair<uint32_t, Core::ProxyType<Core::JSON::IElement>>;
+            using Messages = std::unordered_map<string, Core::ProxyType<Core::JSON::IElement>>;
+
+        public:
+            Fanout() = delete;
+            Fanout(const Fanout&) = delete;
+            Fanout& operator=(const Fanout&) = delete;
+
+            Fanout(const string& parameters)
+                : _parameters(parameters)
+                , _payload()
+                , _messages()
+                , _channels()
+                , _callbacks()
+            {
+            }
+            ~Fanout() = default;
+
+        public:
+            void Add(const uint32_t channelId, const string& designator, const string& event)
+            {
+                const string method(designator + '.' + event);
+                Messages::iterator index(_messages.find(method));
+
+                if (index == _messages.end()) {
+                    if (_payload.IsValid() == false) {
+                        _payload = Core::ProxyType<const EventMessage::Payload>(Core::ProxyType<EventMessage::Payload>::Create(_parameters));
+                    }
+
+                    index = _messages.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(method),
+                        std::forward_as_tuple(Core::ProxyType<Core::JSON::IElement>(Core::ProxyType<EventMessage>::Create(method, _payload)))).first;
+                }
+
+                _channels.emplace_back(channelId, index->second);
+            }
+            void Add(IDispatcher::ICallback* callback, const string& designator, const string& event)
+            {
+                _callbacks.emplace_back(callback, designator, event);
+            }
+            void Send(IShell* service) const
+            {
+                ASSERT((_channels.empty() == true) || (service != nullptr));
+
+                for (const Message& entry : _channels) {
+                    service->Submit(entry.first, entry.second);
+                }
+                for (const Callback& entry : _callbacks) {
+                    entry.Event(_parameters);
+                }
+            }
+
+        private:
+            const string& _parameters;
+            Core::ProxyType<const EventMessage::Payload> _payload;
+            Messages _messages;
+            std::vector<Message> _channels;
+            std::vector<Callback> _callbacks;
+        };
+
         class Observer {
         private:
             class Destination {
@@ -264,14 +472,14 @@ namespace PluginHost {
                     }
                 }
             }
-            void Event(JSONRPC& parent, const string event, const string& parameter, const SendIfMethod& sendifmethod) {
+            void Event(Fanout& fanout, const string& event, const SendIfMethod& sendifmethod) {
                 for (Destination& entry : _designators) {
                     if (!sendifmethod || sendifmethod(entry.Designator())) {
                         if (entry.Callback() == nullptr) {
-                            parent.Notify(entry.ChannelId(), entry.Designator() + '.' + event, parameter);
+                            fanout.Add(entry.ChannelId(), entry.Designator(), event);
                         }
                         else {
-                            entry.Callback()->Event(event, entry.Designator(), parameter);
+                            fanout.Add(entry.Callback(), entry.Designator(), event);
                         }
                     }
                 }
@@ -596,80 +804,13 @@ namespace PluginHost {
         // Inherited via IDispatcher
         // ---------------------------------------------------------------------------------
         uint32_t Invoke(const uint32_t channelId, const uint32_t id, const string& token, const string& method, const string& parameters, string& response) override {
-            uint32_t result = Core::ERROR_PARSE_FAILURE;
-
-            if (method.empty() == false) {
-
-                ASSERT(Core::JSONRPC::Message::Callsign(method).empty() || (Core::JSONRPC::Message::Callsign(method) == _callsign));
-
-                string realMethod(Core::JSONRPC::Message::Method(method));
-
-                result = Core::ERROR_NONE;
-
-                if (_validate != nullptr) {
-                    classification validation = _validate(token, realMethod, parameters);
-                    if (validation == classification::INVALID) {
-                        result = Core::ERROR_PRIVILIGED_REQUEST;
-                    }
-                    else if (validation == classification::DEFERRED) {
-                        result = Core::ERROR_PRIVILIGED_DEFERRED;
-                    }
-                }
-
-                if (result == Core::ERROR_NONE) {
-
-                    // Seems we are on the right handler..
-                    // now see if someone supports this version
-
-                    if (realMethod == _T("versions")) {
-                        _versions.ToString(response);
-                        result = Core::ERROR_NONE;
-                    }
-                    else if (realMethod == _T("exists")) {
-                        if (Handler(parameters) == nullptr) {
-                            response = _T("0");
-                        }
-                        else {
-                            response = _T("1");
-                        }
-                    }
-                    else if (realMethod == _T("register")) {
-                        Registration info;  info.FromString(parameters);
-
-                        result = Subscribe(channelId, info.Event.Value(), info.Callsign.Value());
-                        if (result == Core::ERROR_NONE) {
-                            response = _T("0");
-                        }
-                        else {
-                            result = Core::ERROR_FAILED_REGISTERED;
-                        }
-                    }
-                    else if (realMethod == _T("unregister")) {
-                        Registration info;  info.FromString(parameters);
-
-                        result = Unsubscribe(channelId, info.Event.Value(), info.Callsign.Value());
-                        if (result == Core::ERROR_NONE) {
-                            response = _T("0");
-                        }
-                        else {
-                            result = Core::ERROR_FAILED_UNREGISTERED;
-                        }
-                    }
-                    else {
-                        Core::JSONRPC::Handler* handler(Handler(realMethod));
-
-                        if (handler == nullptr) {
-                            result = Core::ERROR_INCORRECT_URL;
-                        }
-                        else {
-                            Core::JSONRPC::Context context(channelId, id, token);
-                            result = handler->Invoke(context, Core::JSONRPC::Message::FullMethod(method), parameters, response);
-                        }
-                    }
-                }
-            }
+            return (InternalInvoke(channelId, id, token, method, parameters, response, nullptr));
+        }
 
-            return (result);
+        // Inherited via ILocalDispatcher
+        // ---------------------------------------------------------------------------------
+        uint32_t Invoke(const uint32_t channelId, const uint32_t id, const string& token, const string& method, const string& parameters, string& response, Core::ProxyType<const Core::JSON::IElement>& result) override {
+            return (InternalInvoke(channelId, id, token, method, parameters, response, &result));
         }
         Core::hresult Subscribe(ICallback* callback, const string& eventId, const string& designator) override
         {
@@ -869,16 +1010,98 @@ namespace PluginHost {
         }
 
     private:
+        uint32_t InternalInvoke(const uint32_t channelId, const uint32_t id, const string& token, const string& method, const string& parameters, string& response, Core::ProxyType<const Core::JSON::IElement>* object) {
+            uint32_t result = Core::ERROR_PARSE_FAILURE;
+
+            if (method.empty() == false) {
+
+                ASSERT(Core::JSONRPC::Message::Callsign(method).empty() || (Core::JSONRPC::Message::Callsign(method) == _callsign));
+
+                string realMethod(Core::JSONRPC::Message::Method(method));
+
+                result = Core::ERROR_NONE;
+
+                if (_validate != nullptr) {
+                    classification validation = _validate(token, realMethod, parameters);
+                    if (validation == classification::INVALID) {
+                        result = Core::ERROR_PRIVILIGED_REQUEST;
+                    }
+                    else if (validation == classification::DEFERRED) {
+                        result = Core::ERROR_PRIVILIGED_DEFERRED;
+                    }
+                }
+
+                if (result == Core::ERROR_NONE) {
+
+                    // Seems we are on the right handler..
+                    // now see if someone supports this version
+
+                    if (realMethod == _T("versions")) {
+                        _versions.ToString(response);
+                        result = Core::ERROR_NONE;
+                    }
+                    else if (realMethod == _T("exists")) {
+                        if (Handler(parameters) == nullptr) {
+                            response = _T("0");
+                        }
+                        else {
+                            response = _T("1");
+                        }
+                    }
+                    else if (realMethod == _T("register")) {
+                        Registration info;  info.FromString(parameters);
+
+                        result = Subscribe(channelId, info.Event.Value(), info.Callsign.Value());
+                        if (result == Core::ERROR_NONE) {
+                            response = _T("0");
+                        }
+                        else {
+                            result = Core::ERROR_FAILED_REGISTERED;
+                        }
+                    }
+                    else if (realMethod == _T("unregister")) {
+                        Registration info;  info.FromString(parameters);
+
+                        result = Unsubscribe(channelId, info.Event.Value(), info.Callsign.Value());
+                        if (result == Core::ERROR_NONE) {
+                            response = _T("0");
+                        }
+                        else {
+                            result = Core::ERROR_FAILED_UNREGISTERED;
+                        }
+                    }
+                    else {
+                        Core::JSONRPC::Handler* handler(Handler(realMethod));
+
+                        if (handler == nullptr) {
+                            result = Core::ERROR_INCORRECT_URL;
+                        }
+                        else if (object == nullptr) {
+                            Core::JSONRPC::Context context(channelId, id, token);
+                            result = handler->Invoke(context, Core::JSONRPC::Message::FullMethod(method), parameters, response);
+                        }
+                        else {
+                            Core::JSONRPC::Context context(channelId, id, token, *object);
+                            result = handler->Invoke(context, Core::JSONRPC::Message::FullMethod(method), parameters, response);
+                        }
+                    }
+                }
+            }
+
+            return (result);
+        }
+
         uint32_t InternalNotify(const string& event, const string& parameters, const SendIfMethod& sendifmethod = nullptr) const
         {
             uint32_t result = Core::ERROR_UNKNOWN_KEY;
+            Fanout fanout(parameters);
 
             _adminLock.Lock();
 
             ObserverMap::const_iterator index = _observers.find(event);
 
             if (index != _observers.end()) {
-                const_cast<Observer&>(index->second).Event(const_cast<JSONRPC&>(*this), event, parameters, sendifmethod);
+                const_cast<Observer&>(index->second).Event(fanout, event, sendifmethod);
             }
 
             // See if this is perhaps a registered alias for an event...
@@ -891,33 +1114,29 @@ namespace PluginHost {
                     ObserverMap::const_iterator index = _observers.find(alias);
 
                     if (index != _observers.end()) {
-                        const_cast<Observer&>(index->second).Event(const_cast<JSONRPC&>(*this), alias, parameters, sendifmethod);
+                        const_cast<Observer&>(index->second).Event(fanout, alias, sendifmethod);
                     }
                 }
             }
 
-            if (_service != nullptr) {
-                _service->Notify(event, parameters);
+            IShell* service = _service;
+
+            if (service != nullptr) {
+                service->AddRef();
             }
 
             _adminLock.Unlock();
 
-            return (result);
-        }
-        void Notify(const uint32_t channelId, const string& designator, const string& parameters)
-        {
-            Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>(IFactories::Instance().JSONRPC()));
-
-            ASSERT(_service != nullptr);
+            // Nothing is send while holding the lock, a slow channel or callback can not stall the
+            // (un)subscriptions and other events of this plugin.
+            fanout.Send(service);
 
-            if (!parameters.empty()) {
-                message->Parameters = parameters;
+            if (service != nullptr) {
+                service->Notify(event, parameters);
+                service->Release();
             }
 
-            message->Designator = designator;
-            message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
-
-            _service->Submit(channelId, Core::ProxyType<Core::JSON::IElement>(message));
+            return (result);
         }
 
     private:
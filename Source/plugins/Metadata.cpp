@@ -257,33 +257,47 @@ namespace PluginHost
         : Core::JSON::Container()
         , Id(0)
         , Job()
-        , Runs(0) {
+        , Runs(0)
+        , Steals(0)
+        , Depth(0) {
         Add(_T("id"), &Id);
         Add(_T("job"), &Job);
         Add(_T("runs"), &Runs);
+        Add(_T("steals"), &Steals);
+        Add(_T("depth"), &Depth);
     }
     Metadata::Server::Minion::Minion(Minion&& move)
         : Core::JSON::Container()
         , Id(std::move(move.Id))
         , Job(std::move(move.Job))
-        , Runs(std::move(move.Runs)) {
+        , Runs(std::move(move.Runs))
+        , Steals(std::move(move.Steals))
+        , Depth(std::move(move.Depth)) {
         Add(_T("id"), &Id);
         Add(_T("job"), &Job);
         Add(_T("runs"), &Runs);
+        Add(_T("steals"), &Steals);
+        Add(_T("depth"), &Depth);
     }
     Metadata::Server::Minion::Minion(const Minion& copy)
         : Core::JSON::Container()
         , Id(copy.Id)
         , Job(copy.Job)
-        , Runs(copy.Runs) {
+        , Runs(copy.Runs)
+        , Steals(copy.Steals)
+        , Depth(copy.Depth) {
         Add(_T("id"), &Id);
         Add(_T("job"), &Job);
         Add(_T("runs"), &Runs);
+        Add(_T("steals"), &Steals);
+        Add(_T("depth"), &Depth);
     }
     Metadata::Server::Minion& Metadata::Server::Minion::operator=(const Core::ThreadPool::Metadata& info) {
         Id = (Core::instance_id)info.WorkerId;
 
         Runs = info.Runs;
+        Steals = info.Steals;
+        Depth = info.Depth;
         if (info.Job.IsSet() == false) {
             Job.Clear();
         }
@@ -293,13 +307,70 @@ namespace PluginHost
         return (*this);
     }
 
+    Metadata::Server::Pool::Pool()
+        : Core::JSON::Container()
+        , Name()
+        , Created(0)
+        , Outstanding(0)
+        , HighWater(0)
+        , Hits(0)
+        , Misses(0) {
+        Add(_T("name"), &Name);
+        Add(_T("created"), &Created);
+        Add(_T("outstanding"), &Outstanding);
+        Add(_T("highwater"), &HighWater);
+        Add(_T("hits"), &Hits);
+        Add(_T("misses"), &Misses);
+    }
+    Metadata::Server::Pool::Pool(Pool&& move)
+        : Core::JSON::Container()
+        , Name(std::move(move.Name))
+        , Created(std::move(move.Created))
+        , Outstanding(std::move(move.Outstanding))
+        , HighWater(std::move(move.HighWater))
+        , Hits(std::move(move.Hits))
+        , Misses(std::move(move.Misses)) {
+        Add(_T("name"), &Name);
+        Add(_T("created"), &Created);
+        Add(_T("outstanding"), &Outstanding);
+        Add(_T("highwater"), &HighWater);
+        Add(_T("hits"), &Hits);
+        Add(_T("misses"), &Misses);
+    }
+    Metadata::Server::Pool::Pool(const Pool& copy)
+        : Core::JSON::Container()
+        , Name(copy.Name)
+        , Created(copy.Created)
+        , Outstanding(copy.Outstanding)
+        , HighWater(copy.HighWater)
+        , Hits(copy.Hits)
+        , Misses(copy.Misses) {
+        Add(_T("name"), &Name);
+        Add(_T("created"), &Created);
+        Add(_T("outstanding"), &Outstanding);
+        Add(_T("highwater"), &HighWater);
+        Add(_T("hits"), &Hits);
+        Add(_T("misses"), &Misses);
+    }
+    Metadata::Server::Pool& Metadata::Server::Pool::operator=(const Core::ProxyPoolAdministrator::Metadata& info) {
+        Name = Core::ClassNameOnly(info.Name).Text();
+        Created = info.Created;
+        Outstanding = info.Outstanding;
+        HighWater = info.HighWater;
+        Hits = info.Hits;
+        Misses = info.Misses;
+        return (*this);
+    }
+
     Metadata::Server::Server()
         : Core::JSON::Container()
         , ThreadPoolRuns()
         , PendingRequests()
+        , Pools()
     {
         Core::JSON::Container::Add(_T("threads"), &ThreadPoolRuns);
         Core::JSON::Container::Add(_T("pending"), &PendingRequests);
+        Core::JSON::Container::Add(_T("pools"), &Pools);
     }
 
     Metadata::Metadata()
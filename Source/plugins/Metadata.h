@@ -147,6 +147,28 @@ namespace PluginHost {
                 Core::JSON::InstanceId Id;
                 Core::JSON::String Job;
                 Core::JSON::DecUInt32 Runs;
+                Core::JSON::DecUInt32 Steals;
+                Core::JSON::DecUInt32 Depth;
+            };
+            class EXTERNAL Pool : public Core::JSON::Container {
+            public:
+                Pool& operator=(Pool&&) = delete;
+                Pool& operator=(const Pool&) = delete;
+
+                Pool();
+                Pool(Pool&& move);
+                Pool(const Pool& copy);
+                ~Pool() override = default;
+
+                Pool& operator=(const Core::ProxyPoolAdministrator::Metadata&);
+
+            public:
+                Core::JSON::String Name;
+                Core::JSON::DecUInt32 Created;
+                Core::JSON::DecUInt32 Outstanding;
+                Core::JSON::DecUInt32 HighWater;
+                Core::JSON::DecUInt32 Hits;
+                Core::JSON::DecUInt32 Misses;
             };
 
         public:
@@ -162,11 +184,13 @@ namespace PluginHost {
             {
                 ThreadPoolRuns.Clear();
                 PendingRequests.Clear();
+                Pools.Clear();
             }
 
         public:
             Core::JSON::ArrayType<Minion> ThreadPoolRuns;
             Core::JSON::ArrayType<Core::JSON::String> PendingRequests;
+            Core::JSON::ArrayType<Pool> Pools;
         };
         class EXTERNAL SubSystem : public Core::JSON::Container {
         private:
@@ -86,7 +86,26 @@ namespace PluginHost {
     }
 #endif
 
-    void Service::FileToServe(const string& webServiceRequest, Web::Response& response, bool allowUnsafePath)
+    // Serves the file, or only the part of it asked for in the Range header of the request.
+    static void Serve(const Core::ProxyType<Web::FileBody>& fileBody, const string& range, Web::Response& response)
+    {
+        if (range.empty() == true) {
+            response.Body<Web::FileBody>(fileBody);
+        } else {
+            string contentRange;
+
+            response.ErrorCode = fileBody->Range(range, contentRange);
+
+            if (contentRange.empty() == false) {
+                response.ContentRange = contentRange;
+            }
+            if (response.ErrorCode != Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE) {
+                response.Body<Web::FileBody>(fileBody);
+            }
+        }
+    }
+
+    void Service::FileToServe(const string& webServiceRequest, Web::Response& response, bool allowUnsafePath, const string& range)
     {
         Web::MIMETypes result;
         Web::EncodingTypes encoding = Web::ENCODING_UNKNOWN;
@@ -98,7 +117,7 @@ namespace PluginHost {
             // No filename gives, be default, we go for the index.html page..
             *fileBody = fileToService + _T("index.html");
             response.ContentType = Web::MIME_HTML;
-            response.Body<Web::FileBody>(fileBody);
+            Serve(fileBody, range, response);
         } else {
             ASSERT(fileToService.length() >= _webServerFilePath.length());
             bool safePath = true;
@@ -111,7 +130,7 @@ namespace PluginHost {
                 if (encoding != Web::ENCODING_UNKNOWN) {
                     response.ContentEncoding = encoding;
                 }
-                response.Body<Web::FileBody>(fileBody);
+                Serve(fileBody, range, response);
             } else {
                 response.ErrorCode = Web::STATUS_BAD_REQUEST;
                 response.Message = "Invalid Request";
@@ -411,7 +411,7 @@ namespace PluginHost {
         }
         #endif
 
-        void FileToServe(const string& webServiceRequest, Web::Response& response, bool allowUnsafePath);
+        void FileToServe(const string& webServiceRequest, Web::Response& response, bool allowUnsafePath, const string& range = Core::emptyString);
 
     private:
         mutable Core::CriticalSection _adminLock;
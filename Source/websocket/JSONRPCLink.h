@@ -73,6 +73,10 @@ namespace WPEFramework {
                         {
                             return (!operator==(rhs));
                         }
+                        uint64_t Hash() const
+                        {
+                            return (reinterpret_cast<uintptr_t>(_client));
+                        }
 
                     public:
                         uint64_t Timed(const uint64_t scheduledTime) {
@@ -87,7 +91,7 @@ namespace WPEFramework {
 
                     FactoryImpl()
                         : _jsonRPCFactory(2)
-                        , _watchDog(Core::Thread::DefaultStackSize(), _T("JSONRPCCleaner"))
+                        , _watchDog(Core::Thread::DefaultStackSize(), _T("JSONRPCCleaner"), Core::TimerType<WatchDog>::HEAP)
                     {
                     }
 
@@ -130,9 +134,15 @@ namespace WPEFramework {
 
                     typedef Core::StreamJSONType<Web::WebSocketClientType<Core::SocketStream>, FactoryImpl&, INTERFACE> BaseClass;
 
+                    // A MessagePack link negotiates the MessagePack flavour of JSON-RPC with the server.
+                    static constexpr bool IsPacked()
+                    {
+                        return (std::is_same<INTERFACE, Core::JSON::IMessagePack>::value);
+                    }
+
                 public:
                     ChannelImpl(CommunicationChannel* parent, const Core::NodeId& remoteNode, const string& callsign, const string& query)
-                        : BaseClass(5, FactoryImpl::Instance(), callsign, _T("JSON"), query, "", false, false, false, remoteNode.AnyInterface(), remoteNode, 256, 256)
+                        : BaseClass(5, FactoryImpl::Instance(), callsign, (IsPacked() ? _T("jsonrpc.msgpack") : _T("JSON")), query, "", IsPacked(), false, false, remoteNode.AnyInterface(), remoteNode, 256, 256)
                         , _parent(*parent)
                     {
                     }
@@ -1114,11 +1124,14 @@ namespace WPEFramework {
             }
             void ToMessage(Core::JSON::IMessagePack* parameters, Core::ProxyType<Core::JSONRPC::Message>& message) const
             {
+                // The message holds its parameters as JSON text, it is packed again as a whole.
                 std::vector<uint8_t> values;
                 parameters->ToBuffer(values);
                 if (values.empty() != true) {
-                    string strValues(values.begin(), values.end());
-                    message->Parameters = strValues;
+                    string strValues;
+                    if (Core::JSON::IMessagePack::ToText(values.data(), static_cast<uint32_t>(values.size()), strValues) == true) {
+                        message->Parameters = strValues;
+                    }
                 }
                 return;
             }
@@ -1137,9 +1150,10 @@ namespace WPEFramework {
             }
             void FromMessage(Core::JSON::IMessagePack* response, const Core::JSONRPC::Message& message)
             {
-                string value = message.Result.Value();
-                std::vector<uint8_t> result(value.begin(), value.end());
-                response->FromBuffer(result);
+                std::vector<uint8_t> result;
+                if (Core::JSON::IMessagePack::FromText(message.Result.Value(), result) == true) {
+                    response->FromBuffer(result);
+                }
             }
 
         private:
@@ -198,6 +198,20 @@ namespace Web {
                 _activity = true;
                 return (_parent.SendData( dataFrame, maxSendSize));
             }
+            uint8_t SendSegments(Core::SocketPort::Segment segments[], const uint8_t maxSegments) override
+            {
+                _activity = true;
+                return (_parent.SendSegments(segments, maxSegments));
+            }
+            void ReleaseSegments() override
+            {
+                _parent.ReleaseSegments();
+            }
+            bool SendFile(Core::SocketPort::Region& region) override
+            {
+                _activity = true;
+                return (_parent.SendFile(region));
+            }
             uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
             {
                 _activity = true;
@@ -351,6 +365,62 @@ POP_WARNING()
             return (_serializerImpl.Serialize(dataFrame, receivedSize));
         }
 
+        // -------------------------------------------------------------
+        // Bodies from a file are sent from the file, unless they need to
+        // be transformed on their way out.
+        // -------------------------------------------------------------
+        IS_MEMBER_AVAILABLE(Serialize, hasRegion);
+
+        template <typename CLASSNAME = TRANSFORM>
+        inline typename Core::TypeTraits::enable_if<(hasRegion<BaseSerializer, bool, Core::SocketPort::Region&>::value) && (!hasTransform<CLASSNAME, uint16_t, BaseSerializer&, uint8_t*, const uint16_t>::value), bool>::type
+        SendFile(Core::SocketPort::Region& region)
+        {
+            return (_serializerImpl.Serialize(region));
+        }
+
+        template <typename CLASSNAME = TRANSFORM>
+        inline typename Core::TypeTraits::enable_if<(!hasRegion<BaseSerializer, bool, Core::SocketPort::Region&>::value) || (hasTransform<CLASSNAME, uint16_t, BaseSerializer&, uint8_t*, const uint16_t>::value), bool>::type
+        SendFile(Core::SocketPort::Region&)
+        {
+            return (false);
+        }
+
+        // -------------------------------------------------------------
+        // Header and body kept in memory go out as they are, unless they
+        // need to be transformed on their way out.
+        // -------------------------------------------------------------
+        IS_MEMBER_AVAILABLE(Serialize, hasSegments);
+
+        template <typename CLASSNAME = TRANSFORM>
+        inline typename Core::TypeTraits::enable_if<(hasSegments<BaseSerializer, uint8_t, Core::SocketPort::Segment*, const uint8_t>::value) && (!hasTransform<CLASSNAME, uint16_t, BaseSerializer&, uint8_t*, const uint16_t>::value), uint8_t>::type
+        SendSegments(Core::SocketPort::Segment segments[], const uint8_t maxSegments)
+        {
+            return (_serializerImpl.Serialize(segments, maxSegments));
+        }
+
+        template <typename CLASSNAME = TRANSFORM>
+        inline typename Core::TypeTraits::enable_if<(!hasSegments<BaseSerializer, uint8_t, Core::SocketPort::Segment*, const uint8_t>::value) || (hasTransform<CLASSNAME, uint16_t, BaseSerializer&, uint8_t*, const uint16_t>::value), uint8_t>::type
+        SendSegments(Core::SocketPort::Segment[], const uint8_t)
+        {
+            return (0);
+        }
+
+        template <typename CLASSNAME = TRANSFORM>
+        inline typename Core::TypeTraits::enable_if<(hasSegments<BaseSerializer, uint8_t, Core::SocketPort::Segment*, const uint8_t>::value) && (!hasTransform<CLASSNAME, uint16_t, BaseSerializer&, uint8_t*, const uint16_t>::value), void>::type
+        ReleaseSegments()
+        {
+            _serializerImpl.Released();
+
+            // With zero copy this comes after SendData found nothing to do, the message can be completed now.
+            Trigger();
+        }
+
+        template <typename CLASSNAME = TRANSFORM>
+        inline typename Core::TypeTraits::enable_if<(!hasSegments<BaseSerializer, uint8_t, Core::SocketPort::Segment*, const uint8_t>::value) || (hasTransform<CLASSNAME, uint16_t, BaseSerializer&, uint8_t*, const uint16_t>::value), void>::type
+        ReleaseSegments()
+        {
+        }
+
     private:
         SerializerImpl _serializerImpl;
         DeserializerImpl _deserialiserImpl;
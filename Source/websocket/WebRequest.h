@@ -97,6 +97,19 @@ namespace Web {
         // The Serialize and Deserialize methods allow the content to be serialized/deserialized.
         virtual uint16_t Serialize(uint8_t[] /* stream*/, const uint16_t /* maxLength */) const = 0;
         virtual uint16_t Deserialize(const uint8_t[] /* stream*/, const uint16_t /* maxLength */) = 0;
+
+        // A body that is read from a file can tell where in that file the part still to be serialized
+        // starts, so the link can have the kernel send it straight from the file.
+        virtual bool Region(Core::SocketPort::Region& /* region */) const
+        {
+            return (false);
+        }
+        // A body that is kept in memory as a whole can hand out the part still to be serialized, so the
+        // link can send it as it is, right after the header.
+        virtual bool Segment(Core::SocketPort::Segment& /* segment */) const
+        {
+            return (false);
+        }
     };
 
     class EXTERNAL Signature {
@@ -283,7 +296,8 @@ namespace Web {
             MAN,
             M_X,
             S_T,
-			AUTHORIZATION
+			AUTHORIZATION,
+            RANGE
         };
 
         enum type {
@@ -325,7 +339,8 @@ namespace Web {
                 PAIR_KEY = 6,
                 PAIR_VALUE = 7,
                 BODY = 8,
-                REPORT = 9
+                REPORT = 9,
+                SEGMENTED = 10
             };
             const static uint16_t EOL_MARKER = 0x8000;
 
@@ -342,6 +357,8 @@ namespace Web {
                 , _buffer(nullptr)
                 , _lock()
                 , _current()
+                , _header()
+                , _segmenting(false)
             {
             }
             virtual ~Serializer() = default;
@@ -373,6 +390,14 @@ namespace Web {
             }
 
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength);
+            // Once the body is due and it lives in a file, the rest of it is handed out as a region of
+            // that file, instead of being serialized.
+            bool Serialize(Core::SocketPort::Region& region);
+            // A message that is not started yet is handed out as its header and, if the body is kept in
+            // memory, that body, so neither is copied into the send buffer. Released reports they are
+            // written, only then the message is completed.
+            uint8_t Serialize(Core::SocketPort::Segment segments[], const uint8_t maxSegments);
+            void Released();
 
         private:
             uint16_t _state;
@@ -383,6 +408,8 @@ namespace Web {
             const TCHAR* _buffer;
             Core::CriticalSection _lock;
             Request* _current;
+            string _header;
+            bool _segmenting;
         };
         class EXTERNAL Deserializer {
         private:
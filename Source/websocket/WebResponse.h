@@ -95,12 +95,14 @@ namespace Web {
             ALLOW,
             WEBSOCKET_ACCEPT,
             WEBSOCKET_PROTOCOL,
+            WEBSOCKET_EXTENSIONS,
             LOCATION,
             WAKEUP,
             U_S_N,
             S_T,
             CACHE_CONTROL,
-            APPLICATION_URL
+            APPLICATION_URL,
+            CONTENT_RANGE
         };
 
         enum upgrade {
@@ -125,7 +127,8 @@ namespace Web {
                 PAIR_KEY = 4,
                 PAIR_VALUE = 5,
                 BODY = 6,
-                REPORT = 7
+                REPORT = 7,
+                SEGMENTED = 8
             };
 
             const static uint16_t EOL_MARKER = 0x8000;
@@ -143,6 +146,8 @@ namespace Web {
                 , _buffer(nullptr)
                 , _lock()
                 , _current()
+                , _header()
+                , _segmenting(false)
             {
             }
             virtual ~Serializer() = default;
@@ -174,6 +179,14 @@ namespace Web {
             }
 
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength);
+            // Once the body is due and it lives in a file, the rest of it is handed out as a region of
+            // that file, instead of being serialized.
+            bool Serialize(Core::SocketPort::Region& region);
+            // A message that is not started yet is handed out as its header and, if the body is kept in
+            // memory, that body, so neither is copied into the send buffer. Released reports they are
+            // written, only then the message is completed.
+            uint8_t Serialize(Core::SocketPort::Segment segments[], const uint8_t maxSegments);
+            void Released();
 
         private:
             uint16_t _state;
@@ -184,6 +197,8 @@ namespace Web {
             const TCHAR* _buffer;
             Core::CriticalSection _lock;
             Response* _current;
+            string _header;
+            bool _segmenting;
         };
         class EXTERNAL Deserializer {
         private:
@@ -387,11 +402,13 @@ POP_WARNING()
             Server.Clear();
             Modified.Clear();
             AcceptRange.Clear();
+            ContentRange.Clear();
             ETag.Clear();
             ContentType.Clear();
             ContentLength.Clear();
             ContentEncoding.Clear();
             WebSocketAccept.Clear();
+            WebSocketExtensions.Clear();
             AccessControlOrigin.Clear();
             AccessControlMethod.Clear();
             AccessControlHeaders.Clear();
@@ -433,6 +450,7 @@ POP_WARNING()
         Core::OptionalType<string> AccessControlHeaders;
         Core::OptionalType<uint32_t> AccessControlMaxAge;
         Core::OptionalType<string> AcceptRange;
+        Core::OptionalType<string> ContentRange;
         Core::OptionalType<connection> Connection;
         Core::OptionalType<string> ST;
         Core::OptionalType<string> USN;
@@ -440,6 +458,7 @@ POP_WARNING()
         Core::OptionalType<string> WakeUp;
         Core::OptionalType<string> ETag;
         Core::OptionalType<string> WebSocketProtocol;
+        Core::OptionalType<string> WebSocketExtensions;
         Core::OptionalType<string> CacheControl;
         Core::OptionalType<Core::URL> ApplicationURL;
 
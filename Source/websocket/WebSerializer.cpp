@@ -69,6 +69,7 @@ static const TCHAR __SERVER[] = _T("SERVER:");
 static const TCHAR __MODIFIED[] = _T("LAST-MODIFIED:");
 static const TCHAR __ACCEPT_RANGE[] = _T("ACCEPT-RANGES:");
 static const TCHAR __RANGE[] = _T("RANGE:");
+static const TCHAR __CONTENT_RANGE[] = _T("CONTENT-RANGE:");
 static const TCHAR __ETAG[] = _T("ETAG:");
 static const TCHAR __ALLOW[] = _T("ALLOW:");
 static const TCHAR __WEBSOCKET_KEY[] = _T("SEC-WEBSOCKET-KEY:");
@@ -228,10 +229,12 @@ ENUM_CONVERSION_BEGIN(Web::Request::keywords)
     { Web::Request::WEBSOCKET_KEY, __TXT(__WEBSOCKET_KEY) },
     { Web::Request::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
     { Web::Request::WEBSOCKET_VERSION, __TXT(__WEBSOCKET_VERSION) },
+    { Web::Request::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Request::MAN, __TXT(__MAN) },
     { Web::Request::M_X, __TXT(__MX) },
     { Web::Request::S_T, __TXT(__ST) },
     { Web::Request::AUTHORIZATION, __TXT(__AUTHORIZATION) },
+    { Web::Request::RANGE, __TXT(__RANGE) },
 
 ENUM_CONVERSION_END(Web::Request::keywords)
 
@@ -272,12 +275,14 @@ ENUM_CONVERSION_BEGIN(Web::Response::keywords)
     { Web::Response::ACCESS_CONTROL_MAX_AGE, __TXT(__ACCESS_CONTROL_MAX_AGE) },
     { Web::Response::WEBSOCKET_ACCEPT, __TXT(__WEBSOCKET_ACCEPT) },
     { Web::Response::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
+    { Web::Response::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Response::LOCATION, __TXT(__LOCATION) },
     { Web::Response::WAKEUP, __TXT(__WAKEUP) },
     { Web::Response::U_S_N, __TXT(__USN) },
     { Web::Response::S_T, __TXT(__ST) },
     { Web::Response::CACHE_CONTROL, __TXT(__CACHE_CONTROL) },
     { Web::Response::APPLICATION_URL, __TXT(__APPLICATION_URL) },
+    { Web::Response::CONTENT_RANGE, __TXT(__CONTENT_RANGE) },
 
 ENUM_CONVERSION_END(Web::Response::keywords)
 
@@ -413,6 +418,76 @@ namespace Web
         return (filePresent);
     }
 
+    // Reads a position of a Range header, only digits, never more than fit in the file size.
+    static bool ToPosition(const string& text, uint64_t& position)
+    {
+        bool result = ((text.empty() == false) && (text.length() <= 18));
+
+        position = 0;
+
+        for (string::const_iterator index(text.begin()); (result == true) && (index != text.end()); index++) {
+            result = ((*index >= '0') && (*index <= '9'));
+            position = (position * 10) + (*index - '0');
+        }
+
+        return (result);
+    }
+
+    WebStatus FileBody::Range(const string& range, string& contentRange)
+    {
+        static const TCHAR Unit[] = _T("bytes=");
+        static const size_t UnitLength = (sizeof(Unit) / sizeof(TCHAR)) - 1;
+
+        const uint64_t size = Core::File::Size();
+        WebStatus result = STATUS_OK;
+        uint64_t first = 0;
+        uint64_t last = 0;
+
+        _startPosition = 0;
+        _length = ~0;
+        contentRange.clear();
+
+        const size_t separator = range.find('-', UnitLength);
+
+        // Multiple ranges would ask for a multipart response, those get the whole file. So do files
+        // that are too big for a body to begin with.
+        if ((range.compare(0, UnitLength, Unit) == 0) && (separator != string::npos) && (range.find(',', UnitLength) == string::npos) && (size <= static_cast<uint64_t>(Core::NumberType<int32_t>::Max()))) {
+            const string start(range.substr(UnitLength, separator - UnitLength));
+            const string end(range.substr(separator + 1));
+
+            if (start.empty() == true) {
+                // The last so many bytes.
+                if (ToPosition(end, last) == true) {
+                    if ((last > 0) && (size > 0)) {
+                        first = (last < size ? size - last : 0);
+                        last = size - 1;
+                        result = STATUS_PARTIAL_CONTENT;
+                    } else {
+                        result = STATUS_REQUEST_RANGE_NOT_SATISFIABLE;
+                    }
+                }
+            } else if (ToPosition(start, first) == true) {
+                if (end.empty() == true) {
+                    last = size - 1;
+                    result = (first < size ? STATUS_PARTIAL_CONTENT : STATUS_REQUEST_RANGE_NOT_SATISFIABLE);
+                } else if ((ToPosition(end, last) == true) && (last >= first)) {
+                    last = std::min(last, size - 1);
+                    result = (first < size ? STATUS_PARTIAL_CONTENT : STATUS_REQUEST_RANGE_NOT_SATISFIABLE);
+                }
+            }
+        }
+
+        if (result == STATUS_REQUEST_RANGE_NOT_SATISFIABLE) {
+            contentRange = _T("bytes */") + Core::NumberType<uint64_t>(size).Text();
+        } else if (result == STATUS_PARTIAL_CONTENT) {
+            _startPosition = static_cast<int32_t>(first);
+            _length = static_cast<uint32_t>(last - first + 1);
+            contentRange = _T("bytes ") + Core::NumberType<uint64_t>(first).Text() + '-' + Core::NumberType<uint64_t>(last).Text() + '/' + Core::NumberType<uint64_t>(size).Text();
+        }
+
+        return (result);
+    }
+
     static Signature ToSignature(const string& input)
     {
         Core::TextFragment inputLine(input);
@@ -511,6 +586,77 @@ namespace Web
         }
     }
 
+    uint8_t Request::Serializer::Serialize(Core::SocketPort::Segment segments[], const uint8_t maxSegments)
+    {
+        uint8_t result = 0;
+
+        _lock.Lock();
+
+        // Only for a message with a body, that is not started yet.
+        if ((_current != nullptr) && (_state == VERB) && (_buffer == nullptr) && (maxSegments >= 2) && (_current->_body.IsValid() == true)) {
+            uint8_t buffer[256];
+
+            _header.clear();
+            _segmenting = true;
+
+            // The header is serialized as always, it just stops where the body starts.
+            while ((_state != BODY) && (_state != REPORT)) {
+                const uint16_t loaded = Serialize(buffer, sizeof(buffer));
+                _header.append(reinterpret_cast<const char*>(buffer), loaded);
+            }
+
+            _segmenting = false;
+
+            segments[0] = { reinterpret_cast<const uint8_t*>(_header.c_str()), static_cast<uint32_t>(_header.length()) };
+            result = 1;
+
+            // A body that is not kept in memory is left to the other paths.
+            if ((_state == BODY) && (_current->_body->Segment(segments[1]) == true)) {
+                ASSERT(segments[1].Length >= _bodyLength);
+
+                segments[1].Length = _bodyLength;
+                _bodyLength = 0;
+                _state = SEGMENTED;
+                result = 2;
+            }
+        }
+
+        _lock.Unlock();
+
+        return (result);
+    }
+
+    void Request::Serializer::Released()
+    {
+        _lock.Lock();
+
+        // The body went out along with the header, the message is complete.
+        if (_state == SEGMENTED) {
+            _state = REPORT;
+        }
+
+        _lock.Unlock();
+    }
+
+    bool Request::Serializer::Serialize(Core::SocketPort::Region& region)
+    {
+        bool result = false;
+
+        _lock.Lock();
+
+        // Only what is left of the body, the first part might have been serialized along with the header.
+        if ((_current != nullptr) && (_state == BODY) && (_bodyLength != 0) && (_current->_body->Region(region) == true)) {
+            region.Length = _bodyLength;
+            _bodyLength = 0;
+            _state = REPORT;
+            result = true;
+        }
+
+        _lock.Unlock();
+
+        return (result);
+    }
+
     uint16_t Request::Serializer::Serialize(uint8_t stream[], const uint16_t maxLength)
     {
         uint16_t current = 0;
@@ -528,8 +674,8 @@ namespace Web
             Serialized(*backup);
         }
 
-        if (_current != nullptr) {
-            while ((current < maxLength) && (_state != REPORT)) {
+        if ((_current != nullptr) && (_state != SEGMENTED)) {
+            while ((current < maxLength) && (_state != REPORT) && ((_state != BODY) || (_segmenting == false))) {
                 while ((current < maxLength) && ((_state & EOL_MARKER) == EOL_MARKER)) {
                     if (_offset == 0) {
                         stream[current++] = '\r';
@@ -874,7 +1020,7 @@ namespace Web
                     break;
                 }
                 case BODY: {
-                    if (_bodyLength != 0) {
+                    if ((_bodyLength != 0) && (_segmenting == false)) {
                         ASSERT(maxLength >= current);
                         uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
 
@@ -910,6 +1056,77 @@ namespace Web
         return (current);
     }
 
+    uint8_t Response::Serializer::Serialize(Core::SocketPort::Segment segments[], const uint8_t maxSegments)
+    {
+        uint8_t result = 0;
+
+        _lock.Lock();
+
+        // Only for a message with a body, that is not started yet.
+        if ((_current != nullptr) && (_state == VERSION) && (_buffer == nullptr) && (maxSegments >= 2) && (_current->_body.IsValid() == true)) {
+            uint8_t buffer[256];
+
+            _header.clear();
+            _segmenting = true;
+
+            // The header is serialized as always, it just stops where the body starts.
+            while ((_state != BODY) && (_state != REPORT)) {
+                const uint16_t loaded = Serialize(buffer, sizeof(buffer));
+                _header.append(reinterpret_cast<const char*>(buffer), loaded);
+            }
+
+            _segmenting = false;
+
+            segments[0] = { reinterpret_cast<const uint8_t*>(_header.c_str()), static_cast<uint32_t>(_header.length()) };
+            result = 1;
+
+            // A body that is not kept in memory is left to the other paths.
+            if ((_state == BODY) && (_current->_body->Segment(segments[1]) == true)) {
+                ASSERT(segments[1].Length >= _bodyLength);
+
+                segments[1].Length = _bodyLength;
+                _bodyLength = 0;
+                _state = SEGMENTED;
+                result = 2;
+            }
+        }
+
+        _lock.Unlock();
+
+        return (result);
+    }
+
+    void Response::Serializer::Released()
+    {
+        _lock.Lock();
+
+        // The body went out along with the header, the message is complete.
+        if (_state == SEGMENTED) {
+            _state = REPORT;
+        }
+
+        _lock.Unlock();
+    }
+
+    bool Response::Serializer::Serialize(Core::SocketPort::Region& region)
+    {
+        bool result = false;
+
+        _lock.Lock();
+
+        // Only what is left of the body, the first part might have been serialized along with the header.
+        if ((_current != nullptr) && (_state == BODY) && (_bodyLength != 0) && (_current->_body->Region(region) == true)) {
+            region.Length = _bodyLength;
+            _bodyLength = 0;
+            _state = REPORT;
+            result = true;
+        }
+
+        _lock.Unlock();
+
+        return (result);
+    }
+
     uint16_t Response::Serializer::Serialize(uint8_t stream[], const uint16_t maxLength)
     {
         uint16_t current = 0;
@@ -927,8 +1144,8 @@ namespace Web
             Serialized(*backup);
         }
 
-        if (_current != nullptr) {
-            while ((current < maxLength) && (_state != REPORT)) {
+        if ((_current != nullptr) && (_state != SEGMENTED)) {
+            while ((current < maxLength) && (_state != REPORT) && ((_state != BODY) || (_segmenting == false))) {
                 while ((current < maxLength) && ((_state & EOL_MARKER) == EOL_MARKER)) {
                     if (_offset == 0) {
                         stream[current++] = '\r';
@@ -1210,6 +1427,16 @@ namespace Web
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_SIGNATURE : _T("Content-HMAC:"));
                             FromSignature(_current->ContentSignature.Value(), _value);
                             _offset = 0;
+                        } else if ((_keyIndex <= 25) && (_current->WebSocketExtensions.IsSet() == true)) {
+                            _keyIndex = 26;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __WEBSOCKET_EXTENSIONS : _T("Sec-WebSocket-Extensions:"));
+                            _value = _current->WebSocketExtensions.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 26) && (_current->ContentRange.IsSet() == true)) {
+                            _keyIndex = 27;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_RANGE : _T("Content-Range:"));
+                            _value = _current->ContentRange.Value();
+                            _offset = 0;
                         }
                     }
 
@@ -1253,7 +1480,7 @@ namespace Web
                     break;
                 }
                 case BODY: {
-                    if (_bodyLength != 0) {
+                    if ((_bodyLength != 0) && (_segmenting == false)) {
                         ASSERT(maxLength >= current);
                         uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
 
@@ -1482,6 +1709,9 @@ namespace Web
             case Request::WEBSOCKET_EXTENSIONS:
                 _current->WebSocketExtensions = buffer;
                 break;
+            case Request::RANGE:
+                _current->Range = buffer;
+                break;
             case Request::ACCESS_CONTROL_REQUEST_HEADERS:
                 _current->AccessControlHeaders = buffer;
                 break;
@@ -1849,6 +2079,9 @@ namespace Web
             case Response::WEBSOCKET_PROTOCOL:
                 _current->WebSocketProtocol = buffer;
                 break;
+            case Response::WEBSOCKET_EXTENSIONS:
+                _current->WebSocketExtensions = buffer;
+                break;
             case Response::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1867,6 +2100,9 @@ namespace Web
             case Response::APPLICATION_URL:
                 _current->ApplicationURL = Core::URL(buffer);
                 break;
+            case Response::CONTENT_RANGE:
+                _current->ContentRange = buffer;
+                break;
             case Response::CACHE_CONTROL:
                 _current->CacheControl = buffer;
                 break;
@@ -71,6 +71,13 @@ namespace Web {
 
             return size;
         }
+        bool Segment(Core::SocketPort::Segment& segment) const override
+        {
+            segment.Data = &(reinterpret_cast<const uint8_t*>(string::c_str())[_lastPosition]);
+            segment.Length = static_cast<uint32_t>(string::length() * sizeof(TCHAR)) - _lastPosition;
+
+            return (true);
+        }
         uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength) override
         {
             uint16_t index = 0;
@@ -150,12 +157,14 @@ namespace Web {
             : Core::File()
             , _opened(false)
             , _startPosition(0)
+            , _length(~0)
         {
         }
         FileBody(const string& path)
             : Core::File(path)
             , _opened(false)
             , _startPosition(0)
+            , _length(~0)
         {
         }
         ~FileBody() override = default;
@@ -165,6 +174,7 @@ namespace Web {
         {
             Core::File::operator=(location);
             _startPosition = 0;
+            _length = ~0;
 
             return (*this);
         }
@@ -172,21 +182,39 @@ namespace Web {
         {
             Core::File::operator=(RHS);
             _startPosition = static_cast<int32_t>(Core::File::Position());
+            _length = ~0;
 
             return (*this);
         }
 
+        // Only serve a part of the file, as asked for by the "Range" header of a request. Single ranges in
+        // bytes are supported ("bytes=100-199", "bytes=100-" and "bytes=-100"), for anything else the
+        // whole file is served. Returns the status the response should carry and, for a partial
+        // response, the value of its "Content-Range" header.
+        WebStatus Range(const string& range, string& contentRange);
+
     protected:
         uint32_t Serialize() const override
         {
+            uint32_t result = 0;
+
             // Are we opening the file ?
             _opened = (Core::File::IsOpen() == false);
 
-            if (_opened == false) {
-                const_cast<FileBody*>(this)->LoadFileInfo();
+            if ((_opened == false) || (Core::File::Open() == true)) {
+                if (_opened == false) {
+                    const_cast<FileBody*>(this)->LoadFileInfo();
+                }
                 const_cast<FileBody*>(this)->Position(false, _startPosition);
+
+                result = static_cast<uint32_t>(Core::File::Size() - _startPosition);
+
+                if (result > _length) {
+                    result = _length;
+                }
             }
-            return (((_opened == false) || (Core::File::Open() == true)) ? static_cast<uint32_t>(Core::File::Size() - _startPosition) : 0);
+
+            return (result);
         }
         uint32_t Deserialize() override
         {
@@ -220,10 +248,26 @@ namespace Web {
                 }
             }
         }
+        bool Region(Core::SocketPort::Region& region VARIABLE_IS_NOT_USED) const override
+        {
+            bool result = false;
+
+#ifdef __POSIX__
+            if (Core::File::IsOpen() == true) {
+                // Whatever has been read already, the rest is taken from the current position.
+                region.Descriptor = static_cast<Core::File::Handle>(const_cast<FileBody&>(*this));
+                region.Offset = static_cast<uint64_t>(Core::File::Position());
+                result = true;
+            }
+#endif
+
+            return (result);
+        }
 
     private:
         mutable bool _opened;
         mutable int32_t _startPosition;
+        uint32_t _length;
     };
 
     template <typename HASHALGORITHM>
@@ -363,6 +407,14 @@ namespace Web {
             }
             return size;
         }
+        bool Segment(Core::SocketPort::Segment& segment) const override
+        {
+            // The body has been put in a string already, to know its length upfront.
+            segment.Data = &(reinterpret_cast<const uint8_t*>(_body.c_str())[_lastPosition]);
+            segment.Length = static_cast<uint32_t>(_body.length() * sizeof(TCHAR)) - _lastPosition;
+
+            return (true);
+        }
         uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength) override
         {
             return static_cast<Core::JSON::IElement&>(*this).Deserialize(reinterpret_cast<const char*>(stream), maxLength, _offset, _error);
@@ -433,14 +485,25 @@ namespace Web {
 
     namespace JSONRPC {
 
+        // A JSON-RPC request, or a batch of them. A batch (an array of requests) is detected while
+        // it is received and is kept in Batch(). Once it is dispatched, the responses replace the
+        // requests in Batch() and the whole array is send back as one message.
         class Body : public JSONBodyType<Core::JSONRPC::Message> {
         public:
+            using Calls = Core::JSON::ArrayType<Core::JSONRPC::Message>;
+
             Body(Body&&) = delete;
             Body(const Body&) = delete;
             Body& operator=(Body&&) = delete;
             Body& operator=(const Body&) = delete;
 
-            Body() = default;
+            Body()
+                : JSONBodyType<Core::JSONRPC::Message>()
+                , _id()
+                , _batch()
+                , _batched(false)
+            {
+            }
             ~Body() override = default;
 
         public:
@@ -449,6 +512,8 @@ namespace Web {
                 if (Core::JSONRPC::Message::Id.IsSet() == true) {
                     _id = Core::JSONRPC::Message::Id.Value();
                 }
+                _batch.Clear();
+                _batched = false;
                 JSONBodyType<Core::JSONRPC::Message>::Clear();
             }
             uint32_t Deserialize() override
@@ -459,9 +524,46 @@ namespace Web {
             const Core::OptionalType<uint32_t>& Recorded() const {
                 return (_id);
             }
+            bool IsBatch() const {
+                return (_batched);
+            }
+            Calls& Batch() {
+                return (_batch);
+            }
+            const Calls& Batch() const {
+                return (_batch);
+            }
+            // Turns a batch back into a single message, e.g. to report an error on it.
+            void Single() {
+                _batch.Clear();
+                _batched = false;
+            }
+
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
+            {
+                return (_batched == true ? static_cast<const Core::JSON::IElement&>(_batch).Serialize(stream, maxLength, offset)
+                                         : Core::JSONRPC::Message::Serialize(stream, maxLength, offset));
+            }
+            uint16_t Deserialize(const char stream[], const uint16_t maxLength, uint32_t& offset, Core::OptionalType<Core::JSON::Error>& error) override
+            {
+                if ((offset == 0) && (_batched == false)) {
+                    uint16_t index = 0;
+
+                    while ((index < maxLength) && (::isspace(stream[index]) != 0)) {
+                        index++;
+                    }
+
+                    _batched = ((index < maxLength) && (stream[index] == '['));
+                }
+
+                return (_batched == true ? static_cast<Core::JSON::IElement&>(_batch).Deserialize(stream, maxLength, offset, error)
+                                         : Core::JSONRPC::Message::Deserialize(stream, maxLength, offset, error));
+            }
 
         private:
             Core::OptionalType<uint32_t> _id;
+            Calls _batch;
+            bool _batched;
         };
 
     }
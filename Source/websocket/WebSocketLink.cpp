@@ -19,6 +19,14 @@
 
 #include "WebSocketLink.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace WPEFramework {
 namespace Web {
     namespace WebSocket {
@@ -37,6 +45,7 @@ namespace Web {
 
         static const uint8_t CONTINUATION_FRAME = 0x00;
         static const uint8_t FINISHING_FRAME = 0x80;
+        static const uint8_t COMPRESSED_FRAME = 0x40;
         static const uint8_t TYPE_FRAME = 0x0F;
         static const uint8_t MASKING_FRAME = 0x80;
         static const uint8_t CONTROL_FRAME = 0x08;
@@ -68,6 +77,426 @@ namespace Web {
             return (baseEncodedKey);
         }
 
+        static const TCHAR PermessageDeflate[] = _T("permessage-deflate");
+        static const uint8_t DeflateTail[] = { 0x00, 0x00, 0xFF, 0xFF };
+
+        enum deflateParameters : uint8_t {
+            SERVER_NO_CONTEXT_TAKEOVER = 0x01,
+            CLIENT_NO_CONTEXT_TAKEOVER = 0x02,
+            SERVER_MAX_WINDOW_BITS = 0x04,
+            CLIENT_MAX_WINDOW_BITS = 0x08
+        };
+
+        class DeflateOffer {
+        public:
+            DeflateOffer() = delete;
+            DeflateOffer(const DeflateOffer&) = delete;
+            DeflateOffer& operator=(const DeflateOffer&) = delete;
+
+            // Parses one comma separated entry of a Sec-WebSocket-Extensions header.
+            DeflateOffer(const string& text)
+                : Parameters(0)
+                , ServerMaxWindowBits(15)
+                , ClientMaxWindowBits(15)
+                , _valid(false)
+            {
+                size_t begin = text.find(';');
+
+                if (Trim(text.substr(0, begin)) == PermessageDeflate) {
+                    _valid = true;
+
+                    while ((_valid == true) && (begin != string::npos)) {
+                        const size_t end = text.find(';', begin + 1);
+                        const string parameter(text.substr(begin + 1, (end == string::npos ? string::npos : end - begin - 1)));
+                        const size_t marker = parameter.find('=');
+                        const string key(Trim(parameter.substr(0, marker)));
+                        const string value(marker == string::npos ? string() : Trim(parameter.substr(marker + 1)));
+
+                        if (key == _T("server_no_context_takeover")) {
+                            _valid = Set(SERVER_NO_CONTEXT_TAKEOVER, (marker == string::npos));
+                        } else if (key == _T("client_no_context_takeover")) {
+                            _valid = Set(CLIENT_NO_CONTEXT_TAKEOVER, (marker == string::npos));
+                        } else if (key == _T("server_max_window_bits")) {
+                            _valid = Set(SERVER_MAX_WINDOW_BITS, WindowBits(value, ServerMaxWindowBits));
+                        } else if (key == _T("client_max_window_bits")) {
+                            // The client may announce support without a value.
+                            _valid = Set(CLIENT_MAX_WINDOW_BITS, (marker == string::npos) || (WindowBits(value, ClientMaxWindowBits) == true));
+                        } else {
+                            _valid = false;
+                        }
+
+                        begin = end;
+                    }
+                }
+            }
+            ~DeflateOffer() = default;
+
+        public:
+            bool IsValid() const
+            {
+                return (_valid);
+            }
+            bool Has(const deflateParameters parameter) const
+            {
+                return ((Parameters & parameter) != 0);
+            }
+
+        private:
+            bool Set(const deflateParameters parameter, const bool valid)
+            {
+                // Each parameter may only be given once.
+                bool result = ((valid == true) && (Has(parameter) == false));
+
+                Parameters |= parameter;
+
+                return (result);
+            }
+            static string Trim(const string& text)
+            {
+                const size_t begin = text.find_first_not_of(_T(" \t\""));
+
+                return (begin == string::npos ? string() : text.substr(begin, text.find_last_not_of(_T(" \t\"")) - begin + 1));
+            }
+            static bool WindowBits(const string& value, uint8_t& bits)
+            {
+                bool result = false;
+
+                if ((value.length() > 0) && (value.length() <= 2) && (::isdigit(value[0]) != 0) && (::isdigit(value[value.length() - 1]) != 0)) {
+                    const uint32_t number = ::atoi(value.c_str());
+
+                    if ((number >= 8) && (number <= 15)) {
+                        bits = static_cast<uint8_t>(number);
+                        result = true;
+                    }
+                }
+
+                return (result);
+            }
+
+        public:
+            uint8_t Parameters;
+            uint8_t ServerMaxWindowBits;
+            uint8_t ClientMaxWindowBits;
+
+        private:
+            bool _valid;
+        };
+
+        static uint8_t WindowBits(const uint8_t bits)
+        {
+            return (bits < 8 ? 8 : (bits > 15 ? 15 : bits));
+        }
+
+        // Inflates into the output, but never more than room bytes.
+        static uint32_t Inflate(z_stream& stream, const uint8_t data[], const uint16_t length, std::vector<uint8_t>& output, const uint32_t room)
+        {
+            const size_t start = output.size();
+            uint32_t result = Core::ERROR_NONE;
+            bool done = false;
+            int status = Z_OK;
+
+            stream.next_in = const_cast<uint8_t*>(data);
+            stream.avail_in = length;
+
+            while ((done == false) && (status == Z_OK)) {
+                const size_t offset = output.size();
+
+                // One byte more than what is left, to find out if the message does not fit.
+                const uint32_t chunk = static_cast<uint32_t>(std::min(static_cast<size_t>(std::max(static_cast<uint32_t>(length) * 4, static_cast<uint32_t>(1024))), (static_cast<size_t>(room) - (offset - start)) + 1));
+
+                output.resize(offset + chunk);
+                stream.next_out = &(output[offset]);
+                stream.avail_out = chunk;
+
+                status = ::inflate(&stream, Z_SYNC_FLUSH);
+
+                output.resize(offset + chunk - stream.avail_out);
+
+                if ((output.size() - start) > room) {
+                    // Stop right here, before it grows any further.
+                    output.resize(start + room);
+                    result = Core::ERROR_INVALID_INPUT_LENGTH;
+                    done = true;
+                } else if (status == Z_STREAM_END) {
+                    // The sender closed the stream with a final block, what follows starts a new one.
+                    status = ::inflateReset(&stream);
+                } else if (status == Z_BUF_ERROR) {
+                    // Nothing left to do..
+                    status = Z_OK;
+                    done = true;
+                }
+
+                done = done || ((stream.avail_in == 0) && (stream.avail_out != 0));
+            }
+
+            return ((result == Core::ERROR_NONE) && (status != Z_OK) ? Core::ERROR_GENERAL : result);
+        }
+
+        string Deflate::Offer() const
+        {
+            string result;
+
+            if (_configured == true) {
+                result = PermessageDeflate;
+
+                if (_settings.ServerNoContextTakeover == true) {
+                    result += _T("; server_no_context_takeover");
+                }
+                if (_settings.ClientNoContextTakeover == true) {
+                    result += _T("; client_no_context_takeover");
+                }
+                if (WindowBits(_settings.ServerMaxWindowBits) < 15) {
+                    result += _T("; server_max_window_bits=") + Core::NumberType<uint8_t>(WindowBits(_settings.ServerMaxWindowBits)).Text();
+                }
+
+                result += _T("; client_max_window_bits");
+
+                if (WindowBits(_settings.ClientMaxWindowBits) < 15) {
+                    result += '=' + Core::NumberType<uint8_t>(WindowBits(_settings.ClientMaxWindowBits)).Text();
+                }
+            }
+
+            return (result);
+        }
+
+        bool Deflate::Accept(const string& response)
+        {
+            bool result = true;
+
+            Reset();
+
+            if (response.empty() == false) {
+                DeflateOffer accepted(response);
+
+                // Only what was offered can be accepted, and only once.
+                result = ((_configured == true) && (accepted.IsValid() == true) && (response.find(',') == string::npos));
+
+                if (result == true) {
+                    uint8_t windowBits = WindowBits(_settings.ClientMaxWindowBits);
+
+                    if ((accepted.Has(CLIENT_MAX_WINDOW_BITS) == true) && (accepted.ClientMaxWindowBits < windowBits)) {
+                        windowBits = accepted.ClientMaxWindowBits;
+                    }
+
+                    Enable(windowBits, (_settings.ClientNoContextTakeover == true) || (accepted.Has(CLIENT_NO_CONTEXT_TAKEOVER) == true));
+                }
+            }
+
+            return (result);
+        }
+
+        string Deflate::Negotiate(const string& offers)
+        {
+            string result;
+
+            Reset();
+
+            if (_configured == true) {
+                size_t begin = 0;
+
+                while ((result.empty() == true) && (begin != string::npos)) {
+                    const size_t end = offers.find(',', begin);
+                    DeflateOffer offer(offers.substr(begin, (end == string::npos ? string::npos : end - begin)));
+
+                    begin = (end == string::npos ? end : end + 1);
+
+                    if (offer.IsValid() == true) {
+                        const bool serverNoContextTakeover = ((_settings.ServerNoContextTakeover == true) || (offer.Has(SERVER_NO_CONTEXT_TAKEOVER) == true));
+                        uint8_t serverWindowBits = WindowBits(_settings.ServerMaxWindowBits);
+                        uint8_t clientWindowBits = WindowBits(_settings.ClientMaxWindowBits);
+
+                        if (offer.ServerMaxWindowBits < serverWindowBits) {
+                            serverWindowBits = offer.ServerMaxWindowBits;
+                        }
+                        if (offer.ClientMaxWindowBits < clientWindowBits) {
+                            clientWindowBits = offer.ClientMaxWindowBits;
+                        }
+
+                        result = PermessageDeflate;
+
+                        if (serverNoContextTakeover == true) {
+                            result += _T("; server_no_context_takeover");
+                        }
+                        if ((_settings.ClientNoContextTakeover == true) || (offer.Has(CLIENT_NO_CONTEXT_TAKEOVER) == true)) {
+                            result += _T("; client_no_context_takeover");
+                        }
+                        // A smaller window than offered is always fine for the client, so only answer if asked.
+                        if (offer.Has(SERVER_MAX_WINDOW_BITS) == true) {
+                            result += _T("; server_max_window_bits=") + Core::NumberType<uint8_t>(serverWindowBits).Text();
+                        }
+                        if ((offer.Has(CLIENT_MAX_WINDOW_BITS) == true) && (clientWindowBits < 15)) {
+                            result += _T("; client_max_window_bits=") + Core::NumberType<uint8_t>(clientWindowBits).Text();
+                        }
+
+                        Enable(serverWindowBits, serverNoContextTakeover);
+                    }
+                }
+            }
+
+            return (result);
+        }
+
+        void Deflate::Reset()
+        {
+            if (_deflating == true) {
+                ::deflateEnd(&_deflate);
+                _deflating = false;
+            }
+            if (_inflating == true) {
+                ::inflateEnd(&_inflate);
+                _inflating = false;
+            }
+
+            _enabled = false;
+            _windowBits = 0;
+            _noContextTakeover = false;
+            _inflatedSize = 0;
+
+            std::vector<uint8_t>().swap(_buffer);
+        }
+
+        void Deflate::Enable(const uint8_t windowBits, const bool noContextTakeover)
+        {
+            _enabled = true;
+            _windowBits = windowBits;
+            _noContextTakeover = noContextTakeover;
+        }
+
+        bool Deflate::Compress(std::vector<uint8_t>& message)
+        {
+            bool result = false;
+
+            // zlib can not deflate with a window of 256 bytes, if that is all the peer allows the
+            // messages go out uncompressed, which is always allowed.
+            if ((_enabled == true) && (_windowBits > 8) && (message.size() >= _settings.Threshold) && (message.empty() == false)) {
+                if (_deflating == false) {
+                    ::memset(&_deflate, 0, sizeof(_deflate));
+
+                    _deflating = (::deflateInit2(&_deflate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -_windowBits, (_windowBits - 7), Z_DEFAULT_STRATEGY) == Z_OK);
+                }
+
+                if (_deflating == true) {
+                    uint32_t produced = 0;
+                    int status = Z_OK;
+
+                    _buffer.resize(::deflateBound(&_deflate, static_cast<uLong>(message.size())) + sizeof(DeflateTail) + 8);
+
+                    _deflate.next_in = message.data();
+                    _deflate.avail_in = static_cast<uInt>(message.size());
+
+                    do {
+                        if (produced == _buffer.size()) {
+                            _buffer.resize(_buffer.size() * 2);
+                        }
+
+                        _deflate.next_out = &(_buffer[produced]);
+                        _deflate.avail_out = static_cast<uInt>(_buffer.size() - produced);
+
+                        status = ::deflate(&_deflate, Z_SYNC_FLUSH);
+
+                        produced = static_cast<uint32_t>(_buffer.size() - _deflate.avail_out);
+
+                    } while ((status == Z_OK) && (_deflate.avail_out == 0));
+
+                    if ((status == Z_OK) && (produced >= sizeof(DeflateTail)) && (::memcmp(&(_buffer[produced - sizeof(DeflateTail)]), DeflateTail, sizeof(DeflateTail)) == 0)) {
+                        // The empty block of the flush is implied by the message end.
+                        _buffer.resize(produced - sizeof(DeflateTail));
+                        message.swap(_buffer);
+
+                        if (_noContextTakeover == true) {
+                            ::deflateReset(&_deflate);
+                        }
+
+                        result = true;
+                    } else {
+                        // Start over with a fresh context, the peer never saw what went in.
+                        ::deflateEnd(&_deflate);
+                        _deflating = false;
+                    }
+                }
+            }
+
+            return (result);
+        }
+
+        uint32_t Deflate::Decompress(const uint8_t data[], const uint16_t length, const bool last, std::vector<uint8_t>& output, const uint32_t maxSize)
+        {
+            uint32_t result = Core::ERROR_UNAVAILABLE;
+
+            if (_inflating == false) {
+                ::memset(&_inflate, 0, sizeof(_inflate));
+
+                // Whatever window the peer deflates with, the largest one can inflate it.
+                _inflating = (::inflateInit2(&_inflate, -15) == Z_OK);
+            }
+
+            if (_inflating == true) {
+                const size_t start = output.size();
+                const uint32_t room = (_inflatedSize < maxSize ? maxSize - _inflatedSize : 0);
+
+                result = Inflate(_inflate, data, length, output, room);
+
+                if ((result == Core::ERROR_NONE) && (last == true)) {
+                    result = Inflate(_inflate, DeflateTail, sizeof(DeflateTail), output, static_cast<uint32_t>(room - (output.size() - start)));
+                }
+
+                // Counts per message, a message that failed is not continued.
+                _inflatedSize = ((result != Core::ERROR_NONE) || (last == true) ? 0 : static_cast<uint32_t>(_inflatedSize + (output.size() - start)));
+            }
+
+            return (result);
+        }
+
+        // XORs the key over the payload, a block at a time. The destination may be the source or lie before
+        // it, every block is loaded before it is stored so moving the payload down is part of the same pass.
+        static void Mask(uint8_t destination[], const uint8_t source[], const uint32_t length, const uint8_t key[4], const uint8_t phase)
+        {
+            uint8_t pattern[32];
+            uint32_t index = 0;
+
+            // The key, lined up with the first byte, repeated over the widest block.
+            for (uint8_t teller = 0; teller < sizeof(pattern); teller++) {
+                pattern[teller] = key[(phase + teller) & 0x03];
+            }
+
+#if defined(__AVX2__)
+            const __m256i wide = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+
+            for (; (index + 32) <= length; index += 32) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&source[index]));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(&destination[index]), _mm256_xor_si256(block, wide));
+            }
+#endif
+#if defined(__SSE2__)
+            const __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+
+            for (; (index + 16) <= length; index += 16) {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&source[index]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&destination[index]), _mm_xor_si128(block, half));
+            }
+#elif defined(__ARM_NEON)
+            const uint8x16_t half = vld1q_u8(pattern);
+
+            for (; (index + 16) <= length; index += 16) {
+                const uint8x16_t block = vld1q_u8(&source[index]);
+                vst1q_u8(&destination[index], veorq_u8(block, half));
+            }
+#endif
+            uint64_t word;
+            ::memcpy(&word, pattern, sizeof(word));
+
+            for (; (index + 8) <= length; index += 8) {
+                uint64_t block;
+                ::memcpy(&block, &source[index], sizeof(block));
+                block ^= word;
+                ::memcpy(&destination[index], &block, sizeof(block));
+            }
+
+            for (; index < length; index++) {
+                destination[index] = source[index] ^ pattern[index & 0x03];
+            }
+        }
+
         /*  %x0 denotes a continuation frame
  *  %x1 denotes a text frame
  *  %x2 denotes a binary frame
@@ -77,35 +506,29 @@ namespace Web {
  *  %xA denotes a pong
  *  %xB-F are reserved for further control frames
  */
-        uint16_t Protocol::Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize)
+        uint16_t Protocol::Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize, const bool last, const bool compressed)
         {
             uint32_t result = 0;
 
             if ((usedSize != 0) || (SendInProgress() == true)) {
+                const uint8_t offset = PayloadOffset();
+
                 result = (usedSize <= 125 ? 2 : 4);
 
                 if ((_setFlags & MASKING_FRAME) == 0) {
                     // Only if this is a smallFrame, we need to "flush" 2 bytes..
-                    if ((result == 2) && (usedSize != 0)) {
+                    if ((result != offset) && (usedSize != 0)) {
                         // No masking, so just move and insert the header up front..
-                        ::memmove(&dataFrame[2], &(dataFrame[4]), usedSize);
+                        ::memmove(&dataFrame[result], &(dataFrame[offset]), usedSize);
                     }
                 } else {
                     uint8_t maskKey[4];
                     GenerateMaskKey(maskKey);
 
-                    // Mask and insert the bytes on the right spots
-                    uint8_t* source = &dataFrame[usedSize - 1 + 4];
-                    uint8_t* destination = &dataFrame[usedSize - 1 + 4 + result];
-                    uint32_t bytesToMove = usedSize;
-
-                    while (bytesToMove != 0) {
-                        bytesToMove--;
-                        *destination-- = (*source ^ maskKey[(bytesToMove & 0x3)]);
-                        source--;
-                    }
+                    // The payload is where a large masked frame has it, a small one is masked and moved down in one go.
+                    Mask(&dataFrame[result + 4], &dataFrame[offset], usedSize, maskKey, 0);
 
-                    // Now there is space again, write down the encryption key.
+                    // Now write down the encryption key.
                     ::memcpy(&dataFrame[result], &maskKey, 4);
                     result += 4;
                 }
@@ -119,48 +542,63 @@ namespace Web {
                     dataFrame[3] = (usedSize & 0xFF);
                 }
 
-                if (usedSize < maxSendSize) {
+                // Only the first frame of a message carries the type and the RSV1 bit of a deflated message.
+                const uint8_t type = (SendInProgress() == true ? CONTINUATION_FRAME : ((TYPE_FRAME & _setFlags) | (compressed == true ? COMPRESSED_FRAME : 0)));
+
+                if (last == true) {
                     // Seems like not all available space is used, so I guess we are ready..
-                    dataFrame[0] = FINISHING_FRAME | (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                    dataFrame[0] = FINISHING_FRAME | type;
                     _progressInfo &= (~0x40);
                 } else {
                     // There is more to come, this is just part of a bigger picture
-                    dataFrame[0] = (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                    dataFrame[0] = type;
                     _progressInfo |= (0x40);
                 }
 
                 result += usedSize;
             }
 
-            if (((_controlStatus & (REQUEST_CLOSE | REQUEST_PING | REQUEST_PONG)) != 0) && (result + (((_setFlags & MASKING_FRAME) != 0) ? 6 : 2) < maxSendSize)) {
-                if ((_controlStatus & REQUEST_CLOSE) != 0) {
-                    dataFrame[result++] = FINISHING_FRAME | Protocol::CLOSE;
-                    _controlStatus &= (~REQUEST_CLOSE);
-                    dataFrame[result++] = (_setFlags & MASKING_FRAME);
-                }
-                if (((_controlStatus & REQUEST_PING) != 0) && ((result + 1) < maxSendSize)) {
-                    dataFrame[result++] = FINISHING_FRAME | Protocol::PING;
-                    _controlStatus &= (~REQUEST_PING);
-                    dataFrame[result++] = (_setFlags & MASKING_FRAME);
-                }
-                if (((_controlStatus & REQUEST_PONG) != 0) && ((result + 1) < maxSendSize)) {
-                    dataFrame[result++] = FINISHING_FRAME | Protocol::PONG;
-                    _controlStatus &= (~REQUEST_PONG);
-                    dataFrame[result++] = (_setFlags & MASKING_FRAME);
-                }
-
-                if ((_setFlags & MASKING_FRAME) != 0) {
-                  // Now it seems only control message, hence append with masking keys
-                  uint8_t maskKey[4];
-                  GenerateMaskKey(maskKey);
-                  ::memcpy(&dataFrame[result], &maskKey, 4);
-                  result += 4;
-                }
+            // A control frame takes at most 8 bytes: header, masking key and a status code.
+            if (((_controlStatus & REQUEST_CLOSE) != 0) && ((result + 8) < maxSendSize)) {
+                result += Control(&dataFrame[result], Protocol::CLOSE, _closeCode);
+                _controlStatus &= (~REQUEST_CLOSE);
+            }
+            if (((_controlStatus & REQUEST_PING) != 0) && ((result + 8) < maxSendSize)) {
+                result += Control(&dataFrame[result], Protocol::PING, 0);
+                _controlStatus &= (~REQUEST_PING);
+            }
+            if (((_controlStatus & REQUEST_PONG) != 0) && ((result + 8) < maxSendSize)) {
+                result += Control(&dataFrame[result], Protocol::PONG, 0);
+                _controlStatus &= (~REQUEST_PONG);
             }
 
             return (result);
         }
 
+        // A control frame, with its own masking key if masked, carrying the status code if there is one.
+        uint8_t Protocol::Control(uint8_t* dataFrame, const uint8_t type, const uint16_t code)
+        {
+            const uint8_t payload[2] = { static_cast<uint8_t>(code >> 8), static_cast<uint8_t>(code & 0xFF) };
+            const uint8_t length = (code != 0 ? sizeof(payload) : 0);
+            uint8_t result = 2;
+
+            dataFrame[0] = FINISHING_FRAME | type;
+            dataFrame[1] = (_setFlags & MASKING_FRAME) | length;
+
+            if ((_setFlags & MASKING_FRAME) != 0) {
+                uint8_t maskKey[4];
+                GenerateMaskKey(maskKey);
+                ::memcpy(&dataFrame[result], &maskKey, 4);
+                result += 4;
+
+                Mask(&dataFrame[result], payload, length, maskKey, 0);
+            } else {
+                ::memcpy(&dataFrame[result], payload, length);
+            }
+
+            return (result + length);
+        }
+
         uint16_t Protocol::Decoder(uint8_t* dataFrame, uint16_t& receivedSize)
         {
             uint16_t actualHeader = 0;
@@ -177,12 +615,10 @@ namespace Web {
                         receivedSize = _pendingReceiveBytes;
                     }
 
-                    for (uint16_t tmp = receivedSize; _pendingReceiveBytes != 0 && tmp != 0; --tmp) {
-                        *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                        source++;
-                        _progressInfo = ((_progressInfo + 1) & 0x03) | (_progressInfo & 0xFC);
-                        _pendingReceiveBytes--;
-                    }
+                    Mask(source, source, receivedSize, _scrambleKey, (_progressInfo & 0x03));
+
+                    _progressInfo = ((_progressInfo + receivedSize) & 0x03) | (_progressInfo & 0xFC);
+                    _pendingReceiveBytes -= receivedSize;
                 } else {
                     if (_pendingReceiveBytes > receivedSize) {
                         _pendingReceiveBytes -= receivedSize;
@@ -208,6 +644,11 @@ namespace Web {
                 } else {
                     _frameType = static_cast<frameType>(dataFrame[0] & TYPE_FRAME);
 
+                    // The first frame of a data message tells if the message is deflated (RFC 7692).
+                    if ((_frameType != 0) && ((_frameType & CONTROL_FRAME) == 0)) {
+                        _progressInfo = ((dataFrame[0] & COMPRESSED_FRAME) != 0 ? (_progressInfo | 0x10) : (_progressInfo & (~0x10)));
+                    }
+
                     // Continuation frame is only allowed if a receive is in progress...
                     if (ReceiveInProgress() == true) {
                         if (_frameType == 0) {
@@ -263,14 +704,9 @@ namespace Web {
                             _progressInfo |= 0x20;
                             _progressInfo &= (~0x03);
 
-                            uint8_t* source = &dataFrame[actualHeader];
+                            Mask(&dataFrame[actualHeader], &dataFrame[actualHeader], static_cast<uint32_t>(bytesToMove), _scrambleKey, 0);
 
-                            while (bytesToMove != 0) {
-                                *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                                source++;
-                                bytesToMove--;
-                                _progressInfo = ((_progressInfo + 1) & 0xF3);
-                            }
+                            _progressInfo |= (bytesToMove & 0x03);
                         }
                     }
                 }
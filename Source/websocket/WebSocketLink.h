@@ -40,6 +40,12 @@ namespace Web {
                 INCONSISTENT = 0x30 // e.g. Protocol defined as Text, but received a binary.
             };
 
+            // The status codes of a close frame (RFC 6455, 7.4.1) that we send ourselves.
+            enum closeCode : uint16_t {
+                CLOSE_PROTOCOL_ERROR = 1002,
+                CLOSE_MESSAGE_TOO_BIG = 1009
+            };
+
         private:
             enum controlTypes {
                 REQUEST_CLOSE = 0x01,
@@ -59,6 +65,7 @@ namespace Web {
                 , _pendingReceiveBytes(0)
                 , _frameType(TEXT)
                 , _controlStatus(0)
+                , _closeCode(0)
             {
                 ::memset(_scrambleKey, 0, sizeof(_scrambleKey));
             }
@@ -82,6 +89,12 @@ namespace Web {
             {
                 _controlStatus |= REQUEST_CLOSE;
             }
+            // Closes with a status code (RFC 6455, 7.4.1), e.g. 1002 on a protocol error.
+            void Close(const uint16_t code)
+            {
+                _closeCode = code;
+                _controlStatus |= REQUEST_CLOSE;
+            }
             bool ReceiveInProgress() const
             {
                 return ((_progressInfo & 0x80) != 0);
@@ -94,6 +107,11 @@ namespace Web {
             {
                 return (_pendingReceiveBytes == 0);
             }
+            // The message being received has the RSV1 bit set, it is deflated.
+            bool IsCompressed() const
+            {
+                return ((_progressInfo & 0x10) != 0);
+            }
             void Flush()
             {
                 _pendingReceiveBytes = 0;
@@ -118,11 +136,23 @@ namespace Web {
             {
                 return ((_setFlags & 0x80) != 0);
             }
+            // Where the payload goes for the Encoder: room for the largest header, so a masked
+            // frame that needs it all is masked in place.
+            uint8_t PayloadOffset() const
+            {
+                return (Masking() == true ? 8 : 4);
+            }
 
-            uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize);
+            uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize)
+            {
+                return (Encoder(dataFrame, maxSendSize, usedSize, (usedSize < maxSendSize), false));
+            }
+            uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize, const bool last, const bool compressed);
             uint16_t Decoder(uint8_t* dataFrame, uint16_t& receivedSize);
 
         private:
+            uint8_t Control(uint8_t* dataFrame, const uint8_t type, const uint16_t code);
+
             inline void GenerateMaskKey(uint8_t *maskKey)
             {
                 uint32_t value;
@@ -141,6 +171,110 @@ namespace Web {
             frameType _frameType;
             uint8_t _scrambleKey[4];
             uint8_t _controlStatus;
+            uint16_t _closeCode;
+        };
+
+        // RFC 7692, permessage-deflate. Negotiated in the upgrade handshake, after which messages
+        // from the size of the threshold on are sent deflated, smaller ones go out as they are.
+        class EXTERNAL Deflate {
+        public:
+            class Settings {
+            public:
+                Settings(const uint16_t threshold = 256, const uint8_t serverMaxWindowBits = 15, const uint8_t clientMaxWindowBits = 15, const bool serverNoContextTakeover = false, const bool clientNoContextTakeover = false, const uint32_t maxMessageSize = 0)
+                    : Threshold(threshold)
+                    , ServerMaxWindowBits(serverMaxWindowBits)
+                    , ClientMaxWindowBits(clientMaxWindowBits)
+                    , ServerNoContextTakeover(serverNoContextTakeover)
+                    , ClientNoContextTakeover(clientNoContextTakeover)
+                    , MaxMessageSize(maxMessageSize)
+                {
+                }
+                ~Settings() = default;
+
+            public:
+                uint16_t Threshold;
+                uint8_t ServerMaxWindowBits;
+                uint8_t ClientMaxWindowBits;
+                bool ServerNoContextTakeover;
+                bool ClientNoContextTakeover;
+                // The most a received message may inflate to, 0 leaves it to the link.
+                uint32_t MaxMessageSize;
+            };
+
+        public:
+            Deflate(const Deflate&) = delete;
+            Deflate& operator=(const Deflate&) = delete;
+
+            Deflate()
+                : _settings()
+                , _configured(false)
+                , _enabled(false)
+                , _windowBits(0)
+                , _noContextTakeover(false)
+                , _deflating(false)
+                , _inflating(false)
+                , _inflatedSize(0)
+                , _buffer()
+            {
+            }
+            ~Deflate()
+            {
+                Reset();
+            }
+
+        public:
+            void Configure(const Settings& settings)
+            {
+                _settings = settings;
+                _configured = true;
+            }
+            bool IsConfigured() const
+            {
+                return (_configured);
+            }
+            bool IsEnabled() const
+            {
+                return (_enabled);
+            }
+            uint16_t Threshold() const
+            {
+                return (_settings.Threshold);
+            }
+            uint32_t MaxMessageSize() const
+            {
+                return (_settings.MaxMessageSize);
+            }
+
+            // Client side: the offer for the request and the check of what the server accepted.
+            string Offer() const;
+            bool Accept(const string& response);
+
+            // Server side: pick the first offer that can be honoured, returns the response, empty if declined.
+            string Negotiate(const string& offers);
+
+            void Reset();
+
+            // Deflates a complete message in place, returns false if it goes out as it is.
+            bool Compress(std::vector<uint8_t>& message);
+            // Inflates (part of) a message into the output, the last part flushes the message. Fails with
+            // ERROR_INVALID_INPUT_LENGTH as soon as the message inflates to more than maxSize.
+            uint32_t Decompress(const uint8_t data[], const uint16_t length, const bool last, std::vector<uint8_t>& output, const uint32_t maxSize);
+
+        private:
+            void Enable(const uint8_t windowBits, const bool noContextTakeover);
+
+        private:
+            Settings _settings;
+            bool _configured;
+            bool _enabled;
+            uint8_t _windowBits;
+            bool _noContextTakeover;
+            bool _deflating;
+            bool _inflating;
+            uint32_t _inflatedSize;
+            z_stream _deflate;
+            z_stream _inflate;
+            std::vector<uint8_t> _buffer;
         };
 
         class EXTERNAL RequestAllocator : public Core::ProxyPoolType<Web::Request> {
@@ -197,6 +331,8 @@ namespace Web {
         private:
             typedef HandlerType<ACTUALLINK> ThisClass;
 
+            static constexpr uint32_t InflateFactor = 64;
+
             class SerializerImpl : public OUTBOUND::Serializer {
             private:
                 typedef typename OUTBOUND::Serializer BaseClass;
@@ -242,6 +378,10 @@ namespace Web {
                 {
                     return (OUTBOUND::Serializer::Serialize(stream, maxLength));
                 }
+                bool Serialize(Core::SocketPort::Region& region)
+                {
+                    return (OUTBOUND::Serializer::Serialize(region));
+                }
                 void Flush()
                 {
                     _adminLock.Lock();
@@ -382,6 +522,12 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _message()
+                , _messageOffset(0)
+                , _compressed(false)
+                , _inflated()
+                , _failed(false)
             {
             }
             template <typename... Args>
@@ -399,6 +545,12 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
+                , _message()
+                , _messageOffset(0)
+                , _compressed(false)
+                , _inflated()
+                , _failed(false)
             {
             }
 POP_WARNING()
@@ -465,6 +617,19 @@ POP_WARNING()
             {
                 _handler.Masking(masking);
             }
+            // Offer (client) or accept (server) permessage-deflate on the next upgrade.
+            void Compression(const WebSocket::Deflate::Settings& settings)
+            {
+                _adminLock.Lock();
+
+                _deflate.Configure(settings);
+
+                _adminLock.Unlock();
+            }
+            bool IsCompressed() const
+            {
+                return (_deflate.IsEnabled());
+            }
             void Ping()
             {
                 _pingFireTime = Core::Time::Now().Ticks();
@@ -546,9 +711,13 @@ POP_WARNING()
 
                 if ((_state & WEBSOCKET) != 0) {
                     if (maxSendSize > 8) {
-                        result = _parent.SendData(&(dataFrame[4]), (maxSendSize - 8));
+                        if (_deflate.IsEnabled() == false) {
+                            result = _parent.SendData(&(dataFrame[_handler.PayloadOffset()]), (maxSendSize - 8));
 
-                        result = _handler.Encoder(dataFrame, (maxSendSize - 8), result);
+                            result = _handler.Encoder(dataFrame, (maxSendSize - 8), result);
+                        } else {
+                            result = SendMessage(dataFrame, (maxSendSize - 8));
+                        }
                     }
                 } else {
                     result = _serializerImpl.Serialize(dataFrame, maxSendSize);
@@ -562,6 +731,22 @@ POP_WARNING()
 
                 return (result);
             }
+            bool SendFile(Core::SocketPort::Region& region) override
+            {
+                bool result = false;
+
+                _adminLock.Lock();
+
+                // Web pages served from a file go out straight from that file.
+                if ((_state & WEBSOCKET) == 0) {
+                    _state |= ACTIVITY;
+                    result = _serializerImpl.Serialize(region);
+                }
+
+                _adminLock.Unlock();
+
+                return (result);
+            }
             uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
             {
                 uint16_t result = 0;
@@ -573,6 +758,11 @@ POP_WARNING()
                 if ((_state & WEBSOCKET) != 0) {
                     bool tooSmall = false;
 
+                    if (_failed == true) {
+                        // The connection failed and is closing, whatever still comes in is dropped.
+                        result = receivedSize;
+                    }
+
                     // check for multiple messages if available...
                     while ((result < receivedSize) && (tooSmall == false)) {
                         uint16_t actualDataSize = receivedSize - result;
@@ -645,6 +835,40 @@ POP_WARNING()
 
                                 result += static_cast<uint16_t>(headerSize + payloadSizeInControlFrame); // actualDataSize
 
+                            } else if ((_handler.IsCompressed() == true) && (_deflate.IsEnabled() == false)) {
+                                // RSV1 only means something once permessage-deflate is negotiated (RFC 7692, 6).
+                                TRACE_L1("Oops we received a compressed message on the web socket while deflate was not negotiated");
+
+                                Fail(WebSocket::Protocol::CLOSE_PROTOCOL_ERROR);
+                                result = receivedSize;
+                            } else if (_handler.IsCompressed() == true) {
+                                const bool last = ((_handler.IsCompleteMessage() == true) && (_handler.ReceiveInProgress() == false));
+                                const uint32_t status = _deflate.Decompress(&(dataFrame[result + headerSize]), actualDataSize, last, _inflated, MaxMessageSize());
+
+                                if (status == Core::ERROR_INVALID_INPUT_LENGTH) {
+                                    TRACE_L1("Oops we received a message on the web socket that inflates to more than %u bytes", MaxMessageSize());
+
+                                    Fail(WebSocket::Protocol::CLOSE_MESSAGE_TOO_BIG);
+                                    result = receivedSize;
+                                } else if (status != Core::ERROR_NONE) {
+                                    TRACE_L1("Oops we received a message on the web socket that does not inflate");
+
+                                    result = receivedSize;
+                                } else {
+                                    uint32_t offset = 0;
+
+                                    while (offset < _inflated.size()) {
+                                        const uint16_t size = static_cast<uint16_t>(std::min(_inflated.size() - offset, static_cast<size_t>(0xFFFF)));
+
+                                        _parent.ReceiveData(&(_inflated[offset]), size);
+
+                                        offset += size;
+                                    }
+
+                                    result += (headerSize + actualDataSize);
+                                }
+
+                                _inflated.clear();
                             } else {
                                 _parent.ReceiveData(&(dataFrame[result + headerSize]), actualDataSize);
 
@@ -707,6 +931,21 @@ POP_WARNING()
             {
                 return (_state.load(Core::memory_order::memory_order_relaxed));
             }
+            // Unless configured otherwise, a deflated message may grow to this many times the receive buffer.
+            uint32_t MaxMessageSize() const
+            {
+                return (_deflate.MaxMessageSize() != 0 ? _deflate.MaxMessageSize() : (static_cast<uint32_t>(ACTUALLINK::ReceiveBufferSize()) * InflateFactor));
+            }
+            // Fail the connection (RFC 6455, 7.1.7): the close frame goes out and the link closes after.
+            void Fail(const uint16_t code)
+            {
+                _failed = true;
+                _state |= SUSPENDED;
+
+                _handler.Close(code);
+
+                ACTUALLINK::Trigger();
+            }
             uint32_t CheckForClose(uint32_t waitTime)
             {
                 uint32_t result = 0;
@@ -734,6 +973,51 @@ POP_WARNING()
 
                 return (result);
             }
+            // With deflate negotiated, a message is collected as a whole before it is framed, as the
+            // size decides if it is compressed and compression has to see all of it.
+            uint16_t SendMessage(uint8_t* dataFrame, const uint16_t maxPayload)
+            {
+                uint16_t result = 0;
+
+                uint8_t* payload = &(dataFrame[_handler.PayloadOffset()]);
+
+                if (_messageOffset == _message.size()) {
+                    uint16_t loaded = _parent.SendData(payload, maxPayload);
+
+                    if ((loaded == 0) || ((loaded < maxPayload) && (loaded < _deflate.Threshold()))) {
+                        // Small enough to fit a frame and not worth compressing, send it as it is.
+                        result = _handler.Encoder(dataFrame, maxPayload, loaded);
+                    } else {
+                        _message.assign(payload, payload + loaded);
+
+                        while (loaded == maxPayload) {
+                            loaded = _parent.SendData(payload, maxPayload);
+                            _message.insert(_message.end(), payload, payload + loaded);
+                        }
+
+                        _messageOffset = 0;
+                        _compressed = _deflate.Compress(_message);
+                    }
+                }
+
+                if (_messageOffset < _message.size()) {
+                    const uint16_t size = static_cast<uint16_t>(std::min(_message.size() - _messageOffset, static_cast<size_t>(maxPayload)));
+
+                    ::memcpy(payload, &(_message[_messageOffset]), size);
+                    _messageOffset += size;
+
+                    const bool last = (_messageOffset == _message.size());
+
+                    result = _handler.Encoder(dataFrame, maxPayload, size, last, _compressed);
+
+                    if (last == true) {
+                        _message.clear();
+                        _messageOffset = 0;
+                    }
+                }
+
+                return (result);
+            }
             void Serialized(const Core::ProxyType<OUTBOUND>& element)
             {
                 _parent.Send(Core::ProxyType<OUTBOUND>(element));
@@ -802,6 +1086,14 @@ POP_WARNING()
                                 ASSERT(_protocol.Size() == 1);
                                 _webSocketMessage->WebSocketProtocol = _protocol.First();
                             }
+
+                            const string extensions(_deflate.Negotiate(element->WebSocketExtensions.IsSet() == true ? element->WebSocketExtensions.Value() : string()));
+
+                            if (extensions.empty() == false) {
+                                _webSocketMessage->WebSocketExtensions = extensions;
+                            } else {
+                                _webSocketMessage->WebSocketExtensions.Clear();
+                            }
                         }
                     }
 
@@ -863,6 +1155,9 @@ POP_WARNING()
                     if (protocol.empty() == false) {
                         _webSocketMessage->WebSocketProtocol = Web::ProtocolsArray(protocol);
                     }
+                    if (_deflate.IsConfigured() == true) {
+                        _webSocketMessage->WebSocketExtensions = _deflate.Offer();
+                    }
 
                     _query = query;
                     _path = path;
@@ -886,16 +1181,23 @@ POP_WARNING()
                 if ((_webSocketMessage.IsValid() == true) && (element->ErrorCode == Web::STATUS_SWITCH_PROTOCOL) && (element->WebSocketAccept.Value() == _handler.ResponseKey(_webSocketMessage->WebSocketKey.Value()))) {
                     ASSERT((_state & UPGRADING) != 0);
 
-                    _adminLock.Lock();
+                    if (_deflate.Accept(element->WebSocketExtensions.IsSet() == true ? element->WebSocketExtensions.Value() : string()) == false) {
+                        // The server accepted an extension that was not offered like this, fail the connection.
+                        TRACE_L1("Upgrade response with unexpected extensions: %s", element->WebSocketExtensions.Value().c_str());
 
-                    // Seems like we succeeded, turn on the link..
-                    _state = (_state & 0xF0) | WEBSOCKET;
+                        Close(0);
+                    } else {
+                        _adminLock.Lock();
 
-                    _parent.StateChange();
+                        // Seems like we succeeded, turn on the link..
+                        _state = (_state & 0xF0) | WEBSOCKET;
 
-                    _adminLock.Unlock();
+                        _parent.StateChange();
 
-                    ACTUALLINK::Trigger();
+                        _adminLock.Unlock();
+
+                        ACTUALLINK::Trigger();
+                    }
                 } else if ((_webSocketMessage.IsValid() == true) && (element->ErrorCode == Web::STATUS_FORBIDDEN)) {
                     ASSERT((_state & UPGRADING) != 0);
 
@@ -920,6 +1222,12 @@ POP_WARNING()
             string _commandData;
             Core::ProxyType<typename OUTBOUND::BaseElement> _webSocketMessage;
             uint64_t _pingFireTime;
+            WebSocket::Deflate _deflate;
+            std::vector<uint8_t> _message;
+            uint32_t _messageOffset;
+            bool _compressed;
+            std::vector<uint8_t> _inflated;
+            bool _failed;
         };
 
     public:
@@ -1002,6 +1310,14 @@ POP_WARNING()
         {
             return (_channel.Masking());
         }
+        void Compression(const WebSocket::Deflate::Settings& settings)
+        {
+            _channel.Compression(settings);
+        }
+        bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
         void ResetActivity()
         {
             return (_channel.ResetActivity());
@@ -1247,6 +1563,14 @@ POP_WARNING()
         {
             return (_channel.Masking());
         }
+        void Compression(const WebSocket::Deflate::Settings& settings)
+        {
+            _channel.Compression(settings);
+        }
+        bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
         uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -1405,6 +1729,14 @@ POP_WARNING()
         {
             return (_channel.Masking());
         }
+        void Compression(const WebSocket::Deflate::Settings& settings)
+        {
+            _channel.Compression(settings);
+        }
+        bool IsCompressed() const
+        {
+            return (_channel.IsCompressed());
+        }
         uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -537,7 +537,11 @@ POP_WARNING()
 
                     if (message.empty() == true) {
                         _CalculateHash(*_response);
-                        _response->Body(_fileBody);
+                        _Range(*element);
+
+                        if (_response->ErrorCode != Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE) {
+                            _response->Body(_fileBody);
+                        }
                     } else {
                         // Somehow we are not Authorzed. Kill it....
                         _response->ErrorCode = Web::STATUS_UNAUTHORIZED;
@@ -601,6 +605,29 @@ POP_WARNING()
         {
         }
 
+        // A resumed download only asks for the rest of the file. Signed files are sent as a whole, the
+        // signature covers all of it.
+        template <typename ACTUALFILEBODY = FILEBODY>
+        inline typename Core::TypeTraits::enable_if<hasHash<const ACTUALFILEBODY, const typename ACTUALFILEBODY::HashType&>::value, void>::type
+        _Range(const Web::Request&)
+        {
+        }
+
+        template <typename ACTUALFILEBODY = FILEBODY>
+        inline typename Core::TypeTraits::enable_if<!hasHash<const ACTUALFILEBODY, const typename ACTUALFILEBODY::HashType&>::value, void>::type
+        _Range(const Web::Request& request)
+        {
+            if (request.Range.IsSet() == true) {
+                string contentRange;
+
+                _response->ErrorCode = _fileBody->Range(request.Range.Value(), contentRange);
+
+                if (contentRange.empty() == false) {
+                    _response->ContentRange = contentRange;
+                }
+            }
+        }
+
         template <typename ACTUALFILEBODY = FILEBODY>
         inline typename Core::TypeTraits::enable_if<hasHash<const ACTUALFILEBODY, const typename ACTUALFILEBODY::HashType&>::value, bool>::type
         _ValidateHash(const Core::OptionalType<Signature>& signature) const
@@ -520,6 +520,174 @@ private:
     ThunderWrapper _wrapper;
 };
 
+class ChannelBenchmark {
+private:
+    using Call = Core::IPCMessageType<10, Core::IPC::ScalarType<uint32_t>, Core::IPC::ScalarType<uint32_t>>;
+
+    class WorkerPoolImplementation : public Core::WorkerPool {
+    private:
+        class Dispatcher : public Core::ThreadPool::IDispatcher {
+        public:
+            Dispatcher(const Dispatcher&) = delete;
+            Dispatcher& operator=(const Dispatcher&) = delete;
+
+            Dispatcher() = default;
+            ~Dispatcher() override = default;
+
+        private:
+            void Initialize() override { }
+            void Deinitialize() override { }
+            void Dispatch(Core::IDispatch* job) override
+            {
+                job->Dispatch();
+            }
+        };
+
+    public:
+        WorkerPoolImplementation() = delete;
+        WorkerPoolImplementation(const WorkerPoolImplementation&) = delete;
+        WorkerPoolImplementation& operator=(const WorkerPoolImplementation&) = delete;
+
+        WorkerPoolImplementation(const uint8_t threads)
+            : WorkerPool(threads, Core::Thread::DefaultStackSize(), 64, &_dispatcher)
+            , _dispatcher()
+        {
+            Core::WorkerPool::Run();
+        }
+        ~WorkerPoolImplementation()
+        {
+            Core::WorkerPool::Stop();
+        }
+
+    private:
+        Dispatcher _dispatcher;
+    };
+
+    // Like the COM-RPC server, calls are handled on a worker pool, so they can overlap.
+    class Job : public Core::IDispatch {
+    public:
+        Job() = delete;
+        Job(const Job&) = delete;
+        Job& operator=(const Job&) = delete;
+
+        Job(Core::IPCChannel& channel, const Core::ProxyType<Core::IIPC>& message, const uint32_t workload)
+            : _channel(channel)
+            , _message(message)
+            , _workload(workload)
+        {
+        }
+        ~Job() override = default;
+
+    public:
+        void Dispatch() override
+        {
+            Core::ProxyType<Call> call(_message);
+
+            SleepMs(_workload);
+
+            call->Response() = call->Parameters();
+            _channel.ReportResponse(_message);
+        }
+
+    private:
+        Core::IPCChannel& _channel;
+        Core::ProxyType<Core::IIPC> _message;
+        const uint32_t _workload;
+    };
+
+    class Handler : public Core::IIPCServer {
+    public:
+        Handler() = delete;
+        Handler(const Handler&) = delete;
+        Handler& operator=(const Handler&) = delete;
+
+        Handler(Core::WorkerPool& pool, const uint32_t workload)
+            : _pool(pool)
+            , _workload(workload)
+        {
+        }
+        ~Handler() override = default;
+
+    public:
+        void Procedure(Core::IPCChannel& channel, Core::ProxyType<Core::IIPC>& message) override
+        {
+            _pool.Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<Job>::Create(channel, message, _workload)));
+        }
+
+    private:
+        Core::WorkerPool& _pool;
+        const uint32_t _workload;
+    };
+
+public:
+    ChannelBenchmark() = delete;
+    ChannelBenchmark(const ChannelBenchmark&) = delete;
+    ChannelBenchmark& operator=(const ChannelBenchmark&) = delete;
+
+    ChannelBenchmark(const uint8_t threads, const uint32_t workload)
+        : _factory(Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t>>::Create())
+        , _pool(threads)
+        , _handler(Core::ProxyType<Handler>::Create(_pool, workload))
+        , _server(Core::NodeId(_T("/tmp/comrpctester.benchmark")), 1024, _factory)
+        , _client(Core::NodeId(_T("/tmp/comrpctester.benchmark")), 1024, _factory)
+    {
+        _factory->CreateFactory<Call>(8);
+        _server.Register(Call::Id(), Core::ProxyType<Core::IIPCServer>(_handler));
+        _server.Source().Open(1000);
+        _client.Source().Open(1000);
+    }
+    ~ChannelBenchmark()
+    {
+        _client.Source().Close(1000);
+        _server.Source().Close(1000);
+        _server.Unregister(Call::Id());
+        _factory->DestroyFactories();
+    }
+
+public:
+    // Returns the number of calls per second, issued by <callers> threads on a single channel.
+    uint32_t Measure(const bool multiplexed, const uint8_t callers, const uint32_t calls)
+    {
+        std::vector<std::thread> threads;
+        std::atomic<uint32_t> failed(0);
+
+        _client.Multiplexed(multiplexed);
+
+        const uint64_t start = Core::Time::Now().Ticks();
+
+        for (uint8_t index = 0; index < callers; index++) {
+            threads.emplace_back([this, &failed, callers, calls]() {
+                for (uint32_t count = 0; count < (calls / callers); count++) {
+                    Core::ProxyType<Call> call(Core::ProxyType<Call>::Create(Core::IPC::ScalarType<uint32_t>(count)));
+
+                    if ((_client.Invoke(call, 2000) != Core::ERROR_NONE) || (call->Response().Value() != count)) {
+                        failed++;
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        const uint64_t duration = (Core::Time::Now().Ticks() - start);
+
+        if (failed != 0) {
+            printf("  %u calls failed!\n", failed.load());
+        }
+
+        return (duration == 0 ? 0 : static_cast<uint32_t>((static_cast<uint64_t>(calls) * Core::Time::MicroSecondsPerSecond) / duration));
+    }
+
+private:
+    Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t>> _factory;
+    WorkerPoolImplementation _pool;
+    Core::ProxyType<Handler> _handler;
+    Core::IPCChannelClientType<Core::Void, true, false> _server;
+    Core::IPCChannelClientType<Core::Void, false, false> _client;
+};
+
 int main(int argc, char** argv)
 {
     int result = 0;
@@ -665,6 +833,19 @@ int main(int argc, char** argv)
 
                 break;
             }
+            case 'B': {
+                static constexpr uint8_t Callers = 8;
+                static constexpr uint32_t Calls = 400;
+                static constexpr uint32_t Workload = 1; // ms
+
+                ChannelBenchmark benchmark(4, Workload);
+
+                printf("Benchmarking %u calls of %ums by %u threads over a single channel.\n", Calls, Workload, Callers);
+                printf("  single-flight: %u calls/s\n", benchmark.Measure(false, Callers, Calls));
+                printf("  multiplexed:   %u calls/s\n", benchmark.Measure(true, Callers, Calls));
+
+                break;
+            }
             default: {
                 if (isalnum(character)) {
                     printf("Use the following keys for actions:\n");
@@ -672,6 +853,7 @@ int main(int argc, char** argv)
                     printf("C)lose the channel\n");
                     printf("I)ngest the test string on the channel\n");
                     printf("R)andom junk data\n");
+                    printf("B)enchmark single-flight versus multiplexed invokes\n");
 
                     printf("Q)uit the application\n\n");
                     printf("The channel is directed towards: [%s]:[%d]\n", destination.HostName().c_str(), destination.PortNumber());
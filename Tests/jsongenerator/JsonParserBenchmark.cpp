@@ -0,0 +1,208 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Parsing benchmark over the data types of IJsonGeneratorCorpus.h. The containers below
+// are shaped like the ones the JsonGenerator emits for the corpus, extended with a
+// container as wide as the configuration and JSON-RPC payloads we see in the field.
+
+#include "Module.h"
+
+namespace WPEFramework {
+
+namespace Corpus {
+
+    enum class anenum : uint8_t {
+        ENUM_ONE,
+        ENUM_TWO,
+        ENUM_THREE
+    };
+
+    class CompoundData : public Core::JSON::Container {
+    public:
+        CompoundData(const CompoundData&) = delete;
+        CompoundData& operator=(const CompoundData&) = delete;
+
+        CompoundData()
+            : Core::JSON::Container()
+        {
+            Add(_T("integerelem"), &IntegerElem);
+            Add(_T("stringelem"), &StringElem);
+            Add(_T("boolelem"), &BoolElem);
+            Add(_T("enumelem"), &EnumElem);
+        }
+        ~CompoundData() override = default;
+
+    public:
+        Core::JSON::DecUInt32 IntegerElem;
+        Core::JSON::String StringElem;
+        Core::JSON::Boolean BoolElem;
+        Core::JSON::EnumType<anenum> EnumElem;
+    };
+
+    class NestedCompoundData : public Core::JSON::Container {
+    public:
+        NestedCompoundData(const NestedCompoundData&) = delete;
+        NestedCompoundData& operator=(const NestedCompoundData&) = delete;
+
+        NestedCompoundData()
+            : Core::JSON::Container()
+        {
+            Add(_T("stringelem"), &StringElem);
+            Add(_T("complexelem"), &ComplexElem);
+        }
+        ~NestedCompoundData() override = default;
+
+    public:
+        Core::JSON::String StringElem;
+        CompoundData ComplexElem;
+    };
+
+    class MultipleCompoundParamsData : public Core::JSON::Container {
+    public:
+        MultipleCompoundParamsData(const MultipleCompoundParamsData&) = delete;
+        MultipleCompoundParamsData& operator=(const MultipleCompoundParamsData&) = delete;
+
+        MultipleCompoundParamsData()
+            : Core::JSON::Container()
+        {
+            Add(_T("argumentone"), &ArgumentOne);
+            Add(_T("argumenttwo"), &ArgumentTwo);
+        }
+        ~MultipleCompoundParamsData() override = default;
+
+    public:
+        CompoundData ArgumentOne;
+        CompoundData ArgumentTwo;
+    };
+
+    class WideData : public Core::JSON::Container {
+    public:
+        static constexpr uint8_t Members = 32;
+
+        WideData(const WideData&) = delete;
+        WideData& operator=(const WideData&) = delete;
+
+        WideData()
+            : Core::JSON::Container()
+        {
+            for (uint8_t index = 0; index < Members; index++) {
+                _labels[index] = (index & 1 ? _T("stringelement") : _T("integerelement")) + Core::NumberType<uint8_t>(index).Text();
+
+                if ((index & 1) != 0) {
+                    Add(_labels[index].c_str(), &(Strings[index / 2]));
+                } else {
+                    Add(_labels[index].c_str(), &(Integers[index / 2]));
+                }
+            }
+            Add(_T("nested"), &Nested);
+        }
+        ~WideData() override = default;
+
+    public:
+        Core::JSON::DecUInt32 Integers[Members / 2];
+        Core::JSON::String Strings[Members / 2];
+        NestedCompoundData Nested;
+
+    private:
+        string _labels[Members];
+    };
+
+} // namespace Corpus
+
+ENUM_CONVERSION_BEGIN(Corpus::anenum)
+    { Corpus::anenum::ENUM_ONE, _TXT("enum_one") },
+    { Corpus::anenum::ENUM_TWO, _TXT("enum_two") },
+    { Corpus::anenum::ENUM_THREE, _TXT("enum_three") },
+ENUM_CONVERSION_END(Corpus::anenum)
+
+} // namespace WPEFramework
+
+using namespace WPEFramework;
+
+static void Fill(Corpus::CompoundData& data)
+{
+    data.IntegerElem = 1234567;
+    data.StringElem = _T("compound string element");
+    data.BoolElem = true;
+    data.EnumElem = Corpus::anenum::ENUM_TWO;
+}
+
+static void Fill(Corpus::NestedCompoundData& data)
+{
+    data.StringElem = _T("nested compound string element");
+    Fill(data.ComplexElem);
+}
+
+static void Fill(Corpus::MultipleCompoundParamsData& data)
+{
+    Fill(data.ArgumentOne);
+    Fill(data.ArgumentTwo);
+}
+
+static void Fill(Corpus::WideData& data)
+{
+    for (uint8_t index = 0; index < (Corpus::WideData::Members / 2); index++) {
+        data.Integers[index] = index * 1000;
+        data.Strings[index] = _T("value of a wide container member");
+    }
+    Fill(data.Nested);
+}
+
+template <typename JSONTYPE>
+static void Measure(const TCHAR name[], const uint32_t iterations)
+{
+    string text;
+
+    {
+        // Fill in everything, so every member is looked up while parsing.
+        JSONTYPE source;
+        Fill(source);
+        source.ToString(text);
+    }
+
+    const uint64_t start = Core::Time::Now().Ticks();
+
+    for (uint32_t index = 0; index < iterations; index++) {
+        JSONTYPE target;
+        target.FromString(text);
+    }
+
+    const uint64_t duration = Core::Time::Now().Ticks() - start;
+
+    printf("%-24s %5u bytes %8u parses %10.3f us/parse\n", name, static_cast<uint32_t>(text.length()), iterations,
+        static_cast<double>(duration) / iterations);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t iterations = 100000;
+
+    if (argc == 2) {
+        iterations = Core::NumberType<uint32_t>(Core::TextFragment(argv[1])).Value();
+    }
+
+    Measure<Corpus::CompoundData>(_T("Compound"), iterations);
+    Measure<Corpus::NestedCompoundData>(_T("NestedCompound"), iterations);
+    Measure<Corpus::MultipleCompoundParamsData>(_T("MultipleCompoundParams"), iterations);
+    Measure<Corpus::WideData>(_T("Wide (33 members)"), iterations);
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
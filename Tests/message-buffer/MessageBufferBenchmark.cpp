@@ -0,0 +1,123 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Throughput of the message buffer a process pushes its traces and logs into. A number of
+// producer threads push messages of a trace line size, a consumer on the other end of the
+// buffer waits for the doorbell and pops them, like the MessageClient does.
+
+#include <thread>
+#include "Module.h"
+
+using namespace WPEFramework;
+
+namespace {
+
+    static constexpr uint16_t DataSize = 60 * 1024;
+    static constexpr uint16_t MessageSize = 96;
+
+    struct Result {
+        uint32_t Received;
+        uint32_t Wakeups;
+    };
+
+    void Consume(Messaging::MessageDataBuffer& buffer, const std::atomic<bool>& done, Result& result)
+    {
+        uint8_t message[Messaging::MessageUnit::TempDataBufferSize];
+
+        result.Received = 0;
+        result.Wakeups = 0;
+
+        while (done == false) {
+            if (buffer.Wait(100) == Core::ERROR_NONE) {
+                result.Wakeups++;
+            }
+
+            uint16_t length = sizeof(message);
+            while (buffer.PopData(length, message) != Core::ERROR_READ_ERROR) {
+                result.Received++;
+                length = sizeof(message);
+            }
+        }
+    }
+
+    void Measure(const string& path, const uint8_t producers, const uint32_t messages)
+    {
+        Messaging::MessageDataBuffer producer(_T("benchmark"), producers, path, DataSize, 0, true);
+        Messaging::MessageDataBuffer consumer(_T("benchmark"), producers, path, DataSize, 0, false);
+        std::vector<std::thread> threads;
+        std::atomic<bool> done(false);
+        std::atomic<uint32_t> failed(0);
+        Result result;
+
+        std::thread reader([&]() { Consume(consumer, done, result); });
+
+        const uint64_t start = Core::Time::Now().Ticks();
+
+        for (uint8_t index = 0; index < producers; index++) {
+            threads.emplace_back([&, index]() {
+                uint8_t message[MessageSize];
+                ::memset(message, 'a' + index, sizeof(message));
+
+                for (uint32_t count = index; count < messages; count += producers) {
+                    if (producer.PushData(sizeof(message), message) != Core::ERROR_NONE) {
+                        failed++;
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        const uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        // Give the consumer the time to catch up.
+        SleepMs(300);
+        done = true;
+        reader.join();
+
+        // The buffer overwrites if the consumer falls behind, what is missing was dropped.
+        printf("%2u producers %8u messages %10.0f messages/s %8u received %6u wakeups %4u failed\n", producers, messages,
+            (static_cast<double>(messages) * Core::Time::MicroSecondsPerSecond) / (duration == 0 ? 1 : duration),
+            result.Received, result.Wakeups, static_cast<uint32_t>(failed));
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    uint32_t messages = 100000;
+    const string path(Core::Directory::Normalize(_T("/tmp/MessageBufferBenchmark")));
+
+    if (argc == 2) {
+        messages = Core::NumberType<uint32_t>(Core::TextFragment(argv[1])).Value();
+    }
+
+    Core::Directory(path.c_str()).CreatePath();
+
+    const uint8_t cores = static_cast<uint8_t>(std::max(2u, std::thread::hardware_concurrency()));
+
+    Measure(path, 1, messages);
+    Measure(path, 2, messages);
+    Measure(path, cores, messages);
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -0,0 +1,271 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Cost of the client administration of a SocketServerType with many idle connections: looking up
+// a client by its id, like every job of a channel does, and a Cleanup() while nothing closed and
+// after a part of the clients closed. A std::map looked up and scanned under a lock, as the clients
+// were kept before, is measured next to it as the reference.
+
+#include "Module.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+
+using namespace WPEFramework;
+
+namespace {
+
+    static constexpr uint16_t Port = 12350;
+    static constexpr uint32_t Lookups = 1000000;
+    static constexpr uint16_t Cleanups = 1000;
+
+    class Idle : public Core::SocketStream {
+    public:
+        Idle() = delete;
+        Idle(const Idle&) = delete;
+        Idle& operator=(const Idle&) = delete;
+
+        Idle(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<Idle>* parent)
+            : Core::SocketStream(false, connector, remoteId, 64, 64)
+            , _parent(*parent)
+            , _id(0)
+        {
+        }
+        ~Idle() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        uint32_t Id() const
+        {
+            return (_id);
+        }
+        void Id(const uint32_t id)
+        {
+            _id = id;
+        }
+        uint16_t SendData(uint8_t*, const uint16_t) override
+        {
+            return (0);
+        }
+        uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+        {
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+            // Like a channel of the PluginServer, hand the client back as soon as it closes.
+            if (IsOpen() == false) {
+                _parent.Reclaim(_id);
+            }
+        }
+
+    private:
+        Core::SocketServerType<Idle>& _parent;
+        uint32_t _id;
+    };
+
+    using Server = Core::SocketServerType<Idle>;
+    using Reference = std::map<uint32_t, Core::ProxyType<Idle>>;
+
+    SOCKET Connect()
+    {
+        struct sockaddr_in address;
+        SOCKET result = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        ::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(Port);
+
+        if ((result != INVALID_SOCKET) && (::connect(result, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0)) {
+            ::close(result);
+            result = INVALID_SOCKET;
+        }
+
+        return (result);
+    }
+
+    uint64_t Elapsed(const uint64_t start)
+    {
+        const uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        return (duration == 0 ? 1 : duration);
+    }
+
+    void Report(const TCHAR name[], const uint32_t operations, const uint64_t duration)
+    {
+        printf("%-24s %8u times %10.1f ns\n", name, operations, (static_cast<double>(duration) * 1000) / operations);
+    }
+
+    bool Settle(const Server& server, const uint32_t count)
+    {
+        uint16_t retries = 1000;
+
+        while ((server.Count() != count) && (--retries != 0)) {
+            SleepMs(10);
+        }
+
+        return (server.Count() == count);
+    }
+
+    void Measure(const uint32_t connections, const uint8_t listeners)
+    {
+        Server server(Core::NodeId(_T("127.0.0.1"), Port), listeners);
+        std::vector<SOCKET> sockets;
+        std::vector<uint32_t> ids;
+        Core::CriticalSection lock;
+        Reference reference;
+        uint64_t start;
+        uint32_t found = 0;
+
+        if (server.Open(0) != Core::ERROR_NONE) {
+            printf("Could not open the server on port %u\n", Port);
+            return;
+        }
+
+        start = Core::Time::Now().Ticks();
+        for (uint32_t index = 0; index < connections; index++) {
+            const SOCKET socket = Connect();
+
+            if (socket != INVALID_SOCKET) {
+                sockets.push_back(socket);
+            }
+
+            // Do not overrun the listen queue.
+            if ((index % 32) == 31) {
+                Settle(server, static_cast<uint32_t>(sockets.size()));
+            }
+        }
+        if (Settle(server, static_cast<uint32_t>(sockets.size())) == false) {
+            printf("Only %u of %u connections were accepted\n", server.Count(), static_cast<uint32_t>(sockets.size()));
+        }
+        printf("%u idle connections on %u listener(s), accepted in %.1f ms\n", server.Count(), server.Listeners(), static_cast<double>(Elapsed(start)) / 1000);
+
+        Server::Iterator index(server.Clients());
+        while (index.Next() == true) {
+            ids.push_back(index.Client()->Id());
+            reference.insert(std::pair<uint32_t, Core::ProxyType<Idle>>(ids.back(), index.Client()));
+        }
+
+        // Visit the ids in a random order, as the jobs of the channels do.
+        std::vector<uint32_t> order(Lookups);
+        for (uint32_t& entry : order) {
+            entry = ids[static_cast<uint32_t>(::rand()) % ids.size()];
+        }
+
+        start = Core::Time::Now().Ticks();
+        for (const uint32_t id : order) {
+            lock.Lock();
+            Reference::const_iterator entry(reference.find(id));
+            Core::ProxyType<Idle> client(entry != reference.end() ? entry->second : Core::ProxyType<Idle>());
+            lock.Unlock();
+
+            found += (client.IsValid() ? 1 : 0);
+        }
+        Report(_T("map lookup"), Lookups, Elapsed(start));
+
+        start = Core::Time::Now().Ticks();
+        for (const uint32_t id : order) {
+            found += (server.Client(id).IsValid() ? 1 : 0);
+        }
+        Report(_T("slot lookup"), Lookups, Elapsed(start));
+
+        start = Core::Time::Now().Ticks();
+        for (uint16_t count = 0; count < Cleanups; count++) {
+            lock.Lock();
+            for (const std::pair<const uint32_t, Core::ProxyType<Idle>>& entry : reference) {
+                found += (entry.second->IsClosed() ? 1 : 0);
+            }
+            lock.Unlock();
+        }
+        Report(_T("map scan, idle"), Cleanups, Elapsed(start));
+
+        start = Core::Time::Now().Ticks();
+        for (uint16_t count = 0; count < Cleanups; count++) {
+            server.Cleanup();
+        }
+        Report(_T("cleanup, idle"), Cleanups, Elapsed(start));
+
+        reference.clear();
+
+        // A tenth of the clients goes away, they are handed back as they close.
+        const uint32_t closing = static_cast<uint32_t>(sockets.size() / 10);
+        const uint32_t remaining = server.Count() - closing;
+
+        for (uint32_t count = 0; count < closing; count++) {
+            ::close(sockets.back());
+            sockets.pop_back();
+        }
+
+        uint16_t retries = 1000;
+        uint32_t cleanups = 0;
+        start = Core::Time::Now().Ticks();
+        while ((server.Count() != remaining) && (--retries != 0)) {
+            SleepMs(1);
+            server.Cleanup();
+            cleanups++;
+        }
+        printf("%-24s %8u closed %10.1f ms in %u cleanups\n", _T("cleanup, closing"), closing, static_cast<double>(Elapsed(start)) / 1000, cleanups);
+
+        for (const SOCKET socket : sockets) {
+            ::close(socket);
+        }
+
+        server.Close(Core::infinite);
+
+        // Keep the optimizer from dropping the loops.
+        if (found == 0) {
+            printf("\n");
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    uint32_t connections = 10000;
+    uint8_t listeners = 1;
+    struct rlimit limit;
+
+    if (argc >= 2) {
+        connections = Core::NumberType<uint32_t>(Core::TextFragment(argv[1])).Value();
+    }
+    if (argc >= 3) {
+        listeners = Core::NumberType<uint8_t>(Core::TextFragment(argv[2])).Value();
+    }
+
+    // Both ends of every connection live in this process.
+    if ((::getrlimit(RLIMIT_NOFILE, &limit) == 0) && (limit.rlim_cur < ((2 * connections) + 64))) {
+        limit.rlim_cur = std::min(static_cast<rlim_t>((2 * connections) + 64), limit.rlim_max);
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    if ((::getrlimit(RLIMIT_NOFILE, &limit) == 0) && (limit.rlim_cur < ((2 * connections) + 64))) {
+        connections = static_cast<uint32_t>((limit.rlim_cur - 64) / 2);
+        printf("Limited to %u connections by the number of open files\n", connections);
+    }
+
+    Measure(connections, listeners);
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -0,0 +1,118 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <messaging/messaging.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    enum class Level : uint8_t {
+        LOW = 1,
+        HIGH = 7
+    };
+
+    template <typename... ARGS>
+    static string Received(const char format[], const ARGS&... args)
+    {
+        uint8_t buffer[Messaging::DeferredMessage::MaxLength];
+        Messaging::DeferredMessageType<ARGS...> sent(format, args...);
+        Messaging::TextMessage received;
+
+        const uint16_t length = sent.Serialize(buffer, sizeof(buffer));
+        EXPECT_EQ(received.Deserialize(buffer, length), length);
+        EXPECT_STREQ(received.Data().c_str(), sent.Data().c_str());
+
+        return (received.Data());
+    }
+
+    TEST(Messaging_DeferredMessage, Formatting)
+    {
+        const string name(_T("Controller"));
+        const char text[] = _T("text");
+        const uint64_t big = 0xFFFFFFFFFFFFFFFFull;
+
+        EXPECT_STREQ(Received(_T("%d %i %u %ld %" PRIu64), -12, 34, 56u, -78l, big).c_str(),
+            Core::Format(_T("%d %i %u %ld %" PRIu64), -12, 34, 56u, -78l, big).c_str());
+        EXPECT_STREQ(Received(_T("[%5s|%-6s|%.2s]"), name, text, _T("abc")).c_str(), _T("[Controller|text  |ab]"));
+        EXPECT_STREQ(Received(_T("%08.3f %e %g"), 3.14159, 1.5f, 0.25).c_str(),
+            Core::Format(_T("%08.3f %e %g"), 3.14159, 1.5f, 0.25).c_str());
+        EXPECT_STREQ(Received(_T("%x %X %#o %c %hhu"), 255, 0xABCDu, 8, 'Z', static_cast<uint8_t>(200)).c_str(), _T("ff ABCD 010 Z 200"));
+        EXPECT_STREQ(Received(_T("%d%% %*d|%-*d|"), 100, 4, 7, 3, 8).c_str(), _T("100%    7|8  |"));
+        EXPECT_STREQ(Received(_T("level %d %s"), Level::HIGH, static_cast<const char*>(_T("set"))).c_str(), _T("level 7 set"));
+        EXPECT_STREQ(Received(_T("%s"), static_cast<const char*>(nullptr)).c_str(), _T("(null)"));
+
+        const void* pointer = &name;
+        EXPECT_STREQ(Received(_T("%p"), pointer).c_str(), Core::Format(_T("%p"), pointer).c_str());
+    }
+
+    TEST(Messaging_DeferredMessage, Truncated)
+    {
+        uint8_t buffer[24];
+        const int first = 1;
+        const int last = 2;
+        const string longText(200, 'x');
+        Messaging::DeferredMessageType<int, string, int> sent(_T("%d %s %d"), first, longText, last);
+        Messaging::TextMessage received;
+
+        const uint16_t length = sent.Serialize(buffer, sizeof(buffer));
+        EXPECT_EQ(length, sizeof(buffer));
+        EXPECT_EQ(received.Deserialize(buffer, length), length);
+
+        // The text is cut and the arguments that did not fit are left out.
+        EXPECT_STREQ(received.Data().c_str(), _T("1 xx "));
+    }
+
+    TEST(Messaging_DeferredMessage, PlainTextIsUntouched)
+    {
+        uint8_t buffer[64];
+        Messaging::TextMessage sent(_T("100% plain"));
+        Messaging::TextMessage received;
+
+        const uint16_t length = sent.Serialize(buffer, sizeof(buffer));
+        EXPECT_EQ(received.Deserialize(buffer, length), length);
+        EXPECT_STREQ(received.Data().c_str(), _T("100% plain"));
+
+        Messaging::TextMessage empty;
+        EXPECT_EQ(empty.Deserialize(reinterpret_cast<const uint8_t*>(""), 1), 1u);
+        EXPECT_TRUE(empty.Data().empty());
+    }
+
+    TEST(Messaging_DeferredMessage, Deferrable)
+    {
+        EXPECT_TRUE(Messaging::IsDeferredCategory<Trace::Information>::value);
+        EXPECT_FALSE(Messaging::IsDeferredCategory<Trace::Duration>::value);
+        EXPECT_TRUE((Messaging::IsDeferredArguments<int, const char (&)[4], string&, Level, double, void*>::value));
+        EXPECT_FALSE((Messaging::IsDeferredArguments<int, Core::Time>::value));
+
+        // A lone text is never formatted, so it is never deferred.
+        EXPECT_FALSE((Messaging::IsDeferrable<Trace::Information, const char (&)[4]>::value));
+
+#ifdef __MESSAGING_BINARY_TRACING__
+        EXPECT_TRUE((Messaging::IsDeferrable<Trace::Information, const char (&)[4], int>::value));
+#else
+        EXPECT_FALSE((Messaging::IsDeferrable<Trace::Information, const char (&)[4], int>::value));
+#endif
+        EXPECT_FALSE((Messaging::IsDeferrable<Trace::Duration, Core::Time&, const char (&)[4], int>::value));
+    }
+
+} // Tests
+} // WPEFramework
@@ -199,6 +199,49 @@ namespace Tests {
         }
     };
 
+    class HandleTextTextDeferred : public Core::IIPCServer {
+    public:
+        static constexpr uint8_t Calls = 4;
+
+        HandleTextTextDeferred(const HandleTextTextDeferred&) = delete;
+        HandleTextTextDeferred& operator=(const HandleTextTextDeferred&) = delete;
+
+        HandleTextTextDeferred()
+            : _lock()
+            , _pending()
+        {
+        }
+
+        virtual ~HandleTextTextDeferred()
+        {
+        }
+
+    public:
+        // Only answers once all calls are in, in reverse order.
+        virtual void Procedure(Core::IPCChannel& source, Core::ProxyType<Core::IIPC>& data)
+        {
+            _lock.Lock();
+
+            _pending.push_back(data);
+
+            if (_pending.size() == Calls) {
+                while (_pending.empty() == false) {
+                    Core::ProxyType<TextText> message(_pending.back());
+
+                    message->Response() = message->Parameters();
+                    source.ReportResponse(_pending.back());
+                    _pending.pop_back();
+                }
+            }
+
+            _lock.Unlock();
+        }
+
+    private:
+        Core::CriticalSection _lock;
+        std::vector<Core::ProxyType<Core::IIPC>> _pending;
+    };
+
     TEST(DISABLED_Core_IPC, ContinuousChannel)
     {
         std::string connector = _T("/tmp/testserver0");
@@ -406,6 +449,180 @@ namespace Tests {
         }
     }
 
+    TEST(Core_IPC, MultiplexedChannel)
+    {
+        std::string connector = _T("/tmp/testserver6");
+        auto lambdaFunc = [connector](IPTestAdministrator & testAdmin) {
+            Core::NodeId multiplexedNode(connector.c_str());
+            uint32_t error;
+
+            testAdmin.Sync("setup server");
+
+            Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> > factory(Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> >::Create());
+
+            factory->CreateFactory<TextText>(HandleTextTextDeferred::Calls);
+
+            Core::IPCChannelClientType<Core::Void, false, false> multiplexedChannel(multiplexedNode, 512, factory);
+
+            multiplexedChannel.Multiplexed(true);
+
+            error = multiplexedChannel.Source().Open(1000); // Wait for 1 Second.
+            EXPECT_EQ(error, Core::ERROR_NONE);
+
+            // The server only answers once all calls arrived, so they all need to be in flight at once.
+            std::vector<std::thread> callers;
+            std::atomic<uint8_t> succeeded(0);
+
+            for (uint8_t index = 0; index < HandleTextTextDeferred::Calls; index++) {
+                callers.emplace_back([&multiplexedChannel, &succeeded, index]() {
+                    string text = _T("call ") + Core::NumberType<uint8_t>(index).Text();
+                    Core::ProxyType<TextText> textTextData(Core::ProxyType<TextText>::Create(Core::IPC::Text<2048>(text)));
+
+                    if ((multiplexedChannel.Invoke(textTextData, 5000) == Core::ERROR_NONE) && (text == textTextData->Response().Value())) {
+                        succeeded++;
+                    }
+                });
+            }
+
+            for (std::thread& caller : callers) {
+                caller.join();
+            }
+
+            EXPECT_EQ(succeeded.load(), static_cast<uint8_t>(HandleTextTextDeferred::Calls));
+
+            // A plain call completing on the same channel leaves the tagged calls in flight alone.
+            callers.clear();
+            succeeded = 0;
+
+            for (uint8_t index = 1; index < HandleTextTextDeferred::Calls; index++) {
+                callers.emplace_back([&multiplexedChannel, &succeeded, index]() {
+                    string text = _T("tagged ") + Core::NumberType<uint8_t>(index).Text();
+                    Core::ProxyType<TextText> textTextData(Core::ProxyType<TextText>::Create(Core::IPC::Text<2048>(text)));
+
+                    if ((multiplexedChannel.Invoke(textTextData, 5000) == Core::ERROR_NONE) && (text == textTextData->Response().Value())) {
+                        succeeded++;
+                    }
+                });
+            }
+
+            SleepMs(200);
+            multiplexedChannel.Multiplexed(false);
+
+            string text = _T("plain");
+            Core::ProxyType<TextText> textTextData(Core::ProxyType<TextText>::Create(Core::IPC::Text<2048>(text)));
+
+            EXPECT_EQ(multiplexedChannel.Invoke(textTextData, 5000), Core::ERROR_NONE);
+            EXPECT_EQ(text, textTextData->Response().Value());
+
+            for (std::thread& caller : callers) {
+                caller.join();
+            }
+
+            EXPECT_EQ(succeeded.load(), static_cast<uint8_t>(HandleTextTextDeferred::Calls - 1));
+
+            error = multiplexedChannel.Source().Close(1000); // Wait for 1 second
+            EXPECT_EQ(error, Core::ERROR_NONE);
+
+            factory->DestroyFactories();
+
+            Core::Singleton::Dispose();
+
+            testAdmin.Sync("done testing");
+        };
+
+        static std::function<void (IPTestAdministrator&)> lambdaVar = lambdaFunc;
+
+        IPTestAdministrator::OtherSideMain otherSide = [](IPTestAdministrator& testAdmin ) { lambdaVar(testAdmin); };
+
+        IPTestAdministrator testAdmin(otherSide);
+        {
+            Core::NodeId multiplexedNode(connector.c_str());
+            uint32_t error;
+
+            Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> > factory(Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> >::Create());
+
+            factory->CreateFactory<TextText>(HandleTextTextDeferred::Calls);
+
+            Core::IPCChannelClientType<Core::Void, true, false> multiplexedChannel(multiplexedNode, 512, factory);
+
+            Core::ProxyType<Core::IIPCServer> handler(Core::ProxyType<HandleTextTextDeferred>::Create());
+
+            multiplexedChannel.Register(TextText::Id(), handler);
+
+            error = multiplexedChannel.Source().Open(1000); // Wait for 1 Second.
+            EXPECT_EQ(error, Core::ERROR_NONE);
+
+            testAdmin.Sync("setup server");
+            testAdmin.Sync("done testing");
+
+            error = multiplexedChannel.Source().Close(1000); // Wait for 1 second
+            EXPECT_EQ(error, Core::ERROR_NONE);
+
+            multiplexedChannel.Unregister(TextText::Id());
+
+            factory->DestroyFactories();
+
+            Core::Singleton::Dispose();
+        }
+    }
+
+    TEST(Core_IPC, MultiplexedMismatchedResponse)
+    {
+        class Completion : public Core::IDispatchType<Core::IIPC> {
+        public:
+            Completion(const Completion&) = delete;
+            Completion& operator=(const Completion&) = delete;
+
+            Completion()
+                : Dispatched(0)
+            {
+            }
+            ~Completion() override = default;
+
+        public:
+            void Dispatch(Core::IIPC&) override
+            {
+                Dispatched++;
+            }
+
+            uint32_t Dispatched;
+        };
+
+        Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> > factory(Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t> >::Create());
+
+        factory->CreateFactory<TextText>(1);
+        factory->CreateFactory<TripletResponse>(1);
+
+        {
+            Core::IPCChannel::IPCFactory administration(factory);
+            Core::ProxyType<TextText> call(Core::ProxyType<TextText>::Create(Core::IPC::Text<2048>(_T("call"))));
+            Completion completion;
+            bool failed = false;
+            uint32_t tag = 0;
+
+            const uint32_t tagged = administration.SetPending(Core::ProxyType<Core::IIPC>(call), &completion, tag, &failed)->Label() ^ (TextText::Id() << 1);
+
+            // The tag of the call, but the response of another method.
+            Core::ProxyType<Core::IMessage> reply(administration.Element(tagged | (TripletResponse::Id() << 1) | 0x01));
+            ASSERT_TRUE(reply.IsValid());
+
+            const uint8_t frame[] = { static_cast<uint8_t>(tag), static_cast<uint8_t>(tag >> 8), static_cast<uint8_t>(tag >> 16), static_cast<uint8_t>(tag >> 24) };
+            EXPECT_EQ(reply->Deserialize(frame, sizeof(frame), 0), sizeof(frame));
+
+            Core::ProxyType<Core::IIPC> inbound;
+            EXPECT_FALSE(administration.ReceivedMessage(reply, inbound).IsValid());
+
+            // The call is completed as failed and nothing is left waiting for its tag.
+            EXPECT_TRUE(failed);
+            EXPECT_EQ(completion.Dispatched, 1u);
+            EXPECT_FALSE(administration.AbortPending(tag));
+        }
+
+        factory->DestroyFactories();
+
+        Core::Singleton::Dispose();
+    }
+
     TEST(DISABLED_Core_IPC, FlashChannel)
     {
         std::string connector = _T("/tmp/testserver2");
@@ -0,0 +1,141 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <com/com.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Stands in for a proxy, every call on it would be a round trip.
+    class CountingIterator : public RPC::ValueIterator {
+    public:
+        CountingIterator() = delete;
+        CountingIterator(const CountingIterator&) = delete;
+        CountingIterator& operator=(const CountingIterator&) = delete;
+
+        CountingIterator(const std::list<uint32_t>& values, const bool batched)
+            : RPC::ValueIterator(values)
+            , _batched(batched)
+            , _calls(0)
+        {
+        }
+        ~CountingIterator() = default;
+
+    public:
+        uint32_t Calls() const
+        {
+            return (_calls);
+        }
+        void* QueryInterface(const uint32_t id) override
+        {
+            // Like a proxy of an iterator that does not offer the batches.
+            return ((id == RPC::IValueBatchIterator::ID) && (_batched == false) ? nullptr : RPC::ValueIterator::QueryInterface(id));
+        }
+        bool Next(uint32_t& result) override
+        {
+            _calls++;
+            return (RPC::ValueIterator::Next(result));
+        }
+        uint16_t Next(const uint16_t count, uint32_t elements[]) override
+        {
+            _calls++;
+            return (RPC::ValueIterator::Next(count, elements));
+        }
+
+    private:
+        const bool _batched;
+        uint32_t _calls;
+    };
+
+    static std::list<uint32_t> Values(const uint32_t count)
+    {
+        std::list<uint32_t> values;
+
+        for (uint32_t index = 0; index < count; index++) {
+            values.push_back(index * 3);
+        }
+
+        return (values);
+    }
+
+    TEST(Core_RPCIterator, BatchedNext)
+    {
+        RPC::IValueIterator* iterator = Core::ServiceType<RPC::ValueIterator>::Create<RPC::IValueIterator>(Values(10));
+        RPC::IValueBatchIterator* batch = iterator->QueryInterface<RPC::IValueBatchIterator>();
+        uint32_t elements[4];
+
+        ASSERT_NE(batch, nullptr);
+
+        EXPECT_EQ(batch->Next(4, elements), 4u);
+        EXPECT_EQ(elements[0], 0u);
+        EXPECT_EQ(elements[3], 9u);
+        EXPECT_EQ(iterator->Current(), 9u);
+        EXPECT_EQ(batch->Next(4, elements), 4u);
+        EXPECT_EQ(elements[0], 12u);
+        EXPECT_EQ(batch->Next(4, elements), 2u);
+        EXPECT_EQ(elements[1], 27u);
+        EXPECT_FALSE(iterator->IsValid());
+        EXPECT_EQ(batch->Next(4, elements), 0u);
+
+        batch->Release();
+        iterator->Release();
+    }
+
+    TEST(Core_RPCIterator, CopyInBatches)
+    {
+        Core::ProxyType<CountingIterator> remote(Core::ProxyType<CountingIterator>::Create(Values(100), true));
+        RPC::IValueIterator* copy = Core::ServiceType<RPC::ValueIterator>::Create<RPC::IValueIterator>(static_cast<RPC::IValueIterator*>(&(*remote)));
+
+        EXPECT_EQ(copy->Count(), 100u);
+        EXPECT_EQ(remote->Calls(), 4u);
+
+        uint32_t value;
+        uint32_t index = 0;
+        while (copy->Next(value) == true) {
+            EXPECT_EQ(value, index * 3);
+            index++;
+        }
+        EXPECT_EQ(index, 100u);
+
+        copy->Release();
+    }
+
+    TEST(Core_RPCIterator, CopyWithoutBatches)
+    {
+        Core::ProxyType<CountingIterator> remote(Core::ProxyType<CountingIterator>::Create(Values(100), false));
+        RPC::IValueIterator* copy = Core::ServiceType<RPC::ValueIterator>::Create<RPC::IValueIterator>(static_cast<RPC::IValueIterator*>(&(*remote)));
+
+        // The iterator does not offer the batches, so it is walked one element at a time.
+        EXPECT_EQ(copy->Count(), 100u);
+        EXPECT_EQ(remote->Calls(), 101u);
+
+        uint32_t value;
+        EXPECT_TRUE(copy->Next(value));
+        EXPECT_EQ(value, 0u);
+
+        copy->Release();
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,150 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class WideContainer : public Core::JSON::Container {
+    public:
+        static constexpr uint8_t Members = 32;
+
+        WideContainer(const WideContainer&) = delete;
+        WideContainer& operator=(const WideContainer&) = delete;
+
+        WideContainer()
+            : Core::JSON::Container()
+            , _labels()
+            , _values()
+        {
+            for (uint8_t index = 0; index < Members; index++) {
+                _labels[index] = _T("member") + Core::NumberType<uint8_t>(index).Text();
+                Add(_labels[index].c_str(), &(_values[index]));
+            }
+        }
+        ~WideContainer() override = default;
+
+    public:
+        Core::JSON::DecUInt32& Value(const uint8_t index)
+        {
+            return (_values[index]);
+        }
+        const string& Label(const uint8_t index) const
+        {
+            return (_labels[index]);
+        }
+
+    private:
+        string _labels[Members];
+        Core::JSON::DecUInt32 _values[Members];
+    };
+
+    TEST(Core_JSONContainer, IndexedLookup)
+    {
+        WideContainer container;
+        string input(_T("{\"member31\":31,\"unknown\":\"skip\",\"member7\":7,\"member0\":0,\"member20\":20}"));
+
+        EXPECT_TRUE(container.FromString(input));
+
+        EXPECT_EQ(container.Value(31).Value(), 31u);
+        EXPECT_EQ(container.Value(7).Value(), 7u);
+        EXPECT_EQ(container.Value(0).Value(), 0u);
+        EXPECT_EQ(container.Value(20).Value(), 20u);
+        EXPECT_FALSE(container.Value(1).IsSet());
+
+        // Serialization keeps the order in which the members were added.
+        string output;
+        EXPECT_TRUE(container.ToString(output));
+        EXPECT_STREQ(output.c_str(), _T("{\"member0\":0,\"member7\":7,\"member20\":20,\"member31\":31}"));
+    }
+
+    TEST(Core_JSONContainer, IndexedLookupAfterAddAndRemove)
+    {
+        static const TCHAR extraLabel[] = _T("extra");
+
+        WideContainer container;
+        Core::JSON::DecUInt32 extra;
+
+        // Build the index first, then change the members.
+        EXPECT_TRUE(container.FromString(_T("{\"member1\":1}")));
+
+        container.Remove(container.Label(5).c_str());
+        container.Add(extraLabel, &extra);
+
+        container.Clear();
+        EXPECT_TRUE(container.FromString(_T("{\"member5\":5,\"extra\":42,\"member6\":6}")));
+
+        EXPECT_FALSE(container.Value(5).IsSet());
+        EXPECT_EQ(extra.Value(), 42u);
+        EXPECT_EQ(container.Value(6).Value(), 6u);
+
+        container.Remove(extraLabel);
+    }
+
+    TEST(Core_JSONArray, StableElements)
+    {
+        Core::JSON::ArrayType<Core::JSON::DecUInt32> array;
+
+        Core::JSON::DecUInt32& first(array.Add());
+        first = 1;
+
+        // Elements do not move when the array grows.
+        for (uint32_t index = 2; index <= 5000; index++) {
+            array.Add() = index;
+        }
+
+        EXPECT_EQ(&first, &(array[0]));
+        EXPECT_EQ(array.Length(), 5000u);
+        EXPECT_EQ(array[4999].Value(), 5000u);
+
+        uint32_t expected = 1;
+        Core::JSON::ArrayType<Core::JSON::DecUInt32>::Iterator index(array.Elements());
+        while (index.Next() == true) {
+            EXPECT_EQ(index.Current().Value(), expected);
+            expected++;
+        }
+        EXPECT_EQ(expected, 5001u);
+
+        Core::JSON::ArrayType<Core::JSON::DecUInt32> copy(array);
+        EXPECT_EQ(copy.Length(), 5000u);
+        EXPECT_EQ(copy[1234].Value(), 1235u);
+
+        Core::JSON::ArrayType<Core::JSON::DecUInt32> moved(std::move(copy));
+        EXPECT_EQ(moved.Length(), 5000u);
+        EXPECT_EQ(moved[4999].Value(), 5000u);
+        EXPECT_EQ(moved.Elements().Count(), 5000u);
+
+        array.Clear();
+        array.Reserve(16);
+        EXPECT_EQ(array.Length(), 0u);
+        EXPECT_TRUE(array.FromString(_T("[3,4,5]")));
+        EXPECT_EQ(array.Length(), 3u);
+        EXPECT_EQ(array[2].Value(), 5u);
+
+        string text;
+        EXPECT_TRUE(array.ToString(text));
+        EXPECT_STREQ(text.c_str(), _T("[3,4,5]"));
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,180 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Feeds the text in small chunks, like it arrives on a socket.
+    static bool Receive(Web::JSONRPC::Body& body, const string& text, const uint16_t chunk)
+    {
+        Core::OptionalType<Core::JSON::Error> error;
+        uint32_t offset = 0;
+        uint32_t handled = 0;
+
+        body.Clear();
+
+        while ((handled < text.length()) && (error.IsSet() == false)) {
+            const uint16_t size = static_cast<uint16_t>(std::min(static_cast<uint32_t>(chunk), static_cast<uint32_t>(text.length() - handled)));
+            handled += static_cast<Core::JSON::IElement&>(body).Deserialize(&(text[handled]), size, offset, error);
+        }
+
+        return ((error.IsSet() == false) && (offset == 0));
+    }
+
+    TEST(Web_JSONRPCBatch, Single)
+    {
+        Web::JSONRPC::Body body;
+
+        EXPECT_TRUE(Receive(body, _T("  {\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"Controller.1.status\"}"), 5));
+        EXPECT_FALSE(body.IsBatch());
+        EXPECT_EQ(body.Id.Value(), 3u);
+        EXPECT_STREQ(body.Designator.Value().c_str(), _T("Controller.1.status"));
+    }
+
+    TEST(Web_JSONRPCBatch, Batch)
+    {
+        Web::JSONRPC::Body body;
+
+        EXPECT_TRUE(Receive(body, _T(" \n[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"Controller.1.status\"},")
+                                  _T("{\"jsonrpc\":\"2.0\",\"method\":\"Controller.1.harakiri\"},")
+                                  _T("{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"DeviceInfo.1.systeminfo\",\"params\":{\"a\":[1,2]}}]"), 7));
+        EXPECT_TRUE(body.IsBatch());
+        ASSERT_EQ(body.Batch().Length(), 3u);
+        EXPECT_EQ(body.Batch()[0].Id.Value(), 1u);
+        EXPECT_FALSE(body.Batch()[1].Id.IsSet());
+        EXPECT_STREQ(body.Batch()[2].Designator.Value().c_str(), _T("DeviceInfo.1.systeminfo"));
+        EXPECT_STREQ(body.Batch()[2].Parameters.Value().c_str(), _T("{\"a\":[1,2]}"));
+
+        // The responses replace the calls and go back as one array.
+        Web::JSONRPC::Body::Calls answers;
+        Core::JSONRPC::Message& first(answers.Add());
+        first.Id = 1;
+        first.Result = _T("true");
+        Core::JSONRPC::Message& second(answers.Add());
+        second.Id = 2;
+        second.Error.SetError(Core::ERROR_UNKNOWN_METHOD);
+        body.Batch() = std::move(answers);
+
+        string text;
+        body.ToString(text);
+        EXPECT_STREQ(text.c_str(), _T("[{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":true},{\"jsonrpc\":\"2.0\",\"id\":2,\"error\":{\"code\":-32601,\"message\":\"Unknown method.\"}}]"));
+
+        // Reused from the pool, the next message is a single one again.
+        EXPECT_TRUE(Receive(body, _T("{\"jsonrpc\":\"2.0\",\"id\":4,\"method\":\"Controller.1.links\"}"), 64));
+        EXPECT_FALSE(body.IsBatch());
+        EXPECT_EQ(body.Id.Value(), 4u);
+    }
+
+    TEST(Web_JSONRPCBatch, Malformed)
+    {
+        Web::JSONRPC::Body body;
+
+        EXPECT_FALSE(Receive(body, _T("[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"a.1.b\"} {\"id\":2}]"), 64));
+        EXPECT_TRUE(body.IsBatch());
+
+        body.Single();
+        EXPECT_FALSE(body.IsBatch());
+        EXPECT_EQ(body.Batch().Length(), 0u);
+    }
+
+    namespace {
+
+        class Point : public Core::JSON::Container {
+        public:
+            Point(const Point&) = delete;
+            Point& operator=(const Point&) = delete;
+
+            Point()
+                : Core::JSON::Container()
+                , X(0)
+                , Y(0)
+            {
+                Add(_T("x"), &X);
+                Add(_T("y"), &Y);
+            }
+            ~Point() override = default;
+
+        public:
+            Core::JSON::DecSInt32 X;
+            Core::JSON::DecSInt32 Y;
+        };
+
+    }
+
+    TEST(Core_JSONRPC, TypedResult)
+    {
+        Core::JSONRPC::Handler handler({ 1 });
+
+        handler.Register<Point, Point>(_T("mirror"), [](const Point& in, Point& out) -> uint32_t {
+            out.X = -in.X.Value();
+            out.Y = -in.Y.Value();
+            return (Core::ERROR_NONE);
+        });
+        handler.Register<void, Point>(_T("origin"), [](Point&) -> uint32_t {
+            return (Core::ERROR_NONE);
+        });
+
+        // Without a slot for the result object, it comes back as text.
+        string response;
+        Core::JSONRPC::Context plain(1, 1, _T(""));
+        EXPECT_EQ(handler.Invoke(plain, _T("mirror"), _T("{\"x\":3,\"y\":-4}"), response), Core::ERROR_NONE);
+        EXPECT_STREQ(response.c_str(), _T("{\"x\":-3,\"y\":4}"));
+
+        // With one, the object is handed over and goes straight into the message.
+        Core::ProxyType<const Core::JSON::IElement> object;
+        Core::JSONRPC::Context typed(1, 2, _T(""), object);
+        response.clear();
+        EXPECT_EQ(handler.Invoke(typed, _T("mirror"), _T("{\"x\":3,\"y\":-4}"), response), Core::ERROR_NONE);
+        ASSERT_TRUE(object.IsValid());
+        EXPECT_TRUE(response.empty());
+
+        Core::JSONRPC::Message message;
+        message.Id = 2;
+        message.Result.Object(object);
+        EXPECT_TRUE(message.Result.IsSet());
+        EXPECT_STREQ(message.Result.Value().c_str(), _T("{\"x\":-3,\"y\":4}"));
+
+        string text;
+        message.ToString(text);
+        EXPECT_STREQ(text.c_str(), _T("{\"jsonrpc\":\"2.0\",\"id\":2,\"result\":{\"x\":-3,\"y\":4}}"));
+
+        // Copies of a context do not carry the slot, so nothing can be returned through them.
+        Core::JSONRPC::Context copy(typed);
+        EXPECT_TRUE(typed.HasResult());
+        EXPECT_FALSE(copy.HasResult());
+
+        // An object that is not set is returned as text, like it always was.
+        object.Release();
+        EXPECT_EQ(handler.Invoke(typed, _T("origin"), _T(""), response), Core::ERROR_NONE);
+        EXPECT_FALSE(object.IsValid());
+
+        message.Result = _T("true");
+        message.ToString(text);
+        EXPECT_STREQ(text.c_str(), _T("{\"jsonrpc\":\"2.0\",\"id\":2,\"result\":true}"));
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,113 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Writes the string out in chunks, like it is done into a socket buffer.
+    static string Serialize(const Core::JSON::String& element, const uint16_t chunk)
+    {
+        std::vector<char> buffer(chunk);
+        string result;
+        uint32_t offset = 0;
+
+        do {
+            const uint16_t loaded = element.Serialize(buffer.data(), chunk, offset);
+            result.append(buffer.data(), loaded);
+        } while (offset != 0);
+
+        return (result);
+    }
+
+    // Reads the string in chunks, like it arrives from a socket buffer.
+    static bool Deserialize(Core::JSON::String& element, const string& text, const uint16_t chunk)
+    {
+        Core::OptionalType<Core::JSON::Error> error;
+        uint32_t offset = 0;
+        uint32_t index = 0;
+
+        do {
+            const uint16_t length = static_cast<uint16_t>(std::min(static_cast<size_t>(chunk), text.length() - index));
+            index += element.Deserialize(&(text[index]), length, offset, error);
+        } while ((offset != 0) && (index < text.length()) && (error.IsSet() == false));
+
+        return ((error.IsSet() == false) && (offset == 0));
+    }
+
+    TEST(Core_JSONString, Escaping)
+    {
+        const string plain(_T("The quick brown fox jumps over the lazy dog, again and again and again."));
+        const string blob(1000, 'A');
+
+        const std::pair<string, string> samples[] = {
+            { plain, _T("\"") + plain + _T("\"") },
+            { blob + _T("\"") + blob, _T("\"") + blob + _T("\\\"") + blob + _T("\"") },
+            { _T("http://www.example.com/path/to/resource?query=1"), _T("\"http:\\/\\/www.example.com\\/path\\/to\\/resource?query=1\"") },
+            { _T("0123456789abcdef0123456789abcdef\\0123456789abcdef\t0123456789abcdef\n"),
+              _T("\"0123456789abcdef0123456789abcdef\\\\0123456789abcdef\\t0123456789abcdef\\n\"") },
+            { _T("0123456789abcdef0123456789abcdef\x01"), _T("\"0123456789abcdef0123456789abcdef\\u0001\"") },
+            { _T("0123456789abcdef0123456789abcdef\xC3\xA9"), _T("\"0123456789abcdef0123456789abcdef\\u00E9\"") },
+            { _T("0123456789abcdef0123456789abcde\x7F"), _T("\"0123456789abcdef0123456789abcde\\u007F\"") }
+        };
+
+        for (const std::pair<string, string>& sample : samples) {
+            Core::JSON::String element;
+            element = sample.first;
+
+            for (const uint16_t chunk : { 1, 3, 16, 17, 31, 64, 4096 }) {
+                EXPECT_STREQ(Serialize(element, chunk).c_str(), sample.second.c_str()) << "chunk " << chunk;
+
+                Core::JSON::String result;
+                EXPECT_TRUE(Deserialize(result, sample.second, chunk)) << "chunk " << chunk;
+                EXPECT_STREQ(result.Value().c_str(), sample.first.c_str()) << "chunk " << chunk;
+            }
+        }
+    }
+
+    TEST(Core_JSONString, Unescaping)
+    {
+        const string filler(_T("0123456789abcdef0123456789abcdef"));
+
+        for (const uint16_t chunk : { 1, 5, 16, 33, 4096 }) {
+            Core::JSON::String element;
+
+            // Control characters must be escaped, also when they are far in.
+            EXPECT_FALSE(Deserialize(element, _T("\"") + filler + filler + _T("\x1F\""), chunk));
+
+            EXPECT_TRUE(Deserialize(element, _T("\"") + filler + _T("\\u00e9\\/") + filler + _T("\\\"\""), chunk));
+            EXPECT_STREQ(element.Value().c_str(), (filler + _T("\xC3\xA9/") + filler + _T("\"")).c_str());
+
+            // Characters from 0x80 on are taken as they are.
+            EXPECT_TRUE(Deserialize(element, _T("\"") + filler + _T("\xE2\x82\xAC") + filler + _T("\""), chunk));
+            EXPECT_STREQ(element.Value().c_str(), (filler + _T("\xE2\x82\xAC") + filler).c_str());
+
+            // Quoted areas in an opaque object are kept as they are, brackets and spaces included.
+            EXPECT_TRUE(Deserialize(element, _T("{\"key\": \"") + filler + _T(" [ } ") + filler + _T("\", \"other\": [1, 2]}"), chunk));
+            EXPECT_STREQ(element.Value().c_str(), (_T("{\"key\":\"") + filler + _T(" [ } ") + filler + _T("\",\"other\":[1,2]}")).c_str());
+        }
+    }
+
+} // Tests
+} // WPEFramework
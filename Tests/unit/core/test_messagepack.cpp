@@ -0,0 +1,133 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static string RoundTrip(const string& text)
+    {
+        std::vector<uint8_t> packed;
+        string result;
+
+        EXPECT_TRUE(Core::JSON::IMessagePack::FromText(text, packed));
+        EXPECT_EQ(Core::JSON::IMessagePack::Length(packed.data(), static_cast<uint32_t>(packed.size())), packed.size());
+        EXPECT_TRUE(Core::JSON::IMessagePack::ToText(packed.data(), static_cast<uint32_t>(packed.size()), result));
+
+        return (result);
+    }
+
+    TEST(Core_MessagePack, Transcode)
+    {
+        std::vector<uint8_t> packed;
+
+        EXPECT_TRUE(Core::JSON::IMessagePack::FromText(_T("{\"a\":1,\"b\":[true,null,-1]}"), packed));
+        const uint8_t expected[] = { 0x82, 0xA1, 'a', 0x01, 0xA1, 'b', 0x93, 0xC3, 0xC0, 0xFF };
+        ASSERT_EQ(packed.size(), sizeof(expected));
+        EXPECT_EQ(::memcmp(packed.data(), expected, sizeof(expected)), 0);
+
+        EXPECT_STREQ(RoundTrip(_T(" { \"x\" : -200 , \"y\":70000,\"z\":-2147483649, \"big\":18446744073709551615 } ")).c_str(),
+            _T("{\"x\":-200,\"y\":70000,\"z\":-2147483649,\"big\":18446744073709551615}"));
+        EXPECT_STREQ(RoundTrip(_T("[0.5,1e3,-2.25,3.14159]")).c_str(), _T("[0.5,1000,-2.25,3.14159]"));
+        EXPECT_STREQ(RoundTrip(_T("\"t\\\"a\\\\b\\n\\u00e9\\ud83d\\ude00\"")).c_str(), _T("\"t\\\"a\\\\b\\n\xC3\xA9\xF0\x9F\x98\x80\""));
+        EXPECT_STREQ(RoundTrip(_T("{}")).c_str(), _T("{}"));
+
+        // Sizes that no longer fit the fixed headers.
+        string list(_T("["));
+        for (uint8_t index = 0; index < 20; index++) {
+            list += (index == 0 ? _T("") : _T(",")) + Core::NumberType<uint8_t>(index).Text();
+        }
+        list += _T("]");
+        EXPECT_STREQ(RoundTrip(list).c_str(), list.c_str());
+
+        const string text(_T("\"") + string(300, 'x') + _T("\""));
+        EXPECT_STREQ(RoundTrip(text).c_str(), text.c_str());
+
+        EXPECT_FALSE(Core::JSON::IMessagePack::FromText(_T("{\"a\":}"), packed));
+        EXPECT_FALSE(Core::JSON::IMessagePack::FromText(_T("[1,2"), packed));
+        EXPECT_FALSE(Core::JSON::IMessagePack::FromText(_T("tru"), packed));
+    }
+
+    TEST(Core_MessagePack, Length)
+    {
+        const uint8_t complete[] = { 0x92, 0xA2, 'o', 'k', 0xCD, 0x01, 0x00, 0x2A };
+
+        EXPECT_EQ(Core::JSON::IMessagePack::Length(complete, sizeof(complete)), 7u);
+        EXPECT_EQ(Core::JSON::IMessagePack::Length(complete, 5), 0u);
+        EXPECT_EQ(Core::JSON::IMessagePack::Length(complete, 0), 0u);
+
+        const uint8_t invalid[] = { 0x91, 0xC1 };
+        EXPECT_EQ(Core::JSON::IMessagePack::Length(invalid, sizeof(invalid)), static_cast<uint32_t>(~0));
+
+        string text;
+        const uint8_t extension[] = { 0xD4, 0x01, 0x02 };
+        EXPECT_FALSE(Core::JSON::IMessagePack::ToText(extension, sizeof(extension), text));
+    }
+
+    TEST(Core_MessagePack, Message)
+    {
+        Core::JSONRPC::Message sent;
+        sent.Id = 7;
+        sent.Designator = _T("Player.1.position");
+        sent.Parameters = _T("{\"position\":1200,\"speed\":1.5}");
+
+        // Parameters are real MessagePack values on the wire, not text.
+        std::vector<uint8_t> packed;
+        EXPECT_TRUE(static_cast<const Core::JSON::IMessagePack&>(sent).ToBuffer(packed));
+
+        string text;
+        ASSERT_TRUE(Core::JSON::IMessagePack::ToText(packed.data(), static_cast<uint32_t>(packed.size()), text));
+        EXPECT_STREQ(text.c_str(), _T("{\"jsonrpc\":\"2.0\",\"id\":7,\"method\":\"Player.1.position\",\"params\":{\"position\":1200,\"speed\":1.5}}"));
+
+        string json;
+        sent.ToString(json);
+        EXPECT_LT(packed.size(), json.length());
+
+        // Received in small pieces, followed by the next message.
+        Web::JSONRPC::Body received;
+        packed.push_back(0x80);
+        uint32_t offset = 0;
+        uint32_t handled = 0;
+        while (handled < (packed.size() - 1)) {
+            handled += static_cast<Core::JSON::IMessagePack&>(received).Deserialize(&(packed[handled]), std::min(5u, static_cast<uint32_t>(packed.size() - handled)), offset);
+        }
+        EXPECT_EQ(offset, 0u);
+        EXPECT_EQ(handled, packed.size() - 1);
+        EXPECT_EQ(received.Id.Value(), 7u);
+        EXPECT_STREQ(received.Designator.Value().c_str(), _T("Player.1.position"));
+        EXPECT_STREQ(received.Parameters.Value().c_str(), _T("{\"position\":1200,\"speed\":1.5}"));
+
+        // A batch is an array.
+        std::vector<uint8_t> batch;
+        ASSERT_TRUE(Core::JSON::IMessagePack::FromText(_T("[{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"a.1.b\"},{\"jsonrpc\":\"2.0\",\"method\":\"a.1.c\"}]"), batch));
+        offset = 0;
+        EXPECT_EQ(static_cast<Core::JSON::IMessagePack&>(received).Deserialize(batch.data(), static_cast<uint16_t>(batch.size()), offset), batch.size());
+        EXPECT_TRUE(received.IsBatch());
+        EXPECT_EQ(received.Batch().Length(), 2u);
+    }
+
+} // Tests
+} // WPEFramework
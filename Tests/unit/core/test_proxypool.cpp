@@ -0,0 +1,161 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        class Element {
+        public:
+            Element(const Element&) = delete;
+            Element& operator=(const Element&) = delete;
+
+            Element()
+                : _value(0)
+            {
+            }
+            ~Element() = default;
+
+        public:
+            void Clear()
+            {
+                _value = 0;
+            }
+            uint32_t Value() const
+            {
+                return (_value);
+            }
+            void Value(const uint32_t value)
+            {
+                _value = value;
+            }
+
+        private:
+            uint32_t _value;
+        };
+
+        Core::ProxyPoolAdministrator::Metadata Statistics(const Core::ProxyPoolType<Element>& pool)
+        {
+            Core::ProxyPoolAdministrator::Metadata result {};
+
+            pool.Snapshot(result);
+
+            return (result);
+        }
+
+    }
+
+    TEST(Core_ProxyPool, Recycle)
+    {
+        Core::ProxyPoolType<Element> pool(2);
+
+        {
+            Core::ProxyType<Element> first(pool.Element());
+            Core::ProxyType<Element> second(pool.Element());
+            Core::ProxyType<Element> third(pool.Element());
+
+            first->Value(1);
+            second->Value(2);
+            third->Value(3);
+
+            const Core::ProxyPoolAdministrator::Metadata info(Statistics(pool));
+            EXPECT_EQ(info.Created, 3u);
+            EXPECT_EQ(info.Outstanding, 3u);
+            EXPECT_EQ(info.HighWater, 3u);
+            EXPECT_EQ(info.Hits, 2u);
+            EXPECT_EQ(info.Misses, 1u);
+            EXPECT_EQ(pool.QueuedElements(), 0u);
+        }
+
+        EXPECT_EQ(pool.QueuedElements(), 3u);
+
+        // Returned elements are cleared and handed out again, nothing new is created.
+        for (uint8_t round = 0; round < 10; round++) {
+            Core::ProxyType<Element> element(pool.Element());
+            EXPECT_EQ(element->Value(), 0u);
+            element->Value(round + 1);
+        }
+
+        const Core::ProxyPoolAdministrator::Metadata info(Statistics(pool));
+        EXPECT_EQ(info.Created, 3u);
+        EXPECT_EQ(info.Outstanding, 0u);
+        EXPECT_EQ(info.HighWater, 3u);
+        EXPECT_EQ(info.Hits, 12u);
+        EXPECT_EQ(info.Misses, 1u);
+    }
+
+    TEST(Core_ProxyPool, Threads)
+    {
+        static constexpr uint8_t Threads = 6;
+        static constexpr uint16_t Rounds = 5000;
+
+        Core::ProxyPoolType<Element> pool(0);
+        std::atomic<uint32_t> failures(0);
+        std::vector<std::thread> threads;
+
+        for (uint8_t index = 0; index < Threads; index++) {
+            threads.emplace_back([&pool, &failures, index]() {
+                for (uint16_t round = 0; round < Rounds; round++) {
+                    Core::ProxyType<Element> first(pool.Element());
+                    Core::ProxyType<Element> second(pool.Element());
+
+                    if ((first->Value() != 0) || (second->Value() != 0) || (first == second)) {
+                        failures++;
+                    }
+
+                    first->Value(index + 1);
+                    second->Value(round + 1);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        const Core::ProxyPoolAdministrator::Metadata info(Statistics(pool));
+        EXPECT_EQ(failures.load(), 0u);
+        EXPECT_EQ(info.Outstanding, 0u);
+        EXPECT_LE(info.HighWater, 2u * Threads);
+        EXPECT_EQ(info.Created, info.Misses);
+        EXPECT_EQ(info.Hits + info.Misses, 2u * Threads * Rounds);
+        EXPECT_EQ(pool.QueuedElements(), info.Created);
+
+        // All pools in the process are known to the administrator.
+        std::vector<Core::ProxyPoolAdministrator::Metadata> pools;
+        Core::ProxyPoolAdministrator::Instance().Snapshot(pools);
+
+        uint32_t found = 0;
+        for (const Core::ProxyPoolAdministrator::Metadata& entry : pools) {
+            if (Core::ClassNameOnly(entry.Name).Text() == Core::ClassNameOnly(typeid(Element).name()).Text()) {
+                found++;
+            }
+        }
+        EXPECT_EQ(found, 1u);
+    }
+
+} // Tests
+} // WPEFramework
@@ -39,3 +39,81 @@ TEST(test_queue, simple_queue)
     obj1.Disable();
     obj1.Flush();
 }
+
+TEST(test_queue, ring_queue)
+{
+    RingQueueType<int> obj1(4, 2);
+    EXPECT_EQ(obj1.Shards(), 2u);
+    EXPECT_TRUE(obj1.Insert(10,300));
+    EXPECT_TRUE(obj1.Insert(20,300));
+    EXPECT_TRUE(obj1.Insert(30,300));
+    EXPECT_TRUE(obj1.Insert(40,300));
+    EXPECT_TRUE(obj1.IsFull());
+    EXPECT_FALSE(obj1.Insert(50,100));
+
+    // Posting goes beyond the highwatermark.
+    EXPECT_TRUE(obj1.Post(50));
+    EXPECT_EQ(obj1.Length(),5u);
+    EXPECT_TRUE(obj1.HasEntry(50));
+    EXPECT_TRUE(obj1.Remove(20));
+    EXPECT_FALSE(obj1.Remove(20));
+    EXPECT_FALSE(obj1.HasEntry(20));
+
+    int sum = 0;
+    obj1.Visit([&](const int& entry) { sum += entry; });
+    EXPECT_EQ(sum, 130);
+
+    int a_Result = 0;
+    EXPECT_TRUE(obj1.Extract(a_Result,300));
+    EXPECT_EQ(a_Result, 10);
+    EXPECT_EQ(obj1.Length(),3u);
+    obj1.Disable();
+    EXPECT_FALSE(obj1.Extract(a_Result,100));
+    EXPECT_FALSE(obj1.Post(60));
+    obj1.Flush();
+    obj1.Enable();
+    EXPECT_TRUE(obj1.IsEmpty());
+    EXPECT_FALSE(obj1.Extract(a_Result,100));
+}
+
+TEST(test_queue, ring_queue_producers_consumers)
+{
+    constexpr uint32_t entries = 10000;
+    RingQueueType<uint32_t> obj1(16, 4);
+    std::atomic<uint32_t> received(0);
+    std::atomic<uint64_t> sum(0);
+    std::vector<std::thread> threads;
+
+    for (uint8_t index = 0; index < 3; index++) {
+        threads.emplace_back([&]() {
+            uint32_t value;
+            while (obj1.Extract(value, Core::infinite) == true) {
+                sum += value;
+                received++;
+            }
+        });
+    }
+    for (uint8_t index = 0; index < 2; index++) {
+        threads.emplace_back([&, index]() {
+            for (uint32_t value = index; value < entries; value += 2) {
+                EXPECT_TRUE(obj1.Insert(value, Core::infinite));
+            }
+        });
+    }
+
+    uint32_t retries = 500;
+    while ((received < entries) && (retries-- != 0)) {
+        SleepMs(10);
+    }
+
+    // Disabling releases the blocked consumers.
+    obj1.Disable();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(received.load(), entries);
+    EXPECT_EQ(sum.load(), (static_cast<uint64_t>(entries) * (entries - 1)) / 2);
+    EXPECT_TRUE(obj1.IsEmpty());
+}
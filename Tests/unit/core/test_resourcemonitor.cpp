@@ -0,0 +1,475 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class PipeResource : public Core::IResource {
+    public:
+        PipeResource(const PipeResource&) = delete;
+        PipeResource& operator=(const PipeResource&) = delete;
+
+        PipeResource()
+            : _signal(false, true)
+            , _received(0)
+            , _handled(0)
+        {
+            int VARIABLE_IS_NOT_USED result = ::pipe(_pipe);
+            ASSERT(result == 0);
+        }
+        ~PipeResource() override
+        {
+            ::close(_pipe[0]);
+            ::close(_pipe[1]);
+        }
+
+    public:
+        handle Descriptor() const override
+        {
+            return (_pipe[0]);
+        }
+        uint16_t Events() override
+        {
+            return (POLLIN);
+        }
+        void Handle(const uint16_t events) override
+        {
+            _handled++;
+
+            if ((events & POLLIN) != 0) {
+                uint8_t buffer[16];
+                ssize_t size = ::read(_pipe[0], buffer, sizeof(buffer));
+                if (size > 0) {
+                    _received += static_cast<uint32_t>(size);
+                    _signal.SetEvent();
+                }
+            }
+        }
+        void Send(const uint8_t count)
+        {
+            uint8_t buffer[16] = {};
+            ssize_t VARIABLE_IS_NOT_USED size = ::write(_pipe[1], buffer, count);
+        }
+        uint32_t Wait(const uint32_t waitTime)
+        {
+            uint32_t result = _signal.Lock(waitTime);
+            _signal.ResetEvent();
+            return (result);
+        }
+        uint32_t Received() const
+        {
+            return (_received);
+        }
+        uint32_t Handled() const
+        {
+            return (_handled);
+        }
+
+    private:
+        int _pipe[2];
+        Core::Event _signal;
+        std::atomic<uint32_t> _received;
+        std::atomic<uint32_t> _handled;
+    };
+
+    using TestMonitor = Core::ResourceMonitorType<Core::IResource, Core::Void, 0, 4>;
+
+    TEST(Core_ResourceMonitor, ReactorsHandleReadyResources)
+    {
+        TestMonitor monitor;
+
+        EXPECT_EQ(monitor.Reactors(), 0);
+        EXPECT_EQ(monitor.Reactors(3), Core::ERROR_NONE);
+        EXPECT_EQ(monitor.Reactors(), 3);
+
+        PipeResource resources[8];
+
+        for (PipeResource& resource : resources) {
+            monitor.Register(resource);
+        }
+
+        uint8_t count = 1;
+        for (PipeResource& resource : resources) {
+            resource.Send(count);
+            EXPECT_EQ(resource.Wait(2000), Core::ERROR_NONE);
+            EXPECT_EQ(resource.Received(), count);
+            count++;
+        }
+
+        EXPECT_EQ(monitor.Count(), 8u);
+
+        // Switching modes is only allowed if nothing is registered.
+        EXPECT_EQ(monitor.Reactors(1), Core::ERROR_ILLEGAL_STATE);
+
+        for (PipeResource& resource : resources) {
+            monitor.Unregister(resource);
+        }
+
+        // Once unregistered, the resource is no longer handled.
+        uint32_t handled = resources[0].Handled();
+        resources[0].Send(1);
+        monitor.Break();
+        EXPECT_EQ(resources[0].Wait(200), Core::ERROR_TIMEDOUT);
+        EXPECT_EQ(resources[0].Handled(), handled);
+    }
+
+    TEST(Core_ResourceMonitor, ReactorsBreakHandlesAllResources)
+    {
+        TestMonitor monitor;
+
+        EXPECT_EQ(monitor.Reactors(2), Core::ERROR_NONE);
+
+        PipeResource first;
+        PipeResource second;
+
+        monitor.Register(first);
+        monitor.Register(second);
+
+        first.Send(1);
+        EXPECT_EQ(first.Wait(2000), Core::ERROR_NONE);
+
+        uint32_t handled = second.Handled();
+
+        monitor.Break();
+
+        // A Break() reaches every resource, even the ones that are not ready.
+        uint32_t retries = 100;
+        while ((second.Handled() == handled) && (retries-- != 0)) {
+            ::SleepMs(10);
+        }
+        EXPECT_GT(second.Handled(), handled);
+        EXPECT_EQ(second.Received(), 0u);
+
+        monitor.Unregister(first);
+        monitor.Unregister(second);
+    }
+
+    TEST(Core_ResourceMonitor, ReactorsBreakOnlyTheResource)
+    {
+        TestMonitor monitor;
+
+        EXPECT_EQ(monitor.Reactors(2), Core::ERROR_NONE);
+
+        PipeResource first;
+        PipeResource second;
+        PipeResource other;
+
+        monitor.Register(first, 0);
+        monitor.Register(second, 0);
+        monitor.Register(other, 1);
+
+        first.Send(1);
+        EXPECT_EQ(first.Wait(2000), Core::ERROR_NONE);
+
+        const uint32_t handled = first.Handled();
+        const uint32_t untouched = second.Handled() + other.Handled();
+
+        monitor.Break(first, 0);
+
+        uint32_t retries = 100;
+        while ((first.Handled() == handled) && (retries-- != 0)) {
+            ::SleepMs(10);
+        }
+        EXPECT_GT(first.Handled(), handled);
+
+        // Neither the other resources of its reactor nor the ones of other reactors are visited.
+        ::SleepMs(100);
+        EXPECT_EQ(second.Handled() + other.Handled(), untouched);
+
+        monitor.Unregister(first, 0);
+        monitor.Unregister(second, 0);
+        monitor.Unregister(other, 1);
+    }
+
+    TEST(Core_ResourceMonitor, ReactorsUnregisterEachOther)
+    {
+        class Unregistering : public PipeResource {
+        public:
+            Unregistering(TestMonitor& monitor)
+                : _monitor(monitor)
+                , _peer(nullptr)
+                , _reactor(0)
+            {
+            }
+            ~Unregistering() override = default;
+
+        public:
+            void Peer(PipeResource& peer, const uint8_t reactor)
+            {
+                _peer = &peer;
+                _reactor = reactor;
+            }
+            void Handle(const uint16_t events) override
+            {
+                if (_peer != nullptr) {
+                    // Give the other reactor the time to get into its Handle() as well.
+                    ::SleepMs(50);
+                    _monitor.Unregister(*_peer, _reactor);
+                    _peer = nullptr;
+                }
+                PipeResource::Handle(events);
+            }
+
+        private:
+            TestMonitor& _monitor;
+            PipeResource* _peer;
+            uint8_t _reactor;
+        };
+
+        TestMonitor monitor;
+
+        EXPECT_EQ(monitor.Reactors(2), Core::ERROR_NONE);
+
+        Unregistering first(monitor);
+        Unregistering second(monitor);
+
+        first.Peer(second, 1);
+        second.Peer(first, 0);
+
+        monitor.Register(first, 0);
+        monitor.Register(second, 1);
+
+        first.Send(1);
+        second.Send(1);
+
+        // Both reactors unregister the resource of the other one while handling their own.
+        EXPECT_EQ(first.Wait(2000), Core::ERROR_NONE);
+        EXPECT_EQ(second.Wait(2000), Core::ERROR_NONE);
+
+        uint32_t retries = 100;
+        while ((monitor.Count() != 0) && (retries-- != 0)) {
+            ::SleepMs(10);
+        }
+        EXPECT_EQ(monitor.Count(), 0u);
+
+        const uint32_t handled = first.Handled() + second.Handled();
+        first.Send(1);
+        second.Send(1);
+        monitor.Break();
+        EXPECT_EQ(first.Wait(200), Core::ERROR_TIMEDOUT);
+        EXPECT_EQ(first.Handled() + second.Handled(), handled);
+    }
+
+    TEST(Core_ResourceMonitor, ReactorsUnregisterWaitsForHandle)
+    {
+        class Slow : public PipeResource {
+        public:
+            Slow()
+                : _entered(false, true)
+                , _busy(false)
+            {
+            }
+            ~Slow() override = default;
+
+        public:
+            void Handle(const uint16_t events) override
+            {
+                _busy = true;
+                _entered.SetEvent();
+                ::SleepMs(200);
+                PipeResource::Handle(events);
+                _busy = false;
+            }
+            uint32_t Entered(const uint32_t waitTime)
+            {
+                return (_entered.Lock(waitTime));
+            }
+            bool IsBusy() const
+            {
+                return (_busy);
+            }
+
+        private:
+            Core::Event _entered;
+            std::atomic<bool> _busy;
+        };
+
+        class Unregistering : public PipeResource {
+        public:
+            Unregistering(TestMonitor& monitor, Slow& slow)
+                : _monitor(monitor)
+                , _slow(slow)
+                , _busy(true)
+            {
+            }
+            ~Unregistering() override = default;
+
+        public:
+            void Handle(const uint16_t events) override
+            {
+                if (_slow.Entered(2000) == Core::ERROR_NONE) {
+                    _monitor.Unregister(_slow, 0);
+
+                    // Once unregistered, the other reactor must be done with it.
+                    _busy = _slow.IsBusy();
+                }
+                PipeResource::Handle(events);
+            }
+            bool WasBusy() const
+            {
+                return (_busy);
+            }
+
+        private:
+            TestMonitor& _monitor;
+            Slow& _slow;
+            std::atomic<bool> _busy;
+        };
+
+        TestMonitor monitor;
+
+        EXPECT_EQ(monitor.Reactors(2), Core::ERROR_NONE);
+
+        Slow slow;
+        Unregistering unregistering(monitor, slow);
+
+        monitor.Register(slow, 0);
+        monitor.Register(unregistering, 1);
+
+        slow.Send(1);
+        unregistering.Send(1);
+
+        EXPECT_EQ(unregistering.Wait(2000), Core::ERROR_NONE);
+        EXPECT_FALSE(unregistering.WasBusy());
+
+        monitor.Unregister(unregistering, 1);
+    }
+
+#ifdef __CORE_IO_URING__
+    TEST(Core_ResourceMonitor, CompletionRing)
+    {
+        Core::CompletionRing ring(8);
+
+        // Older kernels do not offer it, the reactors fall back to epoll then.
+        if (ring.IsValid() == false) {
+            return;
+        }
+
+        int pipes[2];
+        ASSERT_EQ(::pipe(pipes), 0);
+
+        Core::CompletionRing::Completion completions[4];
+        uint8_t buffer[4] = {};
+
+        // Nothing to read yet, the poll stays pending until it is cancelled.
+        ring.Poll(pipes[0], POLLIN, 2);
+        ring.Submit();
+        ring.Cancel(2);
+
+        uint16_t count = 0;
+        while (count < 2) {
+            count += ring.Wait(&completions[count], 2 - count);
+        }
+        for (uint16_t index = 0; index < count; index++) {
+            if (completions[index].Token == 2) {
+                EXPECT_EQ(completions[index].Result, -ECANCELED);
+            } else {
+                EXPECT_EQ(completions[index].Token, 0u);
+            }
+        }
+
+        ring.Poll(pipes[0], POLLIN, 3);
+        EXPECT_EQ(::write(pipes[1], "ring", 4), 4);
+        EXPECT_EQ(ring.Wait(completions, 4), 1u);
+        EXPECT_EQ(completions[0].Token, 3u);
+        EXPECT_NE(completions[0].Result & POLLIN, 0);
+
+        ring.Read(pipes[0], buffer, sizeof(buffer), 4);
+        EXPECT_EQ(ring.Wait(completions, 4), 1u);
+        EXPECT_EQ(completions[0].Token, 4u);
+        EXPECT_EQ(completions[0].Result, 4);
+        EXPECT_EQ(::memcmp(buffer, "ring", 4), 0);
+
+        ::close(pipes[0]);
+        ::close(pipes[1]);
+    }
+
+    TEST(Core_ResourceMonitor, ReactorsReportFailedPolls)
+    {
+        class Broken : public Core::IResource {
+        public:
+            Broken(const Broken&) = delete;
+            Broken& operator=(const Broken&) = delete;
+
+            Broken()
+                : _signal(false, true)
+                , _events(0)
+            {
+            }
+            ~Broken() override = default;
+
+        public:
+            handle Descriptor() const override
+            {
+                // Never opened, so it can not be polled.
+                return (0x7FFFFFF0);
+            }
+            uint16_t Events() override
+            {
+                return (POLLIN);
+            }
+            void Handle(const uint16_t events) override
+            {
+                if (events != 0) {
+                    _events = events;
+                    _signal.SetEvent();
+                }
+            }
+            uint32_t Wait(const uint32_t waitTime)
+            {
+                return (_signal.Lock(waitTime));
+            }
+            uint16_t Reported() const
+            {
+                return (_events);
+            }
+
+        private:
+            Core::Event _signal;
+            std::atomic<uint16_t> _events;
+        };
+
+        // Only the completion ring reports the failure of a poll.
+        if (Core::CompletionRing(8).IsValid() == false) {
+            return;
+        }
+
+        TestMonitor monitor;
+
+        EXPECT_EQ(monitor.Reactors(1), Core::ERROR_NONE);
+
+        Broken broken;
+
+        monitor.Register(broken);
+
+        // The resource hears about it, so it can close, instead of silently not being watched.
+        EXPECT_EQ(broken.Wait(2000), Core::ERROR_NONE);
+        EXPECT_NE(broken.Reported() & POLLHUP, 0);
+
+        monitor.Unregister(broken);
+    }
+#endif
+
+} // Tests
+} // WPEFramework
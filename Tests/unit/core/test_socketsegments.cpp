@@ -0,0 +1,217 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        // Sends a message as header, body and trailer segments, and a last part through the send buffer.
+        class Gatherer : public Core::SocketStream {
+        public:
+            Gatherer() = delete;
+            Gatherer(const Gatherer&) = delete;
+            Gatherer& operator=(const Gatherer&) = delete;
+
+            Gatherer(const SOCKET& connector, const Core::NodeId& remoteId, const uint32_t length)
+                : Core::SocketStream(false, connector, remoteId, 64, 64, static_cast<uint32_t>(~0), static_cast<uint32_t>(~0))
+                , _header(_T("HEADER"))
+                , _body(length)
+                , _trailer(_T("TRAILER"))
+                , _handedOut(false)
+                , _copied(false)
+                , _released(0)
+                , _done(false, true)
+            {
+                for (uint32_t index = 0; index < length; index++) {
+                    _body[index] = static_cast<uint8_t>(index * 13);
+                }
+            }
+            ~Gatherer() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            uint32_t Released() const
+            {
+                return (_released);
+            }
+            bool Wait(const uint32_t time) const
+            {
+                return (_done.Lock(time) == Core::ERROR_NONE);
+            }
+            string Expected() const
+            {
+                return (_header + string(reinterpret_cast<const char*>(_body.data()), _body.size()) + _trailer + _T("COPIED"));
+            }
+
+            uint8_t SendSegments(Segment segments[], const uint8_t maxSegments) override
+            {
+                uint8_t result = 0;
+
+                EXPECT_GE(maxSegments, 3);
+
+                if (_handedOut == false) {
+                    segments[0] = { reinterpret_cast<const uint8_t*>(_header.c_str()), static_cast<uint32_t>(_header.length()) };
+                    segments[1] = { _body.data(), static_cast<uint32_t>(_body.size()) };
+                    segments[2] = { reinterpret_cast<const uint8_t*>(_trailer.c_str()), static_cast<uint32_t>(_trailer.length()) };
+                    _handedOut = true;
+                    result = 3;
+                }
+
+                return (result);
+            }
+            void ReleaseSegments() override
+            {
+                _released++;
+            }
+            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+            {
+                uint16_t result = 0;
+
+                // Only asked for once the segments are written.
+                if ((_handedOut == true) && (_copied == false)) {
+                    EXPECT_GE(maxSendSize, 6);
+                    ::memcpy(dataFrame, "COPIED", 6);
+                    _copied = true;
+                    result = 6;
+                } else if (_copied == true) {
+                    _done.SetEvent();
+                }
+
+                return (result);
+            }
+            uint16_t ReceiveData(uint8_t*, const uint16_t) override
+            {
+                return (0);
+            }
+            void StateChange() override
+            {
+            }
+
+        private:
+            const string _header;
+            std::vector<uint8_t> _body;
+            const string _trailer;
+            bool _handedOut;
+            bool _copied;
+            std::atomic<uint32_t> _released;
+            mutable Core::Event _done;
+        };
+
+        // A connected pair of TCP sockets on the loopback interface.
+        void Connect(SOCKET& sender, SOCKET& receiver)
+        {
+            struct sockaddr_in address;
+            socklen_t size = sizeof(address);
+            SOCKET listener = ::socket(AF_INET, SOCK_STREAM, 0);
+
+            ::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            ASSERT_EQ(::bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+            ASSERT_EQ(::listen(listener, 1), 0);
+            ASSERT_EQ(::getsockname(listener, reinterpret_cast<struct sockaddr*>(&address), &size), 0);
+
+            receiver = ::socket(AF_INET, SOCK_STREAM, 0);
+            ASSERT_EQ(::connect(receiver, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+            sender = ::accept(listener, nullptr, nullptr);
+            ASSERT_NE(sender, INVALID_SOCKET);
+
+            ::close(listener);
+        }
+
+        string Receive(SOCKET socket, const size_t length)
+        {
+            string result;
+            char buffer[64 * 1024];
+
+            while (result.length() < length) {
+                const ssize_t size = ::recv(socket, buffer, sizeof(buffer), 0);
+                if (size <= 0) {
+                    break;
+                }
+                result.append(buffer, size);
+            }
+
+            return (result);
+        }
+
+        void Transfer(const bool zeroCopy)
+        {
+            SOCKET sender = INVALID_SOCKET;
+            SOCKET receiver = INVALID_SOCKET;
+
+            Connect(sender, receiver);
+            ASSERT_NE(receiver, INVALID_SOCKET);
+
+            {
+                // Far more than the send buffer and the socket take at once.
+                Gatherer gatherer(sender, Core::NodeId(_T("127.0.0.1"), 1), 4 * 1024 * 1024);
+
+                // Loopback may not offer it, the data has to arrive either way.
+                gatherer.ZeroCopy(zeroCopy);
+                EXPECT_EQ(gatherer.Open(0), Core::ERROR_NONE);
+                gatherer.Trigger();
+
+                const string expected(gatherer.Expected());
+                const string received(Receive(receiver, expected.length()));
+
+                EXPECT_EQ(received.length(), expected.length());
+                EXPECT_TRUE(received == expected);
+                EXPECT_TRUE(gatherer.Wait(2000));
+
+                // Zero copy sends are released once the kernel reported them done.
+                uint8_t retries = 100;
+                while ((gatherer.Released() == 0) && (--retries != 0)) {
+                    SleepMs(10);
+                }
+                EXPECT_EQ(gatherer.Released(), 1u);
+            }
+
+            ::close(receiver);
+        }
+
+    }
+
+    TEST(Core_Socket, Segments)
+    {
+        Transfer(false);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_Socket, SegmentsZeroCopy)
+    {
+        Transfer(true);
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,206 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        class Connection : public Core::SocketStream {
+        public:
+            Connection() = delete;
+            Connection(const Connection&) = delete;
+            Connection& operator=(const Connection&) = delete;
+
+            Connection(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<Connection>*)
+                : Core::SocketStream(false, connector, remoteId, 64, 64)
+                , _id(0)
+            {
+            }
+            ~Connection() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            uint32_t Id() const
+            {
+                return (_id);
+            }
+            void Id(const uint32_t id)
+            {
+                _id = id;
+            }
+            uint16_t SendData(uint8_t*, const uint16_t) override
+            {
+                return (0);
+            }
+            uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+            {
+                return (receivedSize);
+            }
+            void StateChange() override
+            {
+            }
+
+        private:
+            uint32_t _id;
+        };
+
+        SOCKET Connect(const uint16_t port)
+        {
+            struct sockaddr_in address;
+            SOCKET result = ::socket(AF_INET, SOCK_STREAM, 0);
+
+            ::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(port);
+
+            if (::connect(result, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+                ::close(result);
+                result = INVALID_SOCKET;
+            }
+
+            return (result);
+        }
+
+        void Serve(const uint8_t listeners, const uint16_t port)
+        {
+            static constexpr uint16_t Clients = 64;
+
+            Core::SocketServerType<Connection> server(Core::NodeId(_T("127.0.0.1"), port), listeners);
+            std::vector<SOCKET> sockets;
+
+            EXPECT_EQ(server.Listeners(), listeners);
+            ASSERT_EQ(server.Open(0), Core::ERROR_NONE);
+
+            for (uint16_t index = 0; index < Clients; index++) {
+                sockets.push_back(Connect(port));
+                EXPECT_NE(sockets.back(), INVALID_SOCKET);
+            }
+
+            uint16_t retries = 200;
+            while ((server.Count() != Clients) && (--retries != 0)) {
+                SleepMs(10);
+            }
+            EXPECT_EQ(server.Count(), Clients);
+
+            // The clients of all listeners are visited once and can be found back by their id.
+            std::set<uint32_t> ids;
+            Core::SocketServerType<Connection>::Iterator index(server.Clients());
+
+            EXPECT_EQ(index.Count(), Clients);
+
+            while (index.Next() == true) {
+                const uint32_t id = index.Client()->Id();
+
+                EXPECT_NE(id, 0u);
+                EXPECT_TRUE(ids.insert(id).second);
+                EXPECT_TRUE(server.Client(id) == index.Client());
+            }
+            EXPECT_EQ(ids.size(), Clients);
+            EXPECT_FALSE(server.Client(0x7FFFFFFF).IsValid());
+
+            for (SOCKET socket : sockets) {
+                ::close(socket);
+            }
+
+            retries = 200;
+            do {
+                SleepMs(10);
+                server.Cleanup();
+            } while ((server.Count() != 0) && (--retries != 0));
+            EXPECT_EQ(server.Count(), 0u);
+
+            server.Close(Core::infinite);
+        }
+
+    }
+
+    TEST(Core_SocketServer, Reclaim)
+    {
+        static constexpr uint16_t Port = 12349;
+
+        Core::SocketServerType<Connection> server(Core::NodeId(_T("127.0.0.1"), Port));
+
+        ASSERT_EQ(server.Open(0), Core::ERROR_NONE);
+
+        uint32_t previous = 0;
+
+        for (uint8_t round = 0; round < 3; round++) {
+            SOCKET socket = Connect(Port);
+            EXPECT_NE(socket, INVALID_SOCKET);
+
+            uint16_t retries = 200;
+            while ((server.Count() != 1) && (--retries != 0)) {
+                SleepMs(10);
+            }
+
+            Core::SocketServerType<Connection>::Iterator index(server.Clients());
+            ASSERT_TRUE(index.Next());
+
+            // The slot of the previous client is taken over, but its id does not reach the new one.
+            const uint32_t id = index.Client()->Id();
+            EXPECT_NE(id, previous);
+            EXPECT_TRUE(server.Client(id).IsValid());
+            EXPECT_FALSE(server.Client(previous).IsValid());
+
+            ::close(socket);
+
+            retries = 200;
+            while ((index.Client()->IsClosed() == false) && (--retries != 0)) {
+                SleepMs(10);
+            }
+
+            server.Reclaim(id);
+            server.Cleanup();
+            EXPECT_EQ(server.Count(), 0u);
+            EXPECT_FALSE(server.Client(id).IsValid());
+
+            previous = id;
+        }
+
+        server.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_SocketServer, SingleListener)
+    {
+        Serve(1, 12347);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_SocketServer, SharedListeners)
+    {
+        Serve(4, 12348);
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
@@ -1433,3 +1433,280 @@ TEST(Core_ThreadPool, CheckThreadPool_JobType_Reschedule_AfterIdle)
     jobs.clear();
 }
 
+
+class StealingJob : public Core::IDispatch {
+public:
+    StealingJob() = delete;
+    StealingJob(const StealingJob&) = delete;
+    StealingJob& operator=(const StealingJob&) = delete;
+
+    StealingJob(ThreadPool& pool, std::atomic<uint32_t>& completed, const uint32_t waitTime)
+        : _pool(pool)
+        , _completed(completed)
+        , _waitTime(waitTime)
+        , _children()
+    {
+    }
+    ~StealingJob() override = default;
+
+public:
+    void Add(const Core::ProxyType<Core::IDispatch>& child)
+    {
+        _children.push_back(child);
+    }
+    void Dispatch() override
+    {
+        // Jobs submitted from a worker thread stay local to that worker.
+        for (const Core::ProxyType<Core::IDispatch>& child : _children) {
+            _pool.Submit(child, 0);
+        }
+        usleep(_waitTime);
+        _completed++;
+    }
+
+private:
+    ThreadPool& _pool;
+    std::atomic<uint32_t>& _completed;
+    const uint32_t _waitTime;
+    std::vector<Core::ProxyType<Core::IDispatch>> _children;
+};
+
+TEST(Core_ThreadPool, CheckThreadPool_WorkStealing)
+{
+    constexpr uint8_t threadCount = 2;
+    constexpr uint8_t children = 4;
+
+    Dispatcher dispatcher;
+    ThreadPool threadPool(threadCount, 0, 8, &dispatcher, nullptr, nullptr, nullptr, true);
+    std::atomic<uint32_t> completed(0);
+
+    EXPECT_TRUE(threadPool.IsStealing());
+
+    // The parent keeps its worker busy after submitting its children, a short job keeps the
+    // other worker busy while they are submitted. Once that one is done, it steals the children.
+    Core::ProxyType<StealingJob> parent(Core::ProxyType<StealingJob>::Create(threadPool, completed, 300 * 1000));
+    Core::ProxyType<StealingJob> blocker(Core::ProxyType<StealingJob>::Create(threadPool, completed, 50 * 1000));
+    std::vector<Core::ProxyType<StealingJob>> jobs;
+
+    for (uint8_t index = 0; index < children; index++) {
+        jobs.push_back(Core::ProxyType<StealingJob>::Create(threadPool, completed, 1000));
+        parent->Add(Core::ProxyType<Core::IDispatch>(jobs.back()));
+    }
+
+    threadPool.Submit(Core::ProxyType<Core::IDispatch>(blocker), 0);
+    threadPool.Submit(Core::ProxyType<Core::IDispatch>(parent), 0);
+    threadPool.Run();
+
+    uint32_t retries = 200;
+    while ((completed < (children + 2)) && (retries-- != 0)) {
+        SleepMs(10);
+    }
+
+    EXPECT_EQ(completed.load(), static_cast<uint32_t>(children + 2));
+
+    ThreadPool::Metadata info[threadCount];
+    std::vector<string> pending;
+    threadPool.Snapshot(threadCount, info, pending);
+
+    uint32_t steals = 0;
+    uint32_t runs = 0;
+    for (uint8_t index = 0; index < threadCount; index++) {
+        steals += info[index].Steals;
+        runs += info[index].Runs;
+        EXPECT_EQ(info[index].Depth, 0u);
+    }
+    EXPECT_EQ(runs, static_cast<uint32_t>(children + 2));
+    EXPECT_GT(steals, 0u);
+    EXPECT_TRUE(pending.empty());
+
+    threadPool.Stop();
+}
+
+class WaitingJob : public Core::IDispatch {
+public:
+    WaitingJob() = delete;
+    WaitingJob(const WaitingJob&) = delete;
+    WaitingJob& operator=(const WaitingJob&) = delete;
+
+    WaitingJob(ThreadPool& pool, const Core::ProxyType<Core::IDispatch>& child, Core::Event& done)
+        : _pool(pool)
+        , _child(child)
+        , _done(done)
+        , _result(Core::ERROR_NONE)
+        , _runs(0)
+    {
+    }
+    ~WaitingJob() override = default;
+
+public:
+    uint32_t Result() const
+    {
+        return (_result);
+    }
+    uint32_t Runs() const
+    {
+        return (_runs);
+    }
+    void Dispatch() override
+    {
+        // The child stays local to this worker, the other worker has to pick it up.
+        _done.ResetEvent();
+        _pool.Submit(_child, 0);
+        _result = _done.Lock(1000);
+        _runs++;
+    }
+
+private:
+    ThreadPool& _pool;
+    Core::ProxyType<Core::IDispatch> _child;
+    Core::Event& _done;
+    std::atomic<uint32_t> _result;
+    std::atomic<uint32_t> _runs;
+};
+
+class SignallingJob : public Core::IDispatch {
+public:
+    SignallingJob() = delete;
+    SignallingJob(const SignallingJob&) = delete;
+    SignallingJob& operator=(const SignallingJob&) = delete;
+
+    SignallingJob(Core::Event& done)
+        : _done(done)
+    {
+    }
+    ~SignallingJob() override = default;
+
+public:
+    void Dispatch() override
+    {
+        _done.SetEvent();
+    }
+
+private:
+    Core::Event& _done;
+};
+
+TEST(Core_ThreadPool, CheckThreadPool_WorkStealing_WaitForChild)
+{
+    constexpr uint8_t threadCount = 2;
+    constexpr uint16_t rounds = 200;
+
+    Dispatcher dispatcher;
+    ThreadPool threadPool(threadCount, 0, 8, &dispatcher, nullptr, nullptr, nullptr, true);
+    Core::Event done(false, true);
+
+    Core::ProxyType<SignallingJob> child(Core::ProxyType<SignallingJob>::Create(done));
+    Core::ProxyType<WaitingJob> parent(Core::ProxyType<WaitingJob>::Create(threadPool, Core::ProxyType<Core::IDispatch>(child), done));
+
+    threadPool.Run();
+
+    // The other worker goes idle around the time the child is submitted, it must still see it.
+    for (uint16_t round = 0; round < rounds; round++) {
+        threadPool.Submit(Core::ProxyType<Core::IDispatch>(parent), 0);
+
+        uint32_t retries = 300;
+        while ((parent->Runs() == round) && (retries-- != 0)) {
+            SleepMs(5);
+        }
+
+        EXPECT_EQ(parent->Result(), Core::ERROR_NONE);
+    }
+
+    threadPool.Stop();
+}
+
+class BusyJob : public Core::IDispatch {
+public:
+    BusyJob() = delete;
+    BusyJob(const BusyJob&) = delete;
+    BusyJob& operator=(const BusyJob&) = delete;
+
+    BusyJob(const uint32_t waitTime)
+        : _waitTime(waitTime)
+        , _running(false)
+    {
+    }
+    ~BusyJob() override = default;
+
+public:
+    bool IsRunning() const
+    {
+        return (_running);
+    }
+    void Dispatch() override
+    {
+        _running = true;
+        usleep(_waitTime);
+        _running = false;
+    }
+
+private:
+    const uint32_t _waitTime;
+    std::atomic<bool> _running;
+};
+
+class SubmittingJob : public Core::IDispatch {
+public:
+    SubmittingJob() = delete;
+    SubmittingJob(const SubmittingJob&) = delete;
+    SubmittingJob& operator=(const SubmittingJob&) = delete;
+
+    SubmittingJob(ThreadPool& pool, const Core::ProxyType<Core::IDispatch>& child, Core::Event& submitted)
+        : _pool(pool)
+        , _child(child)
+        , _submitted(submitted)
+    {
+    }
+    ~SubmittingJob() override = default;
+
+public:
+    void Dispatch() override
+    {
+        // Keeps this worker busy, so the child is run by the other one, from wherever it ended up.
+        _pool.Submit(_child, 0);
+        _submitted.SetEvent();
+        usleep(2000);
+    }
+
+private:
+    ThreadPool& _pool;
+    Core::ProxyType<Core::IDispatch> _child;
+    Core::Event& _submitted;
+};
+
+TEST(Core_ThreadPool, CheckThreadPool_WorkStealing_RevokeWhileStolen)
+{
+    constexpr uint8_t threadCount = 2;
+    constexpr uint16_t rounds = 200;
+
+    Dispatcher dispatcher;
+    ThreadPool threadPool(threadCount, 0, 8, &dispatcher, nullptr, nullptr, nullptr, true);
+    Core::Event submitted(false, true);
+
+    Core::ProxyType<BusyJob> blocker(Core::ProxyType<BusyJob>::Create(500));
+    Core::ProxyType<BusyJob> child(Core::ProxyType<BusyJob>::Create(1000));
+    Core::ProxyType<SubmittingJob> parent(Core::ProxyType<SubmittingJob>::Create(threadPool, Core::ProxyType<Core::IDispatch>(child), submitted));
+
+    threadPool.Run();
+
+    // Once Revoke returns, the child is either gone or done, never still running on a thief.
+    for (uint16_t round = 0; round < rounds; round++) {
+        submitted.ResetEvent();
+
+        threadPool.Submit(Core::ProxyType<Core::IDispatch>(blocker), 0);
+        threadPool.Submit(Core::ProxyType<Core::IDispatch>(parent), 0);
+
+        EXPECT_EQ(submitted.Lock(1000), Core::ERROR_NONE);
+
+        const uint32_t result = threadPool.Revoke(Core::ProxyType<Core::IDispatch>(child), 1000);
+
+        EXPECT_TRUE((result == Core::ERROR_NONE) || (result == Core::ERROR_UNKNOWN_KEY));
+        EXPECT_FALSE(child->IsRunning());
+
+        // Let the parent and the blocker finish before they are submitted again.
+        EXPECT_NE(threadPool.Revoke(Core::ProxyType<Core::IDispatch>(parent), 1000), Core::ERROR_TIMEDOUT);
+        EXPECT_NE(threadPool.Revoke(Core::ProxyType<Core::IDispatch>(blocker), 1000), Core::ERROR_TIMEDOUT);
+    }
+
+    threadPool.Stop();
+}
@@ -0,0 +1,131 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class OrderedHandler {
+    public:
+        OrderedHandler& operator=(const OrderedHandler&) = delete;
+
+        OrderedHandler(const uint32_t id, std::vector<uint32_t>& fired, Core::Event& done, const uint32_t last)
+            : _id(id)
+            , _fired(fired)
+            , _done(done)
+            , _last(last)
+            , _rescheduled(false)
+        {
+        }
+        OrderedHandler(const OrderedHandler& copy)
+            : _id(copy._id)
+            , _fired(copy._fired)
+            , _done(copy._done)
+            , _last(copy._last)
+            , _rescheduled(copy._rescheduled)
+        {
+        }
+        ~OrderedHandler() = default;
+
+    public:
+        bool operator==(const OrderedHandler& RHS) const
+        {
+            return (_id == RHS._id);
+        }
+        bool operator!=(const OrderedHandler& RHS) const
+        {
+            return (!operator==(RHS));
+        }
+        uint64_t Hash() const
+        {
+            return (_id);
+        }
+        uint64_t Timed(const uint64_t scheduledTime)
+        {
+            uint64_t result = 0;
+
+            _fired.push_back(_id);
+
+            // The first one reschedules itself to be the last one to fire.
+            if ((_id == 0) && (_rescheduled == false)) {
+                _rescheduled = true;
+                result = scheduledTime + (200 * Core::Time::TicksPerMillisecond);
+            } else if (_id == _last) {
+                _done.SetEvent();
+            }
+
+            return (result);
+        }
+
+    private:
+        const uint32_t _id;
+        std::vector<uint32_t>& _fired;
+        Core::Event& _done;
+        const uint32_t _last;
+        bool _rescheduled;
+    };
+
+    TEST(Core_Timer, HeapTimer)
+    {
+        constexpr uint32_t entries = 64;
+
+        std::vector<uint32_t> fired;
+        Core::Event done(false, true);
+        Core::TimerType<OrderedHandler> timer(Core::Thread::DefaultStackSize(), _T("HeapTimer"), Core::TimerType<OrderedHandler>::HEAP);
+
+        const uint64_t start = Core::Time::Now().Add(100).Ticks();
+
+        // Schedule in a scrambled order, every entry 1ms apart.
+        for (uint32_t index = 0; index < entries; index++) {
+            const uint32_t id = (index * 37) % entries;
+            timer.Schedule(start + (id * Core::Time::TicksPerMillisecond), OrderedHandler(id, fired, done, 0));
+        }
+
+        EXPECT_EQ(timer.Pending(), entries);
+        EXPECT_TRUE(timer.HasEntry(OrderedHandler(10, fired, done, 0)));
+
+        // Odd ones are revoked, 2 is moved behind 3.
+        for (uint32_t id = 1; id < entries; id += 2) {
+            EXPECT_TRUE(timer.Revoke(OrderedHandler(id, fired, done, 0)));
+        }
+        EXPECT_FALSE(timer.Revoke(OrderedHandler(1, fired, done, 0)));
+        EXPECT_FALSE(timer.HasEntry(OrderedHandler(1, fired, done, 0)));
+        timer.Trigger(start + (3 * Core::Time::TicksPerMillisecond), OrderedHandler(2, fired, done, 0));
+
+        EXPECT_EQ(timer.Pending(), entries / 2);
+        EXPECT_EQ(done.Lock(2000), Core::ERROR_NONE);
+
+        std::vector<uint32_t> expected;
+        expected.push_back(0);
+        for (uint32_t id = 4; id < entries; id += 2) {
+            expected.push_back(id);
+        }
+        expected.insert(expected.begin() + 1, 2);
+        expected.push_back(0);
+
+        EXPECT_EQ(fired, expected);
+        EXPECT_EQ(timer.Pending(), 0u);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,220 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        const TCHAR FileName[] = _T("/tmp/webfilebody.bin");
+
+        // Serves the file for every request, or the part of it asked for.
+        class FileServer : public Web::WebLinkType<Core::SocketStream, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>> {
+        private:
+            using BaseClass = Web::WebLinkType<Core::SocketStream, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>>;
+
+        public:
+            FileServer() = delete;
+            FileServer(const FileServer&) = delete;
+            FileServer& operator=(const FileServer&) = delete;
+
+            FileServer(const SOCKET& connector, const Core::NodeId& remoteId)
+                : BaseClass(2, false, connector, remoteId, 1024, 1024)
+                , _files(2)
+            {
+            }
+            ~FileServer() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            void LinkBody(Core::ProxyType<Web::Request>&) override
+            {
+            }
+            void Received(Core::ProxyType<Web::Request>& request) override
+            {
+                Core::ProxyType<Web::Response> response(Core::ProxyType<Web::Response>::Create());
+                Core::ProxyType<Web::FileBody> file(_files.Element());
+
+                *file = string(FileName);
+
+                if (request->Range.IsSet() == true) {
+                    string contentRange;
+
+                    response->ErrorCode = file->Range(request->Range.Value(), contentRange);
+
+                    if (contentRange.empty() == false) {
+                        response->ContentRange = contentRange;
+                    }
+                }
+                if (response->ErrorCode != Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE) {
+                    response->Body<Web::FileBody>(file);
+                }
+
+                Submit(response);
+            }
+            void Send(const Core::ProxyType<Web::Response>&) override
+            {
+            }
+            void StateChange() override
+            {
+            }
+
+        private:
+            Core::ProxyPoolType<Web::FileBody> _files;
+        };
+
+        // A connected pair of TCP sockets on the loopback interface.
+        void Connect(SOCKET& server, SOCKET& client)
+        {
+            struct sockaddr_in address;
+            socklen_t size = sizeof(address);
+            SOCKET listener = ::socket(AF_INET, SOCK_STREAM, 0);
+
+            ::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            ASSERT_EQ(::bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+            ASSERT_EQ(::listen(listener, 1), 0);
+            ASSERT_EQ(::getsockname(listener, reinterpret_cast<struct sockaddr*>(&address), &size), 0);
+
+            client = ::socket(AF_INET, SOCK_STREAM, 0);
+            ASSERT_EQ(::connect(client, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+            server = ::accept(listener, nullptr, nullptr);
+            ASSERT_NE(server, INVALID_SOCKET);
+
+            ::close(listener);
+        }
+
+        // Sends a GET and collects the raw response, the body as far as the Content-Length goes.
+        string Get(SOCKET socket, const string& range, string& body)
+        {
+            string request(_T("GET /file HTTP/1.1\r\nHost: localhost\r\n"));
+            string header;
+            char buffer[64 * 1024];
+            size_t length = 0;
+
+            if (range.empty() == false) {
+                request += _T("Range: ") + range + _T("\r\n");
+            }
+            request += _T("\r\n");
+
+            EXPECT_EQ(::send(socket, request.c_str(), request.length(), 0), static_cast<ssize_t>(request.length()));
+
+            body.clear();
+
+            while (header.find(_T("\r\n\r\n")) == string::npos) {
+                const ssize_t size = ::recv(socket, buffer, 1, 0);
+                if (size <= 0) {
+                    break;
+                }
+                header.append(buffer, size);
+            }
+
+            const size_t position = header.find(_T("Content-Length: "));
+            if (position != string::npos) {
+                length = static_cast<size_t>(::atol(&header[position + 16]));
+            }
+
+            while (body.length() < length) {
+                const ssize_t size = ::recv(socket, buffer, std::min(sizeof(buffer), length - body.length()), 0);
+                if (size <= 0) {
+                    break;
+                }
+                body.append(buffer, size);
+            }
+
+            return (header);
+        }
+
+    }
+
+    TEST(Web_FileBody, Range)
+    {
+        // Far more than the send buffer, most of it goes out straight from the file.
+        string content(1024 * 1024, '\0');
+        for (uint32_t index = 0; index < content.length(); index++) {
+            content[index] = static_cast<char>(index * 7);
+        }
+
+        {
+            Core::File file(FileName);
+            ASSERT_TRUE(file.Create());
+            EXPECT_EQ(file.Write(reinterpret_cast<const uint8_t*>(content.c_str()), static_cast<uint32_t>(content.length())), content.length());
+        }
+
+        SOCKET server = INVALID_SOCKET;
+        SOCKET client = INVALID_SOCKET;
+
+        Connect(server, client);
+        ASSERT_NE(client, INVALID_SOCKET);
+
+        {
+            FileServer link(server, Core::NodeId(_T("127.0.0.1"), 1));
+            EXPECT_EQ(link.Open(0), Core::ERROR_NONE);
+
+            string body;
+            string header(Get(client, string(), body));
+            EXPECT_NE(header.find(_T(" 200 ")), string::npos);
+            EXPECT_EQ(header.find(_T("Content-Range:")), string::npos);
+            EXPECT_TRUE(body == content);
+
+            header = Get(client, _T("bytes=100-199"), body);
+            EXPECT_NE(header.find(_T(" 206 ")), string::npos);
+            EXPECT_NE(header.find(_T("Content-Range: bytes 100-199/1048576\r\n")), string::npos);
+            EXPECT_TRUE(body == content.substr(100, 100));
+
+            header = Get(client, _T("bytes=1000-"), body);
+            EXPECT_NE(header.find(_T("Content-Range: bytes 1000-1048575/1048576\r\n")), string::npos);
+            EXPECT_TRUE(body == content.substr(1000));
+
+            header = Get(client, _T("bytes=-10"), body);
+            EXPECT_NE(header.find(_T("Content-Range: bytes 1048566-1048575/1048576\r\n")), string::npos);
+            EXPECT_TRUE(body == content.substr(content.length() - 10));
+
+            header = Get(client, _T("bytes=1048576-"), body);
+            EXPECT_NE(header.find(_T(" 416 ")), string::npos);
+            EXPECT_NE(header.find(_T("Content-Range: bytes */1048576\r\n")), string::npos);
+            EXPECT_TRUE(body.empty());
+
+            // Several ranges at once are not supported, the whole file is sent.
+            header = Get(client, _T("bytes=0-9,20-29"), body);
+            EXPECT_NE(header.find(_T(" 200 ")), string::npos);
+            EXPECT_TRUE(body == content);
+        }
+
+        ::close(client);
+        Core::File(FileName).Destroy();
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,245 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        // Keeps track of the way it is sent, piece by piece or as a whole.
+        class CountingBody : public Web::TextBody {
+        public:
+            CountingBody(const CountingBody&) = delete;
+            CountingBody& operator=(const CountingBody&) = delete;
+
+            CountingBody()
+                : Web::TextBody()
+            {
+            }
+            ~CountingBody() override = default;
+
+        public:
+            static uint32_t Copied()
+            {
+                return (_copied);
+            }
+            static uint32_t Segmented()
+            {
+                return (_segmented);
+            }
+            static void Reset()
+            {
+                _copied = 0;
+                _segmented = 0;
+            }
+
+        protected:
+            uint16_t Serialize(uint8_t stream[], const uint16_t maxLength) const override
+            {
+                _copied++;
+                return (Web::TextBody::Serialize(stream, maxLength));
+            }
+            bool Segment(Core::SocketPort::Segment& segment) const override
+            {
+                _segmented++;
+                return (Web::TextBody::Segment(segment));
+            }
+            using Web::TextBody::Serialize;
+
+        private:
+            static std::atomic<uint32_t> _copied;
+            static std::atomic<uint32_t> _segmented;
+        };
+
+        std::atomic<uint32_t> CountingBody::_copied(0);
+        std::atomic<uint32_t> CountingBody::_segmented(0);
+
+        // Answers every request with the same text, far more than the send buffer.
+        class TextServer : public Web::WebLinkType<Core::SocketStream, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>> {
+        private:
+            using BaseClass = Web::WebLinkType<Core::SocketStream, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>>;
+
+        public:
+            TextServer() = delete;
+            TextServer(const TextServer&) = delete;
+            TextServer& operator=(const TextServer&) = delete;
+
+            TextServer(const SOCKET& connector, const Core::NodeId& remoteId, const string& text)
+                : BaseClass(2, false, connector, remoteId, 1024, 1024)
+                , _bodies(2)
+                , _text(text)
+            {
+            }
+            ~TextServer() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            void LinkBody(Core::ProxyType<Web::Request>&) override
+            {
+            }
+            void Received(Core::ProxyType<Web::Request>&) override
+            {
+                Core::ProxyType<Web::Response> response(Core::ProxyType<Web::Response>::Create());
+                Core::ProxyType<CountingBody> body(_bodies.Element());
+
+                static_cast<Web::TextBody&>(*body) = _text;
+                response->ErrorCode = Web::STATUS_OK;
+                response->Body<CountingBody>(body);
+
+                Submit(response);
+            }
+            void Send(const Core::ProxyType<Web::Response>&) override
+            {
+            }
+            void StateChange() override
+            {
+            }
+
+        private:
+            Core::ProxyPoolType<CountingBody> _bodies;
+            const string _text;
+        };
+
+        // A connected pair of TCP sockets on the loopback interface.
+        void Connect(SOCKET& server, SOCKET& client)
+        {
+            struct sockaddr_in address;
+            socklen_t size = sizeof(address);
+            SOCKET listener = ::socket(AF_INET, SOCK_STREAM, 0);
+
+            ::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+            ASSERT_EQ(::bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+            ASSERT_EQ(::listen(listener, 1), 0);
+            ASSERT_EQ(::getsockname(listener, reinterpret_cast<struct sockaddr*>(&address), &size), 0);
+
+            client = ::socket(AF_INET, SOCK_STREAM, 0);
+            ASSERT_EQ(::connect(client, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+            server = ::accept(listener, nullptr, nullptr);
+            ASSERT_NE(server, INVALID_SOCKET);
+
+            ::close(listener);
+        }
+
+        // Sends a GET and collects the raw response, the body as far as the Content-Length goes.
+        string Get(SOCKET socket, string& body)
+        {
+            const string request(_T("GET /text HTTP/1.1\r\nHost: localhost\r\n\r\n"));
+            string header;
+            char buffer[64 * 1024];
+            size_t length = 0;
+
+            EXPECT_EQ(::send(socket, request.c_str(), request.length(), 0), static_cast<ssize_t>(request.length()));
+
+            body.clear();
+
+            while (header.find(_T("\r\n\r\n")) == string::npos) {
+                const ssize_t size = ::recv(socket, buffer, 1, 0);
+                if (size <= 0) {
+                    break;
+                }
+                header.append(buffer, size);
+            }
+
+            const size_t position = header.find(_T("Content-Length: "));
+            if (position != string::npos) {
+                length = static_cast<size_t>(::atol(&header[position + 16]));
+            }
+
+            while (body.length() < length) {
+                const ssize_t size = ::recv(socket, buffer, std::min(sizeof(buffer), length - body.length()), 0);
+                if (size <= 0) {
+                    break;
+                }
+                body.append(buffer, size);
+            }
+
+            return (header);
+        }
+
+        void Transfer(const bool zeroCopy)
+        {
+            string content(256 * 1024, '\0');
+            for (uint32_t index = 0; index < content.length(); index++) {
+                content[index] = static_cast<char>('a' + (index % 26));
+            }
+
+            SOCKET server = INVALID_SOCKET;
+            SOCKET client = INVALID_SOCKET;
+
+            Connect(server, client);
+            ASSERT_NE(client, INVALID_SOCKET);
+
+            CountingBody::Reset();
+
+            {
+                TextServer link(server, Core::NodeId(_T("127.0.0.1"), 1), content);
+
+                // Loopback may not offer it, the responses have to arrive either way.
+                link.Link().ZeroCopy(zeroCopy);
+                EXPECT_EQ(link.Open(0), Core::ERROR_NONE);
+
+                // The second response only goes once the first one is completed.
+                for (uint8_t round = 0; round < 2; round++) {
+                    string body;
+                    const string header(Get(client, body));
+
+                    EXPECT_EQ(header.find(_T("HTTP/1.1 200 OK\r\n")), 0u);
+                    EXPECT_NE(header.find(_T("Content-Length: 262144\r\n")), string::npos);
+                    EXPECT_TRUE(body == content);
+                }
+            }
+
+            // The body went out as it is, next to the header, never through the send buffer.
+            EXPECT_EQ(CountingBody::Segmented(), 2u);
+            EXPECT_EQ(CountingBody::Copied(), 0u);
+
+            ::close(client);
+        }
+
+    }
+
+    TEST(Web_LinkSegments, Text)
+    {
+        Transfer(false);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Web_LinkSegments, TextZeroCopy)
+    {
+        Transfer(true);
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
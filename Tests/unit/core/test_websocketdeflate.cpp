@@ -0,0 +1,335 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    static std::vector<uint8_t> Message(const string& text)
+    {
+        return (std::vector<uint8_t>(text.begin(), text.end()));
+    }
+
+    TEST(WebSocket_Deflate, Negotiation)
+    {
+        Web::WebSocket::Deflate client;
+        Web::WebSocket::Deflate server;
+
+        // Without settings nothing is offered and nothing is accepted.
+        EXPECT_TRUE(client.Offer().empty());
+        EXPECT_TRUE(server.Negotiate(_T("permessage-deflate")).empty());
+        EXPECT_FALSE(server.IsEnabled());
+        EXPECT_FALSE(client.Accept(_T("permessage-deflate")));
+
+        client.Configure(Web::WebSocket::Deflate::Settings(128, 15, 10, false, true));
+        server.Configure(Web::WebSocket::Deflate::Settings());
+
+        const string offer(client.Offer());
+        EXPECT_STREQ(offer.c_str(), _T("permessage-deflate; client_no_context_takeover; client_max_window_bits=10"));
+
+        const string response(server.Negotiate(offer));
+        EXPECT_STREQ(response.c_str(), _T("permessage-deflate; client_no_context_takeover; client_max_window_bits=10"));
+        EXPECT_TRUE(server.IsEnabled());
+
+        EXPECT_TRUE(client.Accept(response));
+        EXPECT_TRUE(client.IsEnabled());
+
+        // Offers that can not be honoured are skipped, the next one is taken.
+        EXPECT_STREQ(server.Negotiate(_T("x-webkit-deflate-frame, permessage-deflate; mystery, permessage-deflate; server_max_window_bits=\"9\"; client_max_window_bits")).c_str(),
+            _T("permessage-deflate; server_max_window_bits=9"));
+        EXPECT_TRUE(server.Negotiate(_T("permessage-deflate; server_max_window_bits=16")).empty());
+        EXPECT_TRUE(server.Negotiate(_T("permessage-deflate; server_no_context_takeover; server_no_context_takeover")).empty());
+        EXPECT_FALSE(server.IsEnabled());
+
+        // A client fails on what it did not ask for, and runs without if the server declined.
+        EXPECT_FALSE(client.Accept(_T("permessage-deflate; client_max_window_bits=20")));
+        EXPECT_FALSE(client.Accept(_T("permessage-deflate, permessage-deflate")));
+        EXPECT_TRUE(client.Accept(_T("")));
+        EXPECT_FALSE(client.IsEnabled());
+    }
+
+    TEST(WebSocket_Deflate, Compression)
+    {
+        Web::WebSocket::Deflate sender;
+        Web::WebSocket::Deflate receiver;
+
+        sender.Configure(Web::WebSocket::Deflate::Settings(64));
+        receiver.Configure(Web::WebSocket::Deflate::Settings(64));
+        ASSERT_TRUE(sender.Accept(receiver.Negotiate(sender.Offer())));
+
+        const string text(_T("{\"jsonrpc\":\"2.0\",\"method\":\"client.events.1.statechange\",\"params\":{\"callsign\":\"Controller\",\"state\":\"activated\",\"reason\":\"requested\"}}"));
+
+        // Below the threshold the message goes out as it is.
+        std::vector<uint8_t> small(Message(_T("{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":true}")));
+        EXPECT_FALSE(sender.Compress(small));
+        EXPECT_EQ(small, Message(_T("{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":true}")));
+
+        // With the context taken over, the same message shrinks on the second run.
+        std::vector<uint8_t> first(Message(text));
+        std::vector<uint8_t> second(Message(text));
+        ASSERT_TRUE(sender.Compress(first));
+        ASSERT_TRUE(sender.Compress(second));
+        EXPECT_LT(first.size(), text.length());
+        EXPECT_LT(second.size(), first.size());
+
+        std::vector<uint8_t> inflated;
+        EXPECT_EQ(receiver.Decompress(first.data(), static_cast<uint16_t>(first.size()), true, inflated, 1024), Core::ERROR_NONE);
+        EXPECT_EQ(inflated, Message(text));
+
+        // Split over frames, only the last one flushes the message.
+        inflated.clear();
+        const uint16_t half = static_cast<uint16_t>(second.size() / 2);
+        EXPECT_EQ(receiver.Decompress(second.data(), half, false, inflated, 1024), Core::ERROR_NONE);
+        EXPECT_EQ(receiver.Decompress(&(second[half]), static_cast<uint16_t>(second.size() - half), true, inflated, 1024), Core::ERROR_NONE);
+        EXPECT_EQ(inflated, Message(text));
+
+        // Garbage does not inflate.
+        const uint8_t garbage[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+        inflated.clear();
+        EXPECT_NE(receiver.Decompress(garbage, sizeof(garbage), true, inflated, 1024), Core::ERROR_NONE);
+    }
+
+    TEST(WebSocket_Deflate, Limit)
+    {
+        Web::WebSocket::Deflate sender;
+        Web::WebSocket::Deflate receiver;
+
+        sender.Configure(Web::WebSocket::Deflate::Settings());
+        receiver.Configure(Web::WebSocket::Deflate::Settings());
+        ASSERT_TRUE(sender.Accept(receiver.Negotiate(sender.Offer())));
+
+        // A few hundred bytes on the wire, a megabyte once inflated.
+        std::vector<uint8_t> bomb(1024 * 1024, 'a');
+        ASSERT_TRUE(sender.Compress(bomb));
+        EXPECT_LT(bomb.size(), 2048u);
+
+        std::vector<uint8_t> inflated;
+        EXPECT_EQ(receiver.Decompress(bomb.data(), static_cast<uint16_t>(bomb.size()), true, inflated, 4096), Core::ERROR_INVALID_INPUT_LENGTH);
+        EXPECT_LE(inflated.size(), 4096u);
+
+        // The limit holds for the message as a whole, not for each frame.
+        Web::WebSocket::Deflate next;
+        next.Configure(Web::WebSocket::Deflate::Settings());
+        next.Negotiate(_T("permessage-deflate"));
+
+        const uint16_t half = static_cast<uint16_t>(bomb.size() / 2);
+        inflated.clear();
+        EXPECT_EQ(next.Decompress(bomb.data(), half, false, inflated, 600 * 1024), Core::ERROR_NONE);
+        inflated.clear();
+        EXPECT_EQ(next.Decompress(&(bomb[half]), static_cast<uint16_t>(bomb.size() - half), true, inflated, 600 * 1024), Core::ERROR_INVALID_INPUT_LENGTH);
+    }
+
+    TEST(WebSocket_Deflate, CloseCode)
+    {
+        Web::WebSocket::Protocol sender(false, true);
+        uint8_t frame[64];
+
+        sender.Close(Web::WebSocket::Protocol::CLOSE_MESSAGE_TOO_BIG);
+        uint16_t length = sender.Encoder(frame, sizeof(frame) - 8, 0);
+
+        // A masked close frame carrying the status code, its key right after the header.
+        EXPECT_EQ(length, 8u);
+        EXPECT_EQ(frame[0], 0x88);
+        EXPECT_EQ(frame[1], 0x82);
+
+        EXPECT_EQ(frame[6] ^ frame[2], 0x03);
+        EXPECT_EQ(frame[7] ^ frame[3], 0xF1);
+    }
+
+    namespace {
+
+        template <const bool COMPRESSION>
+        class Sink : public Web::WebSocketServerType<Core::SocketStream> {
+        private:
+            using BaseClass = Web::WebSocketServerType<Core::SocketStream>;
+
+        public:
+            Sink() = delete;
+            Sink(const Sink&) = delete;
+            Sink& operator=(const Sink&) = delete;
+
+            Sink(const SOCKET& socket, const Core::NodeId& remoteNode, Core::SocketServerType<Sink<COMPRESSION>>*)
+                : BaseClass(false, false, false, socket, remoteNode, 1024, 1024)
+            {
+                if (COMPRESSION == true) {
+                    Compression(Web::WebSocket::Deflate::Settings(256, 15, 15, false, false, 4096));
+                }
+            }
+            ~Sink() override = default;
+
+        public:
+            static uint32_t Received()
+            {
+                return (_received);
+            }
+            bool IsIdle() const override
+            {
+                return (true);
+            }
+            void StateChange() override
+            {
+            }
+            uint16_t SendData(uint8_t*, const uint16_t) override
+            {
+                return (0);
+            }
+            uint16_t ReceiveData(uint8_t*, const uint16_t receivedSize) override
+            {
+                _received += receivedSize;
+                return (receivedSize);
+            }
+
+        private:
+            static std::atomic<uint32_t> _received;
+        };
+
+        template <const bool COMPRESSION>
+        std::atomic<uint32_t> Sink<COMPRESSION>::_received(0);
+
+        // Upgrades a plain socket, sends the frame and returns what the server sent back till it closed.
+        std::vector<uint8_t> Exchange(const uint16_t port, const string& extensions, const uint8_t opcode, const std::vector<uint8_t>& payload)
+        {
+            std::vector<uint8_t> result;
+            struct sockaddr_in address;
+            struct timeval timeout = { 2, 0 };
+            SOCKET socket = ::socket(AF_INET, SOCK_STREAM, 0);
+
+            ::memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            address.sin_port = htons(port);
+
+            ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+            if (::connect(socket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0) {
+                const string request(_T("GET / HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n") + extensions + _T("\r\n"));
+                string response;
+                char buffer[256];
+                ssize_t size;
+
+                EXPECT_EQ(::send(socket, request.c_str(), request.length(), 0), static_cast<ssize_t>(request.length()));
+
+                while ((response.find(_T("\r\n\r\n")) == string::npos) && ((size = ::recv(socket, buffer, sizeof(buffer), 0)) > 0)) {
+                    response.append(buffer, size);
+                }
+                EXPECT_EQ(response.find(_T("HTTP/1.1 101")), 0u);
+
+                // Masked with a key of all zeroes, so the payload goes as it is.
+                std::vector<uint8_t> frame({ opcode, static_cast<uint8_t>(0x80 | 126), static_cast<uint8_t>(payload.size() >> 8), static_cast<uint8_t>(payload.size() & 0xFF), 0, 0, 0, 0 });
+                frame.insert(frame.end(), payload.begin(), payload.end());
+
+                EXPECT_EQ(::send(socket, frame.data(), frame.size(), 0), static_cast<ssize_t>(frame.size()));
+
+                while ((size = ::recv(socket, buffer, sizeof(buffer), 0)) > 0) {
+                    result.insert(result.end(), &(buffer[0]), &(buffer[size]));
+                }
+            }
+
+            ::close(socket);
+
+            return (result);
+        }
+
+    }
+
+    TEST(WebSocket_Deflate, FailsOnUnexpectedCompression)
+    {
+        static constexpr uint16_t Port = 12351;
+
+        Core::SocketServerType<Sink<false>> server(Core::NodeId(_T("127.0.0.1"), Port));
+        ASSERT_EQ(server.Open(0), Core::ERROR_NONE);
+
+        // RSV1 on a text frame, while permessage-deflate was never negotiated.
+        const std::vector<uint8_t> closed(Exchange(Port, _T(""), 0xC1, Message(_T("not deflated"))));
+
+        EXPECT_EQ(closed, std::vector<uint8_t>({ 0x88, 0x02, 0x03, 0xEA }));
+        EXPECT_EQ(Sink<false>::Received(), 0u);
+
+        server.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(WebSocket_Deflate, FailsOnMessageTooBig)
+    {
+        static constexpr uint16_t Port = 12352;
+
+        Core::SocketServerType<Sink<true>> server(Core::NodeId(_T("127.0.0.1"), Port));
+        ASSERT_EQ(server.Open(0), Core::ERROR_NONE);
+
+        Web::WebSocket::Deflate sender;
+        Web::WebSocket::Deflate receiver;
+        sender.Configure(Web::WebSocket::Deflate::Settings());
+        receiver.Configure(Web::WebSocket::Deflate::Settings());
+        ASSERT_TRUE(sender.Accept(receiver.Negotiate(sender.Offer())));
+
+        std::vector<uint8_t> bomb(256 * 1024, 'a');
+        ASSERT_TRUE(sender.Compress(bomb));
+
+        // The server allows 4096 bytes, a lot less than this inflates to.
+        const std::vector<uint8_t> closed(Exchange(Port, _T("Sec-WebSocket-Extensions: permessage-deflate\r\n"), 0xC1, bomb));
+
+        EXPECT_EQ(closed, std::vector<uint8_t>({ 0x88, 0x02, 0x03, 0xF1 }));
+        EXPECT_EQ(Sink<true>::Received(), 0u);
+
+        server.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(WebSocket_Deflate, Frame)
+    {
+        Web::WebSocket::Protocol sender(false, true);
+        Web::WebSocket::Protocol receiver(false, false);
+        uint8_t frame[64];
+
+        ::memcpy(&(frame[sender.PayloadOffset()]), "deflated", 8);
+        uint16_t length = sender.Encoder(frame, sizeof(frame) - 8, 8, true, true);
+
+        // Text, final and RSV1, masked by the client.
+        EXPECT_EQ(frame[0], 0xC1);
+        EXPECT_EQ(frame[1], 0x88);
+
+        uint16_t payload = length;
+        const uint16_t header = receiver.Decoder(frame, payload);
+        EXPECT_EQ(header, 6u);
+        EXPECT_EQ(payload, 8u);
+        EXPECT_TRUE(receiver.IsCompressed());
+        EXPECT_EQ(::memcmp(&(frame[header]), "deflated", 8), 0);
+
+        // A message sent as it is clears it again.
+        ::memcpy(&(frame[sender.PayloadOffset()]), "plain", 5);
+        length = sender.Encoder(frame, sizeof(frame) - 8, 5);
+        EXPECT_EQ(frame[0], 0x81);
+
+        payload = length;
+        receiver.Decoder(frame, payload);
+        EXPECT_FALSE(receiver.IsCompressed());
+    }
+
+} // Tests
+} // WPEFramework
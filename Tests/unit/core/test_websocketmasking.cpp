@@ -0,0 +1,81 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2020 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Feeds a frame in chunks, like it arrives on a socket, the first one holds at least the header.
+    static std::vector<uint8_t> Receive(Web::WebSocket::Protocol& receiver, uint8_t frame[], const uint16_t length, const uint16_t chunk)
+    {
+        std::vector<uint8_t> payload;
+        uint16_t offset = 0;
+
+        while (offset < length) {
+            uint16_t size = std::min(static_cast<uint16_t>(offset == 0 ? std::max(chunk, static_cast<uint16_t>(8)) : chunk), static_cast<uint16_t>(length - offset));
+            const uint16_t header = receiver.Decoder(&(frame[offset]), size);
+
+            payload.insert(payload.end(), &(frame[offset + header]), &(frame[offset + header + size]));
+            offset += (header + size);
+        }
+
+        return (payload);
+    }
+
+    TEST(WebSocket_Masking, RoundTrip)
+    {
+        static const uint16_t lengths[] = { 1, 3, 7, 8, 15, 16, 17, 31, 32, 33, 125, 126, 127, 200, 1000, 4093 };
+        static const uint16_t chunks[] = { 1, 5, 16, 33, 4096 };
+        const uint16_t frameSize = 4096 + 8;
+
+        for (const bool masking : { true, false }) {
+            for (const uint16_t length : lengths) {
+                for (const uint16_t chunk : chunks) {
+                    Web::WebSocket::Protocol sender(true, masking);
+                    Web::WebSocket::Protocol receiver(true, false);
+                    std::vector<uint8_t> frame(frameSize);
+                    std::vector<uint8_t> sent(length);
+
+                    for (uint16_t index = 0; index < length; index++) {
+                        sent[index] = static_cast<uint8_t>(index * 7 + length);
+                    }
+
+                    ::memcpy(&(frame[sender.PayloadOffset()]), sent.data(), length);
+
+                    const uint16_t size = sender.Encoder(frame.data(), frameSize - 8, length);
+
+                    EXPECT_EQ(size, length + (length <= 125 ? 2 : 4) + (masking ? 4 : 0));
+                    EXPECT_EQ(frame[0], 0x82);
+                    EXPECT_EQ((frame[1] & 0x80) != 0, masking);
+
+                    EXPECT_EQ(Receive(receiver, frame.data(), size, chunk), sent) << "length " << length << " chunk " << chunk << " masking " << masking;
+                    EXPECT_TRUE(receiver.IsCompleteMessage());
+                }
+            }
+        }
+    }
+
+} // Tests
+} // WPEFramework
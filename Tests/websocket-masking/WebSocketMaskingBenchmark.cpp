@@ -0,0 +1,144 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Throughput of building and reading masked WebSocket frames. The frames are built and read by
+// the WebSocket::Protocol like a client link sends them and a server link receives them, next to
+// the byte at a time loops the frames were masked with before, as the reference.
+
+#include "Module.h"
+
+using namespace WPEFramework;
+
+namespace {
+
+    static constexpr uint16_t FrameSize = 0xFFFF;
+
+    // Moves the payload up behind the header while masking it, byte by byte from the back.
+    uint16_t ReferenceEncode(uint8_t frame[], const uint16_t length, const uint8_t key[4])
+    {
+        uint16_t header = (length <= 125 ? 6 : 8);
+        uint8_t* source = &frame[length - 1 + 4];
+        uint8_t* destination = &frame[length - 1 + header];
+        uint32_t bytesToMove = length;
+
+        while (bytesToMove != 0) {
+            bytesToMove--;
+            *destination-- = (*source ^ key[(bytesToMove & 0x3)]);
+            source--;
+        }
+
+        ::memcpy(&frame[header - 4], key, 4);
+        frame[0] = 0x82;
+        if (length <= 125) {
+            frame[1] = 0x80 | length;
+        } else {
+            frame[1] = 0x80 | 126;
+            frame[2] = (length >> 8);
+            frame[3] = (length & 0xFF);
+        }
+
+        return (header + length);
+    }
+
+    void ReferenceDecode(uint8_t frame[], const uint16_t length)
+    {
+        const uint16_t header = ((frame[1] & 0x7F) == 126 ? 8 : 6);
+        const uint8_t* key = &frame[header - 4];
+        uint8_t* source = &frame[header];
+
+        for (uint16_t index = 0; index < length; index++) {
+            *source = (*source ^ key[index & 0x3]);
+            source++;
+        }
+    }
+
+    uint64_t Elapsed(const uint64_t start)
+    {
+        const uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        return (duration == 0 ? 1 : duration);
+    }
+
+    void Report(const TCHAR name[], const uint16_t length, const uint32_t frames, const uint64_t duration)
+    {
+        printf("%-10s %6u bytes %8u frames %10.1f MB/s\n", name, length, frames,
+            (static_cast<double>(length) * frames) / duration);
+    }
+
+    void Measure(const uint16_t length, const uint32_t frames)
+    {
+        std::vector<uint8_t> frame(FrameSize + 8);
+        const uint8_t key[4] = { 0x37, 0xFA, 0x21, 0x3D };
+        uint64_t start;
+        uint32_t checksum = 0;
+
+        for (uint16_t index = 0; index < length; index++) {
+            frame[index + 8] = static_cast<uint8_t>(index);
+        }
+
+        // The reference works with the payload at offset 4.
+        start = Core::Time::Now().Ticks();
+        for (uint32_t count = 0; count < frames; count++) {
+            ReferenceEncode(frame.data(), length, key);
+            ReferenceDecode(frame.data(), length);
+            ::memmove(&frame[4], &frame[(length <= 125 ? 6 : 8)], length);
+            checksum += frame[4];
+        }
+        Report(_T("byte"), length, frames, Elapsed(start));
+
+        Web::WebSocket::Protocol sender(true, true);
+        Web::WebSocket::Protocol receiver(true, false);
+
+        start = Core::Time::Now().Ticks();
+        for (uint32_t count = 0; count < frames; count++) {
+            uint16_t size = sender.Encoder(frame.data(), FrameSize, length);
+            const uint16_t header = receiver.Decoder(frame.data(), size);
+
+            // Put the payload back where the next frame is built, like the link serializes it.
+            if (header != sender.PayloadOffset()) {
+                ::memmove(&frame[sender.PayloadOffset()], &frame[header], size);
+            }
+            checksum += frame[sender.PayloadOffset()];
+        }
+        Report(_T("protocol"), length, frames, Elapsed(start));
+
+        // Keep the optimizer from dropping the loops.
+        if (checksum == 0xFFFFFFFF) {
+            printf("\n");
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    uint32_t megabytes = 256;
+
+    if (argc == 2) {
+        megabytes = Core::NumberType<uint32_t>(Core::TextFragment(argv[1])).Value();
+    }
+
+    for (const uint16_t length : { 64, 125, 1024, 4096, 16384, (FrameSize - 8) }) {
+        Measure(length, static_cast<uint32_t>((static_cast<uint64_t>(megabytes) * 1024 * 1024) / length));
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -0,0 +1,259 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2021 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Throughput and latency of the job queues the ThreadPool can run on. The queues are measured
+// stand-alone with a number of producers and consumers, the WorkerPool is measured end-to-end
+// with the queue it was built with (THREADPOOL_RING_QUEUE).
+
+#include <thread>
+#include "Module.h"
+
+using namespace WPEFramework;
+
+namespace {
+
+    class Job : public Core::IDispatch {
+    public:
+        Job(const Job&) = delete;
+        Job& operator=(const Job&) = delete;
+
+        Job()
+            : _submitted(0)
+            , _latency(0)
+            , _completed(nullptr)
+        {
+        }
+        ~Job() override = default;
+
+    public:
+        void Submitted(std::atomic<uint32_t>& completed)
+        {
+            _completed = &completed;
+            _submitted = Core::Time::Now().Ticks();
+        }
+        uint64_t Latency() const
+        {
+            return (_latency);
+        }
+        void Dispatch() override
+        {
+            _latency = Core::Time::Now().Ticks() - _submitted;
+            (*_completed)++;
+        }
+
+    private:
+        uint64_t _submitted;
+        uint64_t _latency;
+        std::atomic<uint32_t>* _completed;
+    };
+
+    // What the ThreadPool keeps in its queue: a job and the moment it was queued.
+    struct Entry {
+        Core::ProxyType<Core::IDispatch> Job;
+        uint64_t Queued;
+
+        bool operator==(const Entry& other) const
+        {
+            return (Job == other.Job);
+        }
+        bool operator!=(const Entry& other) const
+        {
+            return (Job != other.Job);
+        }
+    };
+
+    class Dispatcher : public Core::ThreadPool::IDispatcher {
+    public:
+        Dispatcher(const Dispatcher&) = delete;
+        Dispatcher& operator=(const Dispatcher&) = delete;
+
+        Dispatcher() = default;
+        ~Dispatcher() override = default;
+
+    private:
+        void Initialize() override { }
+        void Deinitialize() override { }
+        void Dispatch(Core::IDispatch* job) override
+        {
+            job->Dispatch();
+        }
+    };
+
+    class WorkerPoolImplementation : public Core::WorkerPool {
+    public:
+        WorkerPoolImplementation() = delete;
+        WorkerPoolImplementation(const WorkerPoolImplementation&) = delete;
+        WorkerPoolImplementation& operator=(const WorkerPoolImplementation&) = delete;
+
+        WorkerPoolImplementation(const uint8_t threads, const uint32_t queueSize)
+            : WorkerPool(threads, Core::Thread::DefaultStackSize(), queueSize, &_dispatcher)
+            , _dispatcher()
+        {
+        }
+        ~WorkerPoolImplementation()
+        {
+            Core::WorkerPool::Stop();
+        }
+
+    private:
+        Dispatcher _dispatcher;
+    };
+
+    void Report(const TCHAR name[], const uint8_t producers, const uint8_t consumers, const uint32_t entries, const uint64_t duration, const uint64_t latency, const uint64_t maxLatency)
+    {
+        printf("%-20s %2u -> %2u %8u entries %10.0f entries/s %8.2f us avg %8u us max\n", name, producers, consumers, entries,
+            (static_cast<double>(entries) * Core::Time::MicroSecondsPerSecond) / (duration == 0 ? 1 : duration),
+            static_cast<double>(latency) / entries, static_cast<uint32_t>(maxLatency));
+    }
+
+    template <typename QUEUE>
+    void MeasureQueue(const TCHAR name[], const uint8_t producers, const uint8_t consumers, const uint32_t entries)
+    {
+        QUEUE queue(64);
+        std::vector<Core::ProxyType<Core::IDispatch>> jobs;
+        std::vector<std::thread> threads;
+        std::atomic<uint64_t> latency(0);
+        std::atomic<uint64_t> maxLatency(0);
+
+        for (uint32_t index = 0; index < entries; index++) {
+            jobs.emplace_back(Core::ProxyType<Core::IDispatch>(Core::ProxyType<Job>::Create()));
+        }
+
+        const uint64_t start = Core::Time::Now().Ticks();
+
+        for (uint8_t index = 0; index < consumers; index++) {
+            threads.emplace_back([&]() {
+                Entry entry;
+                uint64_t total = 0;
+                uint64_t max = 0;
+
+                while (queue.Extract(entry, Core::infinite) == true) {
+                    const uint64_t waited = Core::Time::Now().Ticks() - entry.Queued;
+                    total += waited;
+                    max = std::max(max, waited);
+                    entry.Job.Release();
+                }
+
+                latency += total;
+
+                uint64_t current = maxLatency;
+                while ((current < max) && (maxLatency.compare_exchange_weak(current, max) == false)) {
+                }
+            });
+        }
+        for (uint8_t index = 0; index < producers; index++) {
+            threads.emplace_back([&, index]() {
+                for (uint32_t job = index; job < entries; job += producers) {
+                    queue.Insert(Entry { jobs[job], Core::Time::Now().Ticks() }, Core::infinite);
+                }
+            });
+        }
+
+        // Producers are the last threads, once they are done, drain the queue.
+        for (uint8_t index = 0; index < producers; index++) {
+            threads[consumers + index].join();
+        }
+        while (queue.IsEmpty() == false) {
+            std::this_thread::yield();
+        }
+
+        const uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        queue.Disable();
+        for (uint8_t index = 0; index < consumers; index++) {
+            threads[index].join();
+        }
+
+        Report(name, producers, consumers, entries, duration, latency, maxLatency);
+    }
+
+    void MeasurePool(const uint8_t producers, const uint8_t workers, const uint32_t entries)
+    {
+        WorkerPoolImplementation pool(workers, 64);
+        std::vector<Core::ProxyType<Job>> jobs;
+        std::vector<std::thread> threads;
+        std::atomic<uint32_t> completed(0);
+
+        for (uint32_t index = 0; index < entries; index++) {
+            jobs.emplace_back(Core::ProxyType<Job>::Create());
+        }
+
+        pool.Run();
+
+        const uint64_t start = Core::Time::Now().Ticks();
+
+        for (uint8_t index = 0; index < producers; index++) {
+            threads.emplace_back([&, index]() {
+                for (uint32_t job = index; job < entries; job += producers) {
+                    jobs[job]->Submitted(completed);
+                    pool.Submit(Core::ProxyType<Core::IDispatch>(jobs[job]));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        while (completed < entries) {
+            std::this_thread::yield();
+        }
+
+        const uint64_t duration = Core::Time::Now().Ticks() - start;
+
+        pool.Stop();
+
+        uint64_t latency = 0;
+        uint64_t maxLatency = 0;
+        for (const Core::ProxyType<Job>& job : jobs) {
+            latency += job->Latency();
+            maxLatency = std::max(maxLatency, job->Latency());
+        }
+
+#ifdef __CORE_THREADPOOL_RING_QUEUE__
+        Report(_T("WorkerPool (ring)"), producers, workers, entries, duration, latency, maxLatency);
+#else
+        Report(_T("WorkerPool (list)"), producers, workers, entries, duration, latency, maxLatency);
+#endif
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    uint32_t entries = 100000;
+
+    if (argc == 2) {
+        entries = Core::NumberType<uint32_t>(Core::TextFragment(argv[1])).Value();
+    }
+
+    const uint8_t cores = static_cast<uint8_t>(std::max(2u, std::thread::hardware_concurrency()));
+
+    printf("%-20s prod -> cons\n", _T("queue"));
+
+    MeasureQueue<Core::QueueType<Entry>>(_T("QueueType"), 1, 1, entries);
+    MeasureQueue<Core::RingQueueType<Entry>>(_T("RingQueueType"), 1, 1, entries);
+    MeasureQueue<Core::QueueType<Entry>>(_T("QueueType"), cores, cores, entries);
+    MeasureQueue<Core::RingQueueType<Entry>>(_T("RingQueueType"), cores, cores, entries);
+
+    MeasurePool(1, cores, entries);
+    MeasurePool(cores, cores, entries);
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}